@@ -2,71 +2,345 @@
 # Download additional external files from Dulik FTP server
 
 import os
-from ftplib import FTP
+import re
+import sys
+import json
+import time
+import hashlib
+import argparse
+import calendar
+import threading
+from ftplib import FTP, all_errors, error_perm
+from concurrent.futures import ThreadPoolExecutor
+
+MANIFEST_NAME = '.get_external.json'
+BLOCK_SIZE = 1024 * 1024
+TIMEOUT = 60
 
 def main():
+    parser = argparse.ArgumentParser(description='Synchronizes the external files with the Dulik FTP server.')
+    parser.add_argument('--host', default='dulik.dev.tbscz')
+    parser.add_argument('--port', type=int, default=21)
+    parser.add_argument('--user', default='anonymous')
+    parser.add_argument('--password', default='')
+    parser.add_argument('--remote-path', default='/pub/SDK/vcpkg/')
+    parser.add_argument('--local-path', default='.')
+    parser.add_argument('--connections', type=int, default=4, help='number of parallel transfers')
+    parser.add_argument('--retries', type=int, default=3, help='reconnections per file after a failed transfer')
+    parser.add_argument('--verify', action='store_true', help='hash unchanged local files against the manifest')
+    args = parser.parse_args()
+
     print('Downloading external files from Dulik FTP server...')
     cwd_to_script(__file__)
-    ftp = FtpClient()
-    ftp.download_tree('/pub/SDK/vcpkg/', '.')
+    sync = FtpSync(lambda: FtpClient(args.host, args.port, args.user, args.password),
+                   args.local_path, args.connections, args.retries)
+    if not sync.sync(args.remote_path, args.verify):
+        sys.exit(1)
     print('Download successful. Now run copy-external.bat to copy the files.')
 
 class FtpClient:
     '''Client for Dulik FTP server.'''
 
-    def __init__(self):
-        self.ftp = FTP('dulik.dev.tbscz', 'anonymous', '')
+    def __init__(self, host, port=21, user='anonymous', password=''):
+        self.ftp = FTP(timeout=TIMEOUT)
+        self.ftp.connect(host, port)
+        self.ftp.login(user, password)
+        self.ftp.voidcmd('TYPE I')
+        self.mlsd = None
 
-    def __exit__(self):
-        self.ftp.quit()
-
-    def download_tree(self, remote_path, local_path, show_just_finished = False):
+    def quit(self):
         try:
-            self.ftp.cwd(remote_path)
-            os.makedirs(local_path, exist_ok=True)
-            filenames = self.ftp.nlst()
-
-            for filename in filenames:
-                lpath = os.path.join(local_path, filename)
-                if "." in filename:
-                    print(f'Downloading from FTP: {filename}')
-                    self.ftp.voidcmd('TYPE I')
-                    tracker = _FtpProgressTracker(self.ftp.size(filename), show_just_finished)
-                    file = open(lpath, 'wb')
-                    self.ftp.retrbinary("RETR " + filename, lambda *args: self.__writeFile(file, tracker, *args), 8192)
-                    file.close()
-                    print('') # after progress print new line
+            self.ftp.quit()
+        except Exception:
+            self.ftp.close()
+
+    def close(self):
+        '''Drops the connection without waiting for the server, e.g. after a failed transfer.'''
+        self.ftp.close()
+
+    def list_directory(self, remote_path):
+        '''Entries of a directory as {name: (is_directory, size, modify)}; modify is a UTC timestamp or None.'''
+        if self.mlsd is not False:
+            try:
+                entries = {}
+                for name, facts in self.ftp.mlsd(remote_path, ['type', 'size', 'modify']):
+                    entry_type = facts.get('type', '').lower()
+                    if entry_type in ('cdir', 'pdir') or name in ('.', '..'):
+                        continue
+                    entries[name] = (entry_type == 'dir', int(facts.get('size', 0)),
+                                     parse_ftp_time(facts.get('modify')))
+                self.mlsd = True
+                return entries
+            except error_perm:
+                if self.mlsd:
+                    raise
+                self.mlsd = False
+        return self.__list_unix(remote_path)
+
+    def __list_unix(self, remote_path):
+        # drwxr-xr-x 2 owner group 4096 Jan 01 12:00 name
+        lines = []
+        self.ftp.retrlines('LIST ' + remote_path, lines.append)
+        entries = {}
+        for line in lines:
+            fields = line.split(None, 8)
+            if len(fields) < 9 or fields[8] in ('.', '..'):
+                continue
+            name = fields[8]
+            is_directory = fields[0].startswith('d')
+            size = int(fields[4]) if fields[4].isdigit() else 0
+            modify = None
+            if not is_directory:
+                try:
+                    modify = parse_ftp_time(self.ftp.voidcmd('MDTM ' + join_remote(remote_path, name)).split()[-1])
+                except error_perm:
+                    pass
+            entries[name] = (is_directory, size, modify)
+        return entries
+
+    def download_file(self, remote_path, local_path, offset, callback):
+        '''Appends the remote file from `offset` (REST) to local_path.'''
+        with open(local_path, 'ab' if offset else 'wb') as file:
+            def write(block):
+                file.write(block)
+                callback(block)
+            self.ftp.retrbinary('RETR ' + remote_path, write, BLOCK_SIZE, rest=offset or None)
+
+class FtpSync:
+    '''Mirrors a remote tree, fetching only entries whose size or modification time changed since the last sync.
+    The local manifest records the size, modification time and SHA-256 of every synchronized file.
+    Interrupted downloads are kept as <file>.part and resumed from their size.
+    A failed transfer drops the connection of its thread and is resumed on a new one up to `retries` times.'''
+
+    def __init__(self, connect, local_root, connections, retries=3):
+        self.connect = connect
+        self.local_root = local_root
+        self.connections = max(connections, 1)
+        self.retries = max(retries, 0)
+        self.manifest_path = os.path.join(local_root, MANIFEST_NAME)
+        self.manifest = self.__load_manifest()
+        self.lock = threading.Lock()
+        self.local = threading.local()
+        self.clients = []
+
+    def __load_manifest(self):
+        if not os.path.exists(self.manifest_path):
+            return {'files': {}, 'partial': {}}
+        with open(self.manifest_path, 'r', encoding='utf-8') as file:
+            try:
+                manifest = json.load(file)
+            except json.JSONDecodeError:
+                print(f'Warning: Ignoring the invalid manifest {self.manifest_path}')
+                return {'files': {}, 'partial': {}}
+        manifest.setdefault('files', {})
+        manifest.setdefault('partial', {})
+        return manifest
+
+    def __save_manifest(self):
+        os.makedirs(self.local_root, exist_ok=True)
+        temp_path = f'{self.manifest_path}.{os.getpid()}.tmp'
+        with open(temp_path, 'w', encoding='utf-8') as file:
+            json.dump(self.manifest, file, indent=2, sort_keys=True)
+        os.replace(temp_path, self.manifest_path)
+
+    def __client(self):
+        client = getattr(self.local, 'client', None)
+        if client is None:
+            client = self.connect()
+            self.local.client = client
+            with self.lock:
+                self.clients.append(client)
+        return client
+
+    def __drop_client(self):
+        client = getattr(self.local, 'client', None)
+        if client is None:
+            return
+        self.local.client = None
+        with self.lock:
+            self.clients.remove(client)
+        client.close()
+
+    def __local_path(self, relative_path):
+        if not is_safe_relative_path(relative_path):
+            raise ValueError(f'the remote name {relative_path!r} leaves the local path')
+        return os.path.join(self.local_root, relative_path)
+
+    def list_tree(self, client, remote_root):
+        '''{relative path: (size, modify)} of all files below remote_root'''
+        files = {}
+        pending = ['']
+        while pending:
+            relative_directory = pending.pop()
+            for name, (is_directory, size, modify) in client.list_directory(join_remote(remote_root, relative_directory)).items():
+                relative_path = join_remote(relative_directory, name) if relative_directory else name
+                if is_directory:
+                    pending.append(relative_path)
                 else:
-                    self.download_tree(filename, lpath, show_just_finished)
-        except Exception as e:
-            print("Error:", e)
+                    files[relative_path] = (size, modify)
+        return files
+
+    def is_unchanged(self, relative_path, size, modify, verify):
+        entry = self.manifest['files'].get(relative_path)
+        local_path = self.__local_path(relative_path)
+        if entry is None or entry['size'] != size or entry['modify'] != modify or modify is None:
+            return False
+        if not os.path.exists(local_path):
+            return False
+        stat = os.stat(local_path)
+        if stat.st_size != size:
+            return False
+        if verify or stat.st_mtime_ns != entry['local_mtime_ns']:
+            return hash_file(local_path) == entry['sha256']
+        return True
+
+    def sync(self, remote_root, verify=False):
+        client = self.__client()
+        started = time.time()
+        remote_files = self.list_tree(client, remote_root)
+        # A server must not be able to write outside of the local path
+        failures = sorted(path for path in remote_files if not is_safe_relative_path(path))
+        for path in failures:
+            print(f'Error: {path}: the remote name leaves the local path')
+            del remote_files[path]
+        changed = [(path, size, modify) for path, (size, modify) in sorted(remote_files.items())
+                   if not self.is_unchanged(path, size, modify, verify)]
+        print(f'{len(remote_files)} remote files, {len(changed)} to download')
+
+        total_size = sum(size for _, size, _ in changed)
+        tracker = _FtpProgressTracker(total_size)
+        with ThreadPoolExecutor(max_workers=self.connections) as executor:
+            futures = [(path, executor.submit(self.download, remote_root, path, size, modify, tracker))
+                       for path, size, modify in changed]
+            for path, future in futures:
+                try:
+                    future.result()
+                except Exception as e:
+                    failures.append(path)
+                    print(f'\nError: {path}: {e}')
+        if changed:
+            print('') # after progress print new line
+
+        # Files removed from the server are only deleted if this script created them
+        for path in sorted(set(self.manifest['files']) - set(remote_files)):
+            local_path = os.path.join(self.local_root, path)
+            if is_safe_relative_path(path) and os.path.exists(local_path):
+                print(f'Removing {path}')
+                os.remove(local_path)
+            del self.manifest['files'][path]
+        self.__save_manifest()
+
+        for client in self.clients:
+            client.quit()
+        print(f'Synchronized in {time.time() - started:.1f} s')
+        return not failures
+
+    def download(self, remote_root, relative_path, size, modify, tracker):
+        local_path = self.__local_path(relative_path)
+        part_path = local_path + '.part'
+        os.makedirs(os.path.dirname(local_path) or '.', exist_ok=True)
+        sha256 = hashlib.sha256()
 
-    def __writeFile(self, file, tracker, block):
-        file.write(block)
-        tracker.handle(block)
+        # Resume only if the partial file belongs to the same remote version
+        with self.lock:
+            partial = self.manifest['partial'].get(relative_path)
+            self.manifest['partial'][relative_path] = {'size': size, 'modify': modify}
+            self.__save_manifest()
+        offset = 0
+        if (partial == {'size': size, 'modify': modify} and modify is not None
+                and os.path.exists(part_path) and os.path.getsize(part_path) <= size):
+            offset = os.path.getsize(part_path)
+            hash_file(part_path, sha256)
+            tracker.handle(offset)
+
+        if offset < size or size == 0:
+            def received(block):
+                sha256.update(block)
+                tracker.handle(len(block))
+            attempt = 0
+            while True:
+                try:
+                    self.__client().download_file(join_remote(remote_root, relative_path), part_path, offset, received)
+                    if os.path.getsize(part_path) < size:
+                        raise EOFError(f'the transfer ended after {os.path.getsize(part_path)} of {size} bytes')
+                    break
+                except all_errors as e:
+                    # The connection may be left in any state, so the next attempt starts on a new one
+                    self.__drop_client()
+                    if isinstance(e, error_perm) or attempt == self.retries:
+                        raise
+                    attempt += 1
+                    offset = os.path.getsize(part_path) if os.path.exists(part_path) else 0
+                    sha256 = hashlib.sha256()
+                    if offset:
+                        hash_file(part_path, sha256)
+                    if size and offset >= size:
+                        break
+                    print(f'\nWarning: {relative_path}: {e}; resuming at {offset} bytes ({attempt}/{self.retries})')
+
+        actual_size = os.path.getsize(part_path)
+        if actual_size != size:
+            raise RuntimeError(f'expected {size} bytes, received {actual_size}')
+        if modify is not None:
+            os.utime(part_path, (modify, modify))
+        os.replace(part_path, local_path)
+        with self.lock:
+            del self.manifest['partial'][relative_path]
+            self.manifest['files'][relative_path] = {
+                'size': size, 'modify': modify, 'sha256': sha256.hexdigest(),
+                'local_mtime_ns': os.stat(local_path).st_mtime_ns}
+            self.__save_manifest()
 
 class _FtpProgressTracker:
     sizeWritten = 0
     totalSize = 0
-    showJustFinished = False
 
-    def __init__(self, totalSize, showJustFinished = False):
+    def __init__(self, totalSize):
         self.totalSize = totalSize
-        self.showJustFinished = showJustFinished
+        self.lock = threading.Lock()
+        self.lastPrint = 0
 
-    def handle(self, block):
-        self.sizeWritten += len(block)
-        percentComplete = int(self.sizeWritten * 100 / self.totalSize)
-        if not self.showJustFinished or (self.showJustFinished and percentComplete == 100):
+    def handle(self, size):
+        with self.lock:
+            self.sizeWritten += size
+            now = time.time()
+            if now - self.lastPrint < 0.2 and self.sizeWritten < self.totalSize:
+                return
+            self.lastPrint = now
+            percentComplete = int(self.sizeWritten * 100 / self.totalSize) if self.totalSize else 100
             readableCurrent = readableSize(self.sizeWritten)
             readableTotal = readableSize(self.totalSize)
             fillerSpaces = '                           '
             print(f'Progress: {percentComplete}%  {readableCurrent} / {readableTotal}{fillerSpaces}', end='\r')
 
+def parse_ftp_time(value):
+    '''Seconds since the epoch of an MLSD/MDTM time, YYYYMMDDHHMMSS[.sss] in UTC'''
+    if not value:
+        return None
+    try:
+        return calendar.timegm(time.strptime(value[:14], '%Y%m%d%H%M%S'))
+    except ValueError:
+        return None
+
+def is_safe_relative_path(path):
+    '''Whether the relative path of a remote file stays below the local root'''
+    parts = re.split(r'[\\/]', path)
+    return not (os.path.isabs(path) or os.path.splitdrive(path)[0] or '' in parts or '..' in parts)
+
+def join_remote(directory, name):
+    return directory.rstrip('/') + '/' + name if directory else name
+
+def hash_file(path, sha256=None):
+    sha256 = sha256 or hashlib.sha256()
+    with open(path, 'rb') as file:
+        for block in iter(lambda: file.read(BLOCK_SIZE), b''):
+            sha256.update(block)
+    return sha256.hexdigest()
+
 def readableSize(size, precision=2):
     suffixes=['B','KB','MB','GB','TB']
     suffixIndex = 0
-    while size >= 1024 and suffixIndex < len(suffixes):
+    while size >= 1024 and suffixIndex < len(suffixes) - 1:
         suffixIndex += 1
         size = size/1024.0
     return "%.*f%s"%(precision,size,suffixes[suffixIndex])
@@ -0,0 +1,504 @@
+# Automatically generated by scripts/boost/generate-ports.ps1
+
+set(BOOST_LIBRARIES
+    accumulators
+    algorithm
+    align
+    any
+    array
+    asio
+    assert
+    assign
+    atomic
+    beast
+    bimap
+    bind
+    callable_traits
+    charconv
+    chrono
+    circular_buffer
+    cobalt
+    compat
+    compatibility
+    compute
+    concept_check
+    config
+    container
+    container_hash
+    context
+    contract
+    conversion
+    convert
+    core
+    coroutine
+    coroutine2
+    crc
+    date_time
+    describe
+    detail
+    dll
+    dynamic_bitset
+    endian
+    exception
+    fiber
+    filesystem
+    flyweight
+    foreach
+    format
+    function
+    function_types
+    functional
+    fusion
+    geometry
+    gil
+    graph
+    graph_parallel
+    hana
+    headers
+    heap
+    histogram
+    hof
+    icl
+    integer
+    interprocess
+    interval
+    intrusive
+    io
+    iostreams
+    iterator
+    json
+    lambda
+    lambda2
+    leaf
+    lexical_cast
+    local_function
+    locale
+    lockfree
+    log
+    logic
+    math
+    metaparse
+    move
+    mp11
+    mpi
+    mpl
+    msm
+    multi_array
+    multi_index
+    multiprecision
+    mysql
+    nowide
+    numeric_conversion
+    odeint
+    optional
+    outcome
+    parameter
+    parameter_python
+    pfr
+    phoenix
+    poly_collection
+    polygon
+    pool
+    predef
+    preprocessor
+    process
+    program_options
+    property_map
+    property_map_parallel
+    property_tree
+    proto
+    ptr_container
+    python
+    qvm
+    random
+    range
+    ratio
+    rational
+    redis
+    regex
+    safe_numerics
+    scope
+    scope_exit
+    serialization
+    signals2
+    smart_ptr
+    sort
+    spirit
+    stacktrace
+    statechart
+    static_assert
+    static_string
+    stl_interfaces
+    system
+    test
+    thread
+    throw_exception
+    timer
+    tokenizer
+    tti
+    tuple
+    type_erasure
+    type_index
+    type_traits
+    typeof
+    ublas
+    units
+    unordered
+    url
+    utility
+    uuid
+    variant
+    variant2
+    vmd
+    wave
+    winapi
+    xpressive
+    yap
+)
+
+set(BOOST_LIBRARY_accumulators_SHA512 72cb1c2bf3d58b8a97ca70765e73b98151b6767c80cc309f8117b4624909d45359cfbae7f4aab8e1f9a854bf9313be06cabd4d0d0d008ec3b5b755bbae11c0ed)
+set(BOOST_LIBRARY_accumulators_DEPENDENCIES array assert circular_buffer concept_check config core fusion iterator mpl numeric_conversion parameter preprocessor range serialization static_assert throw_exception tuple type_traits typeof ublas)
+set(BOOST_LIBRARY_algorithm_SHA512 2ce673ab8693cca338a4499d0dbe0c63b8b4967f017463fefd59a2892a636bf1197b49bf625cef797c93efd0685a5c399daa1d55456c35bcbcd013d47476c72b)
+set(BOOST_LIBRARY_algorithm_DEPENDENCIES array assert bind concept_check config core exception function iterator mpl range regex static_assert throw_exception tuple type_traits unordered)
+set(BOOST_LIBRARY_align_SHA512 bffa9c6accb4e52fea876aca2fae3ed969f65deff578344c3cce48890650e30981f2010d64f19c642791f1a5d3798198502ebf56582096f0f734d5c2a665bb21)
+set(BOOST_LIBRARY_align_DEPENDENCIES assert config core static_assert)
+set(BOOST_LIBRARY_any_SHA512 721d3f1cd479994f8a6562333e76409c53c1baf2f7c77a074c9f1d07e896a88e3302eb570c3476d2fb7af5811fe7692a9e9c1b0b171deb00e8649cc588544f27)
+set(BOOST_LIBRARY_any_DEPENDENCIES assert config throw_exception type_index)
+set(BOOST_LIBRARY_array_SHA512 a3fe3e7230bd5d82874b4a7c73311f6656c37820eeec5f6186547dde77a43ce5c6264aa0aed87f41399ab50e14988d816d6dd5e66f7ee0fe307c1d15e14d4355)
+set(BOOST_LIBRARY_array_DEPENDENCIES assert config core static_assert throw_exception)
+set(BOOST_LIBRARY_asio_SHA512 379905acf0cc0352c8df32f4106c3e17ad0f02fd0367288c2dca319a7573bd34ebf435a0e9d876ee0d44a24189d896167c49c7727e1dc77c0fca887e9f7a6eca)
+set(BOOST_LIBRARY_asio_DEPENDENCIES align assert config context coroutine date_time system throw_exception)
+set(BOOST_LIBRARY_asio_PATCHES opt-dep.diff)
+set(BOOST_LIBRARY_assert_SHA512 5774b88d43233d53a3449962c0768ff1362bde7a116130f0d433ae6e9937925f98a7575f6dc11743230940da5d1972664dabdae035722fa2881bcdef5e4bbbfc)
+set(BOOST_LIBRARY_assert_DEPENDENCIES config)
+set(BOOST_LIBRARY_assign_SHA512 c86e613bdd0cade0f2be229ea12fea2e869cbc220c8f95a743a0599d2c0e74a41e6feff71c40fb6197cc4f53a632c42ff8f7f2ec4e6ac8c769c6fea1820fa3cc)
+set(BOOST_LIBRARY_assign_DEPENDENCIES array config core move preprocessor ptr_container range static_assert throw_exception tuple type_traits)
+set(BOOST_LIBRARY_atomic_SHA512 9296704de816cfa3a262d7d49b39431565ca24e65c9503fcef068c65f1bdd08f4c451a1355cb107ffd1c3d6dbf54a5a09c0e2b7b3658e78eeada1f4517494536)
+set(BOOST_LIBRARY_atomic_DEPENDENCIES align assert config predef preprocessor type_traits winapi)
+set(BOOST_LIBRARY_atomic_PATCHES fix-include.patch)
+set(BOOST_LIBRARY_beast_SHA512 342e78855354a8c35c0ca2297ce7abdb28fec2ef119bee419931994bbd1bb0251b7ac46061709b9373f3dd263a7a6a660063b6837d3419daea9327bbcb217130)
+set(BOOST_LIBRARY_beast_DEPENDENCIES asio assert bind config container container_hash core endian intrusive logic mp11 optional preprocessor smart_ptr static_assert static_string system throw_exception type_index type_traits winapi)
+set(BOOST_LIBRARY_beast_SUPPORTS "!emscripten")
+set(BOOST_LIBRARY_bimap_SHA512 1bd2a7d5d07c1a96ece6dd3683374212b89343aa7096d2631f6fd8e4650f34e5cdca5cd920ad5a4d8d06adc190b890041343c89827a98cb2eac2de66da463979)
+set(BOOST_LIBRARY_bimap_DEPENDENCIES concept_check config container_hash core iterator lambda mpl multi_index preprocessor static_assert throw_exception type_traits utility)
+set(BOOST_LIBRARY_bind_SHA512 178fa4b8396b6a76c20cff40e029ae1b36d6f0b199636bda1b34ea7c2cb827d6f09e45e364547e30120e63e5e17c8280df62ecdda6e163f83919cc21bfaeb01a)
+set(BOOST_LIBRARY_bind_DEPENDENCIES config core)
+set(BOOST_LIBRARY_callable_traits_SHA512 625682baee6df7bea8eeb55dbc941cdd40546f90de271c3c4ff872cc9d51d68eba4991fc3fc2c8073f59182b4739934e6d940239e2a11d69a0b3a8438d95ba78)
+set(BOOST_LIBRARY_callable_traits_DEPENDENCIES config)
+set(BOOST_LIBRARY_charconv_SHA512 9b4668cb9d5e1e4a8f7d57c117998b8d5a6dbf3718c684670b13c3c55eda59257fb8a76e8ab6c34d96a807018d36dd6379890f03b18eba1135ed99dae202c2df)
+set(BOOST_LIBRARY_charconv_DEPENDENCIES assert config core)
+set(BOOST_LIBRARY_chrono_SHA512 b10162a7e74fafd9f6841b20672adee3994937201d2928da6c17f47aa52c69819d76b33f85c727801dd02c4897b9e5e75b7975fd937665ae17b7b1fb5807a924)
+set(BOOST_LIBRARY_chrono_DEPENDENCIES assert config core integer move mpl predef ratio static_assert system throw_exception type_traits typeof utility winapi)
+set(BOOST_LIBRARY_circular_buffer_SHA512 475e9fbe37e87a4b09fefd12556b5c4efacb5a4af6a1204b40ded29856933d6140b9c5758f66e6dfb16d1f7e1d5d168fc218bf74f44de604a68aaa1a031e8d56)
+set(BOOST_LIBRARY_circular_buffer_DEPENDENCIES assert concept_check config core move static_assert throw_exception type_traits)
+set(BOOST_LIBRARY_cobalt_SHA512 a92ff4050772b61035121f944d81d4a9d6d2da858dedc0956ad850132657c80c660a8839a99597443751744577dd5b0958239e99d948d3036c85b8361151aa27)
+set(BOOST_LIBRARY_cobalt_DEPENDENCIES asio callable_traits circular_buffer config container context core intrusive leaf mp11 preprocessor smart_ptr system throw_exception variant2)
+set(BOOST_LIBRARY_cobalt_SUPPORTS "!osx & !ios & !android & !uwp")
+set(BOOST_LIBRARY_compat_SHA512 581ab370fffec2e4d531abcec84f6a8fa9a71152375f44147ab0892e7b8549deec10c32056bcc97137ad2d1dee11c0aca416231620185dd904ddc6344ded3c5d)
+set(BOOST_LIBRARY_compat_DEPENDENCIES assert config throw_exception)
+set(BOOST_LIBRARY_compatibility_SHA512 bfc956d62e31929324820d97a17f597ad9397e4eadcfcfb669694fa09f0c743b622e2b8dd37a4eeb8a73e1ae142c9d28fa9c7f4b7e8b856704036609c961bdf0)
+set(BOOST_LIBRARY_compatibility_DEPENDENCIES config)
+set(BOOST_LIBRARY_compute_SHA512 2bbd253f0cf89d8cd34c4a3813b0b42dd8bd8e68c8e2a10b5637c247b3e532ff97ff2abb03be0f030f1710e655d89eab336e7a4b9fb92a3477f213daaf419f05)
+set(BOOST_LIBRARY_compute_DEPENDENCIES algorithm array assert chrono config core filesystem function function_types fusion iterator lexical_cast mpl optional preprocessor property_tree proto range smart_ptr static_assert thread throw_exception tuple type_traits typeof utility uuid)
+set(BOOST_LIBRARY_compute_PATCHES opt-filesystem.diff)
+set(BOOST_LIBRARY_concept_check_SHA512 5d959efc1dc930454552a7e6b896618c2e24242ff9c3d9e63cd30f1090fa84de0650fcd3226043fa3f6fc76d97fe31b9e19f807a553fb1209efda2fbc168cd10)
+set(BOOST_LIBRARY_concept_check_DEPENDENCIES config preprocessor static_assert type_traits)
+set(BOOST_LIBRARY_config_SHA512 d2ca9b1619905c60d7e2d82afab9570e84834e6d8d742e0a10693fd71319c69d8ad3b5a4c4dad007d8df2840aa8a79786e5e9a53ed2c44395bc319995e86bb9e)
+set(BOOST_LIBRARY_container_SHA512 bac716c525f83337551a029497d923eaad3b6e02b14a227bc5bffae593637bae8aac7715a0ff5819857999e2b9b9e526806c7d460203556dbb9baa0d4a216e66)
+set(BOOST_LIBRARY_container_DEPENDENCIES assert config intrusive move)
+set(BOOST_LIBRARY_container_PATCHES posix-threads.diff)
+set(BOOST_LIBRARY_container_hash_SHA512 3abb573c4dccb23d706abf57d21f3a837baf49d9e976d5b7ff31cd41e0b827528e8218f2e63368440e14d6aeaada23db5bbdc389ba70f1cecf94d899ce3fcf1b)
+set(BOOST_LIBRARY_container_hash_DEPENDENCIES config describe mp11)
+set(BOOST_LIBRARY_context_SHA512 cd21a4e834a09783c6c4c26fd9904df9a598ace34cd71f0963baf04801f9d78f62014a0aa48ff711b26e9ed0185fbda5d678e46a57eb7fcf058a5e7f3deecb56)
+set(BOOST_LIBRARY_context_DEPENDENCIES assert config core mp11 pool predef smart_ptr)
+set(BOOST_LIBRARY_context_PATCHES marmasm.patch)
+set(BOOST_LIBRARY_context_SUPPORTS "!uwp & !emscripten")
+set(BOOST_LIBRARY_contract_SHA512 4efee6cb0794408947c66f7731ac2745df910485ab58365adb059f4868737f45475eed835713bdcf50e05c74f3ece2911b70f22445607ee1bd3d98c908a15228)
+set(BOOST_LIBRARY_contract_DEPENDENCIES any assert config core exception function function_types mpl optional preprocessor smart_ptr static_assert thread type_traits typeof utility)
+set(BOOST_LIBRARY_conversion_SHA512 16e50594633b77d584c3cea6430cea8eb4797c7b840291a2724ace112cf2cdfc5caa6519c6671c813c53cc295bafbd4cb12940e98668f51da39f0125c57543c2)
+set(BOOST_LIBRARY_conversion_DEPENDENCIES assert config smart_ptr throw_exception)
+set(BOOST_LIBRARY_convert_SHA512 8b3cbc66378a739c040a7cfdce5d3be391629b34734fc52e8babfec793789368ae0eeff90b46af835967a412155364eaa9205d541e44af2ecb684e332230b7d6)
+set(BOOST_LIBRARY_convert_DEPENDENCIES config core function_types lexical_cast math mpl optional parameter range spirit type_traits)
+set(BOOST_LIBRARY_core_SHA512 36e269dabb7c5c74416d2e55683a7354f47623c726fa95576c8a2c78745e65ce6e9ad5688cc96581f55ba939c00853da30e28d814aef71233080dfcfdb3428f0)
+set(BOOST_LIBRARY_core_DEPENDENCIES assert config static_assert throw_exception)
+set(BOOST_LIBRARY_coroutine_SHA512 e41b0c22bdbc621cc6d1081a1c5050541894648c5ab8de760fc35e203933e4c13eee57c16060b0b2f28f94bef966e6b71eb26206fe495180e1a9905de5abf7ef)
+set(BOOST_LIBRARY_coroutine_DEPENDENCIES assert config context core exception move system throw_exception type_traits utility)
+set(BOOST_LIBRARY_coroutine_SUPPORTS "!(arm & windows) & !uwp & !emscripten")
+set(BOOST_LIBRARY_coroutine2_SHA512 11d84272ce98c6a251253f2bf766255115566d6e29fb2c8b67166666fb76dfda5ab6457368cdd8cf49999598ee03acb81b3abc05c12849681c6da3778a66b2be)
+set(BOOST_LIBRARY_coroutine2_DEPENDENCIES assert config context)
+set(BOOST_LIBRARY_crc_SHA512 86ade360a2c4cd4e6f7e59a474838952a89275917acca1a6fcbabbf408ea82f5fcfe74ed3ff82dc528cd0d631c62d0dc7ae74a6e76ed67d756c44a79c787e9c9)
+set(BOOST_LIBRARY_crc_DEPENDENCIES config)
+set(BOOST_LIBRARY_date_time_SHA512 b5befffc1bc958b7167fd8b7154ded3a07ac47882007577a8aebbe26de0baebe99fdc71867f51e4446ad7e6f454ebe75fc02e1327089b22a4edd60c887a75c32)
+set(BOOST_LIBRARY_date_time_DEPENDENCIES algorithm assert config core io lexical_cast numeric_conversion range smart_ptr static_assert throw_exception tokenizer type_traits utility winapi)
+set(BOOST_LIBRARY_describe_SHA512 6dae1a712b2d3270163f37d7d1761e48c860f9339f1acb64e481056f1e9018222d44a176848a7a704e97a94d1c5b514fec7d5fb532ec179deca1d51984f11326)
+set(BOOST_LIBRARY_describe_DEPENDENCIES config mp11)
+set(BOOST_LIBRARY_detail_SHA512 1235a8297c101a3f35cba4b74aca7bd9d8ded89fe60cf8d4868ea8a1eebe40ffdb50c385a16c11e3fce6dead37aa979c6bc55aa4bd067dc77fb7d1429daf3860)
+set(BOOST_LIBRARY_detail_DEPENDENCIES config core preprocessor static_assert type_traits)
+set(BOOST_LIBRARY_dll_SHA512 da9a2c341a23930e50747d978dc23dc41e2cdbb41cf50f561f309a942adecd855284fc4ca6e6c6f751d721b0a02bf476266ea4a66fb3e67abfafc17d93c87dce)
+set(BOOST_LIBRARY_dll_DEPENDENCIES assert config core filesystem function move predef smart_ptr spirit system throw_exception type_index type_traits winapi)
+set(BOOST_LIBRARY_dynamic_bitset_SHA512 e86fc2ef217bdead342aa50d7e2e629b07b58059aecd99ca9d34414cd83cf1cc0effb707a18c140d9403766266098af03d758b5aaf61933a893430104b5d3b3e)
+set(BOOST_LIBRARY_dynamic_bitset_DEPENDENCIES assert config container_hash core integer move static_assert throw_exception)
+set(BOOST_LIBRARY_endian_SHA512 022205042407ff55f28a24282b3de56a71bc94b7d55a8cfbb92b83d343d07456c3d77612aeda222327bde59fdc69942bd5dc06056bd4f61e146db180db3160a5)
+set(BOOST_LIBRARY_endian_DEPENDENCIES config)
+set(BOOST_LIBRARY_exception_SHA512 1472e4e59d2397f30bbc32e0d9bc9965d36272fb290a9a923363b396ecd6a4f7d0a7e874eeb3f5d2b3ba5cada279eb10e948df5c96b45994439bbcda76b2105e)
+set(BOOST_LIBRARY_exception_DEPENDENCIES assert config core smart_ptr throw_exception tuple type_traits)
+set(BOOST_LIBRARY_fiber_SHA512 9936195278181804a25b1b1b8a358c96cc3bc6e6d3952c0f01c29de349f1562503e063eb4f569deeca3589cb902ed1200e0db5289f9f7c0756934914e445caf5)
+set(BOOST_LIBRARY_fiber_DEPENDENCIES algorithm assert config context core filesystem format intrusive predef smart_ptr)
+set(BOOST_LIBRARY_fiber_SUPPORTS "!uwp & !(arm & windows) & !emscripten")
+set(BOOST_LIBRARY_filesystem_SHA512 cb036ab7a381ffd72c0a415d00b256c82445f4f777ce5b7b1490f9dcea53e28af8ccea67807a12195f44bfee6aa29e1bd7178cef2199f2cfd017c066c005d29c)
+set(BOOST_LIBRARY_filesystem_DEPENDENCIES assert atomic config container_hash core detail io iterator predef scope smart_ptr system type_traits winapi)
+set(BOOST_LIBRARY_filesystem_SUPPORTS "!uwp")
+set(BOOST_LIBRARY_flyweight_SHA512 dc5862df3f1f1b8d8704175952690011dd02e01cd396318b24da4d52e9b5c12da27903128a6003439b92934ce4fb3341b42972152793d17768a04acedcf0bde7)
+set(BOOST_LIBRARY_flyweight_DEPENDENCIES assert config container_hash core detail interprocess mpl multi_index parameter preprocessor smart_ptr throw_exception type_traits)
+set(BOOST_LIBRARY_foreach_SHA512 9ec2431151570a7cc0efa8e9651a6ea5484e8e483a50067faa221e26c2bfbaf26e7ff97de7bb8fa82cbffaead5710f9df28ef1781aff83320e747110d678c531)
+set(BOOST_LIBRARY_foreach_DEPENDENCIES config core iterator mpl range type_traits)
+set(BOOST_LIBRARY_format_SHA512 7b1d2bc208835e2d106265f98df005026a1e73f9f7f8414a379581e1aa4dd27458343855db0fb4ca8ae00d783c995c23e983e051b7f418110400df7674cc5de4)
+set(BOOST_LIBRARY_format_DEPENDENCIES assert config core optional smart_ptr throw_exception utility)
+set(BOOST_LIBRARY_function_SHA512 c3ff72eaad404c14cbcb5da18ae434390c5f2baac31809ce1862ecc2b71d76c844864c1147a8365ee51e6fc93cb42342782a3438d4b35f617582fc3cb0ca4580)
+set(BOOST_LIBRARY_function_DEPENDENCIES assert bind config core throw_exception)
+set(BOOST_LIBRARY_function_types_SHA512 4b58a7b8b7f3f0115d85bf7c141b6d06f9b16a0e537cf9fce40c784a62accb289436c1dafaed11217e1658b32dd9b7834914aee80642248de07a495328968d5f)
+set(BOOST_LIBRARY_function_types_DEPENDENCIES config core detail mpl preprocessor type_traits)
+set(BOOST_LIBRARY_functional_SHA512 47bd14e4768bc2d71e450d3c82be006bb036526f9de2667aabd81646bc80da144a6f43e21a9e5d2d38272c268fb1aa48644a36fb75dc010ef879f2fbc4dfa633)
+set(BOOST_LIBRARY_functional_DEPENDENCIES config core function function_types mpl preprocessor type_traits typeof utility)
+set(BOOST_LIBRARY_fusion_SHA512 335fdf5f66711cc755e9c44b9bb33b1312c5850e1ff864c71a90d5ff3db92e23286445975a0395b53bfec300c6d5a4619a30baa60956b244e8ece779d3bd0a1d)
+set(BOOST_LIBRARY_fusion_DEPENDENCIES config container_hash core function_types functional mpl preprocessor static_assert tuple type_traits typeof utility)
+set(BOOST_LIBRARY_geometry_SHA512 1dc66ddee35716c7891e9f4035ae8da8bcbb52b8130f16db2e464c0317fdcdf94e88ab252cee5a38ad4d3ce61925b77bdfa72abb35ef4b0948ef3d30d0f78ba7)
+set(BOOST_LIBRARY_geometry_DEPENDENCIES algorithm any array assert concept_check config container core function_types fusion integer iterator lexical_cast math mpl multiprecision numeric_conversion polygon qvm range rational serialization static_assert thread throw_exception tokenizer tuple type_traits variant variant2)
+set(BOOST_LIBRARY_gil_SHA512 97de2f6af8b60f826c330677646ebf9e94832f4e94bbe2be7ec799856956e2f6c809f6bbd00541642e7f6db4817d2f10343ab55babdb6710bb9c1c702c313c6e)
+set(BOOST_LIBRARY_gil_DEPENDENCIES assert concept_check config container_hash core integer iterator mp11 preprocessor type_traits variant2)
+set(BOOST_LIBRARY_gil_PATCHES remove-boost-filesystem-dep.diff)
+set(BOOST_LIBRARY_graph_SHA512 fcd2554e467f499352b3ae9166891c58e49edd60a56a79197e8adf5d0c188d12df143d89667aa27d78307548ef9c30d0cce3ecf5f39404ed610283c4f3f6a4cb)
+set(BOOST_LIBRARY_graph_DEPENDENCIES algorithm any array assert bimap bind concept_check config container_hash conversion core detail foreach function integer iterator lexical_cast math move mpl multi_index optional parameter preprocessor property_map property_tree random range regex serialization smart_ptr spirit static_assert throw_exception tti tuple type_traits typeof unordered utility xpressive)
+set(BOOST_LIBRARY_graph_parallel_SHA512 701e068240813a64aa1215e241a770b3497a8f9a054eeef98fd3d8462ac60fbf943c7e0d833f097ddb5f2e18b843459707027c2b144cb81517f60d4cc8672c6a)
+set(BOOST_LIBRARY_graph_parallel_DEPENDENCIES algorithm assert concept_check config container_hash core detail dynamic_bitset filesystem foreach function graph iterator lexical_cast mpi mpl optional property_map property_map_parallel random serialization smart_ptr static_assert tuple type_traits variant)
+set(BOOST_LIBRARY_graph_parallel_EXTERNAL ON)
+set(BOOST_LIBRARY_hana_SHA512 16b3fbc6a95c980a5dae83d001bc5a4cf115c1379ecc9305eb10f5a737057160341c51354413b35040ff59778803fd173e6b0f0e0053a888734881b991a82109)
+set(BOOST_LIBRARY_hana_DEPENDENCIES config core fusion mpl tuple)
+set(BOOST_LIBRARY_headers_SHA512 4cd0f4c04fe8891789139ba454aa87c97bbaa2de6ee16dd9fa251ce6902c4c7685dfa00295cbf4c1b7e08b013c0eba3fa87404d1ba363fafb2020d2e9e9064dc)
+set(BOOST_LIBRARY_heap_SHA512 4585d61775ad0c3f374d5d67d817b471fa5d0f796f396a09a100192898837b318d87507c2b86e3ad9ae6e37de160b1b2ff884f7ade13bfb83300b8371b32fa2e)
+set(BOOST_LIBRARY_heap_DEPENDENCIES array assert bind concept_check config core intrusive iterator parameter static_assert throw_exception type_traits)
+set(BOOST_LIBRARY_histogram_SHA512 3be9658d1938c62751428c6b76a315b4089832634d6ad1ac7836cd96ba21798fcf9c3810e04dbd04e71c585b1fd8e097d10fac99aa936fd3f552b7339c6e6a36)
+set(BOOST_LIBRARY_histogram_DEPENDENCIES config core math mp11 serialization throw_exception variant2)
+set(BOOST_LIBRARY_hof_SHA512 b7babd4d1aad5f1a1fae4186248c07e9ec2d790c03abdaf847645d41b02517b3ca8e14ffb40f4973d8486b2c2ab0bd4b94e0d27c272b2d2b3aee1c81da003665)
+set(BOOST_LIBRARY_hof_DEPENDENCIES config)
+set(BOOST_LIBRARY_icl_SHA512 fd1346495ce408fed874e68baf24641552553f5754fa59e29d2b36b10ef5cae8cd655af13fe378620c1dff45afc5412ff63bf2bfbca33aad62631406eab181bf)
+set(BOOST_LIBRARY_icl_DEPENDENCIES assert concept_check config container core date_time detail iterator move mpl range rational static_assert type_traits utility)
+set(BOOST_LIBRARY_integer_SHA512 9bef2fc320f72c20b0eadef9b2693dc3288e7903650b11496b6cdba55b8a9e7e21cbdf47985b8611612f3a1aeb8354ca7cfdda8cedbf0d0ed7f5e5708628cdeb)
+set(BOOST_LIBRARY_integer_DEPENDENCIES assert config core static_assert throw_exception type_traits)
+set(BOOST_LIBRARY_interprocess_SHA512 f619d1e29e2ce2808d2edb6e022a877bcbf762ea1eb7bd2518dce2cd047be7402272f5e5bb7fc5120a7318f4643ab7107d908b4b7c15c4e3e0ee7231ed1fc7ee)
+set(BOOST_LIBRARY_interprocess_DEPENDENCIES assert config container core intrusive move static_assert type_traits winapi)
+set(BOOST_LIBRARY_interprocess_PATCHES unused-link-libs.diff)
+set(BOOST_LIBRARY_interval_SHA512 918a84b539a0efa21d30c047f2ebcecdb794019cd048a56e44ca7fbc893eaedf1835eefb0c4bc7185b10207a576741ab452074e351432965542bc28f8ec33772)
+set(BOOST_LIBRARY_interval_DEPENDENCIES config detail logic)
+set(BOOST_LIBRARY_intrusive_SHA512 bce80432295b596b0bdb3682353623fb6fd2fa5ff4f732ccf8c3806b8392e386e4d101de91901abc9c3028ab8d329266e0b07f23ed41f02239025d182b5bd74d)
+set(BOOST_LIBRARY_intrusive_DEPENDENCIES assert config move)
+set(BOOST_LIBRARY_io_SHA512 060e3c5b6e2e1bfc804ef2722f1380683a92466b4f8b41a39d66d1be2f1951973936f60210bec94dcabfb88442170e6467d36c9db8936875ff81d6006fb7601d)
+set(BOOST_LIBRARY_io_DEPENDENCIES config)
+set(BOOST_LIBRARY_iostreams_SHA512 4ceafacc4eb5797f3add43e45b7ea6232724abe553b1069d050bfdbcf82a236e9a4e662f88f8a11d6bc760b55fb43b898692bed006455f7753baf2c9a74baf6c)
+set(BOOST_LIBRARY_iostreams_DEPENDENCIES assert config core detail function integer iterator mpl numeric_conversion preprocessor random range regex smart_ptr static_assert throw_exception type_traits utility)
+set(BOOST_LIBRARY_iostreams_PATCHES Removeseekpos.patch fix-zstd.diff)
+set(BOOST_LIBRARY_iostreams_SUPPORTS "!uwp")
+set(BOOST_LIBRARY_iostreams_EXCLUDED ON)
+set(BOOST_LIBRARY_iterator_SHA512 1e6adfd1cc1236ccbdb91ec94f041720b5acd867a475f7091e3007adbacdd44c0a154d2044bfa319f4d0f945a268d16dac37d26e3dc478ee576cec3ce1ce868b)
+set(BOOST_LIBRARY_iterator_DEPENDENCIES assert concept_check config core detail function_types fusion mpl optional smart_ptr static_assert type_traits utility)
+set(BOOST_LIBRARY_json_SHA512 44788307fe747b417c42ded277fae4f0ae6d599d02971c65a55c020609435248a2013a8b42c8fcb25f7b39a73b5155d414cfbc729bcb157fed566962eff3b817)
+set(BOOST_LIBRARY_json_DEPENDENCIES align assert config container container_hash core describe endian mp11 static_assert system throw_exception)
+set(BOOST_LIBRARY_lambda_SHA512 35886bfdf1391f868fdc148905547a8b8090ca7c21913a565d698232715b93835a0908a2db73550bb69aeebfe38bc07b14f6b34bdf8e9de00f2cc5095912bf9e)
+set(BOOST_LIBRARY_lambda_DEPENDENCIES bind config core detail iterator mpl preprocessor tuple type_traits utility)
+set(BOOST_LIBRARY_lambda2_SHA512 5af711d0011f9deed59e23ab548d6ed15ef9eaa86616ea62756e833013e7b6564e129f009a93de5d8940e322f863297ba3c59aa77d680a81189de34fb36671fe)
+set(BOOST_LIBRARY_lambda2_DEPENDENCIES config)
+set(BOOST_LIBRARY_leaf_SHA512 8adcfc3447ed54b7696217060cf41a9da12a1ba11c1214cc28f39a6f4b54c1b479b2163c66ca7b21ae7b77070baf15faa2184bc02a8855f75739e6091c5eb22c)
+set(BOOST_LIBRARY_leaf_DEPENDENCIES config)
+set(BOOST_LIBRARY_lexical_cast_SHA512 f4ce81d6f1acc31b131bb60d2918147f3cdbb9ab38a1abf8d463fc437d5eea6cd8dcc676b09b28c3174c2ffeb7cabb2439cbc546bbea86f8ea01c2dee596f39d)
+set(BOOST_LIBRARY_lexical_cast_DEPENDENCIES config container core integer throw_exception type_traits)
+set(BOOST_LIBRARY_local_function_SHA512 68dec23a37e8594883aca078d0f1bda607234491f91ac234077317ff161386465e49c3d3c9dec3a29b8d18296ed46c456270cabf12d945556c53020f238492b7)
+set(BOOST_LIBRARY_local_function_DEPENDENCIES config mpl preprocessor scope_exit type_traits typeof utility)
+set(BOOST_LIBRARY_locale_SHA512 e66d2f11a29637a13dfb90fd67fb69374a869553e665452fbcb7b0909535526c57e66dd69c766cd2ade2ba74d790b07a80012937f86c0c7752e683b08d7ccd4d)
+set(BOOST_LIBRARY_locale_DEPENDENCIES assert config core iterator predef thread utility)
+set(BOOST_LIBRARY_locale_SUPPORTS "!uwp")
+set(BOOST_LIBRARY_locale_EXTERNAL ON)
+set(BOOST_LIBRARY_lockfree_SHA512 1cfeb02576b8075449fb899ddc46dbb5d953b27abf768fe7d6a72506d1b45d6d93621a83189238f7366c5070ed915680b30c532d1a95b0c24d55bc6f17d09f27)
+set(BOOST_LIBRARY_lockfree_DEPENDENCIES align array assert atomic config core integer iterator mpl parameter predef static_assert tuple type_traits utility)
+set(BOOST_LIBRARY_log_SHA512 3772a3cdc39f52e04080e2e416452bd698b2b2a6ba12e51b2a4e70e8cc524b1c71c8f67fa4ebfedd0a6b4a4b62603d62b3242a6d65a93cdd48315e470dd9f1fd)
+set(BOOST_LIBRARY_log_DEPENDENCIES align asio assert atomic config core date_time exception filesystem function_types fusion interprocess intrusive io iterator move mpl optional parameter phoenix predef preprocessor property_tree proto random range regex smart_ptr spirit system thread throw_exception type_index type_traits utility winapi xpressive)
+set(BOOST_LIBRARY_log_SUPPORTS "!uwp & !emscripten")
+set(BOOST_LIBRARY_logic_SHA512 47f41a660d6bcef88a81c1aef0b08a420553460ea8851a830f03da232aed04ce577f50316b0c2c055d0a66a4df4392e7c0281330430ce053169fc9356620a5c2)
+set(BOOST_LIBRARY_logic_DEPENDENCIES config core)
+set(BOOST_LIBRARY_math_SHA512 1cafc98a4bbfce1868f8eb92bc039473065dfc49a2b4909a045758e5ba65f4c1df7ffe4a4f82fb1d0d5fbf548dfce240fbc31e8b5fd1ec2d1d9809b8992bfc14)
+set(BOOST_LIBRARY_math_DEPENDENCIES assert concept_check config core integer lexical_cast predef random static_assert throw_exception)
+set(BOOST_LIBRARY_math_PATCHES build-old-libs.patch opt-random.diff)
+set(BOOST_LIBRARY_math_OPTIONS -DBOOST_MATH_BUILD_WITH_LEGACY_FUNCTIONS=OFF)
+set(BOOST_LIBRARY_metaparse_SHA512 9e43a66f8e47ff850af444a20ae7bb9cb88bd5dd14e9a75c653a1635d4c3a962909c4278f7943032d58bd540fdb86792ade73f99055548a54f2efdf2fce338bd)
+set(BOOST_LIBRARY_metaparse_DEPENDENCIES config mpl predef preprocessor static_assert type_traits)
+set(BOOST_LIBRARY_move_SHA512 753ff955f350db2ee4289dde8b21d40905f6b22676935bd8ff4958d6307fbd4fb3fb4038055869a82219ec4988714a4adf2d5784a0a1762f0719b3ccb3b4f80b)
+set(BOOST_LIBRARY_move_DEPENDENCIES config)
+set(BOOST_LIBRARY_mp11_SHA512 de2df1ec464785891f457bf6c7aba6ed93a6fa9a7ca5b2eedbce28a4e5e23362c08282931fd639193c4c2e7434aec449ebacdcb3ea9e12655265b52aced8b89a)
+set(BOOST_LIBRARY_mp11_DEPENDENCIES config)
+set(BOOST_LIBRARY_mpi_SHA512 c229ac1cd354245da2d03d054f2725c63c500c87c1de8f50b0c8b1946a6095c9948715c5abd24d7ddae639616793c1535a2171c7e698d2ed25a8515eab37ceb2)
+set(BOOST_LIBRARY_mpi_DEPENDENCIES assert config core foreach function graph integer iterator lexical_cast mpl optional serialization smart_ptr static_assert throw_exception type_traits utility)
+set(BOOST_LIBRARY_mpi_SUPPORTS "!uwp")
+set(BOOST_LIBRARY_mpi_EXTERNAL ON)
+set(BOOST_LIBRARY_mpl_SHA512 a28099eeebb00369f3e1e8b7cfc0a1fbdf8bd6b162da48e2034004cdf1e8732fa2c1fdeffb3c3fc7fd13550b4b1a7da4f51f66842be39d723d3edc755ddf48be)
+set(BOOST_LIBRARY_mpl_DEPENDENCIES config core predef preprocessor static_assert type_traits utility)
+set(BOOST_LIBRARY_msm_SHA512 400b175afa4a369c1a06ffbed35921b800880d65304a08ca9d53113f7ddcc72776d90a9af3f5a5468de848d2cb1bed7585a42caf6d08cd44b8acf32bb65ef00c)
+set(BOOST_LIBRARY_msm_DEPENDENCIES any assert bind circular_buffer config core function fusion mpl parameter phoenix preprocessor proto serialization tuple type_index type_traits typeof)
+set(BOOST_LIBRARY_multi_array_SHA512 c8b0430f7ea8fefe078029ee88867e3ba1f73a33a21e9f70a00c44ecccee2020ed2db78bd06d3c56da7717633e9ffc140f74a1af0b4903a2753ba04067ea4a6f)
+set(BOOST_LIBRARY_multi_array_DEPENDENCIES array assert concept_check config core functional iterator mpl static_assert type_traits)
+set(BOOST_LIBRARY_multi_index_SHA512 e86ffc579e7274509f91ed1a87efcbb6f2d559a1f18a6b276aa2424d9acf54b3b0e418c9fee5935ec8e097f4602ba61e2501ee5c0e971879c7636078134e9252)
+set(BOOST_LIBRARY_multi_index_DEPENDENCIES assert bind config container_hash core integer iterator move mpl preprocessor smart_ptr static_assert throw_exception tuple type_traits utility)
+set(BOOST_LIBRARY_multiprecision_SHA512 e9f8f86180abcb2d9c7762cbf0200868645a9c99a792a5bd5b52df5e3038263a69ebdc12436284c8fc3982dab02bacf157120e838ecc432f99f749d4fc2d6bbd)
+set(BOOST_LIBRARY_multiprecision_DEPENDENCIES assert config core integer lexical_cast math predef random throw_exception)
+set(BOOST_LIBRARY_multiprecision_PATCHES remove-random.diff)
+set(BOOST_LIBRARY_mysql_SHA512 c3a096515f631b92fb3b69eae5ab5fe30be93269fd0176dd87c65a9212539b7aec2ac1386bf5401d5a01c75f8151666ecb643813fa59f7742ff3372b54a46a57)
+set(BOOST_LIBRARY_mysql_DEPENDENCIES asio assert charconv config core describe endian intrusive mp11 optional system throw_exception variant2)
+set(BOOST_LIBRARY_mysql_EXTERNAL ON)
+set(BOOST_LIBRARY_nowide_SHA512 f3dd88c9c48360cf5603a152d16626479ac23a8fa90916658f9ca2b596f28ab3b37cbb6c70e91c5a98fd59d5b5e8054015131e1bafae8146f0f5f766946b159d)
+set(BOOST_LIBRARY_nowide_DEPENDENCIES config filesystem)
+set(BOOST_LIBRARY_numeric_conversion_SHA512 b2f80515df47f92b5db2711c6fee577c1b776b302a712d6105caf7ade6727799cc0e30e09cc251b59f0315fbbb96593cc66b7fa5209ecce87b8476a4652df444)
+set(BOOST_LIBRARY_numeric_conversion_DEPENDENCIES config conversion core mpl preprocessor throw_exception type_traits)
+set(BOOST_LIBRARY_odeint_SHA512 7e15d0eb8566a35e2d9968c779750a9135d43d9a3523789d9c2ba977c4d1dac1afbc3c62fb2d1efc8ab60d4b58f0b6c07fa03719d62acee76a7376726ecf26c6)
+set(BOOST_LIBRARY_odeint_DEPENDENCIES assert compute config core fusion iterator math mpl multi_array preprocessor range static_assert throw_exception type_traits ublas units utility)
+set(BOOST_LIBRARY_odeint_PATCHES opt-mpi.diff)
+set(BOOST_LIBRARY_odeint_OPTIONS -DBOOST_ENABLE_MPI=OFF)
+set(BOOST_LIBRARY_optional_SHA512 1917bde44b4284c193e89de30f71681a71b414ed3aefebc07dec3df441a94f629fbc34a1175232604d99649979ef99dae0fc7072346eb601d5620775e2388184)
+set(BOOST_LIBRARY_optional_DEPENDENCIES assert config core detail move predef static_assert throw_exception type_traits utility)
+set(BOOST_LIBRARY_outcome_SHA512 4082967c4bff31898b2a1706ac3f069c6a44bad92a3470c8001d375956f1742cd33a4f96c2184c502c1a61edc2ad40bdaae188e5c65c286683ebf4100c584b1a)
+set(BOOST_LIBRARY_outcome_DEPENDENCIES assert config exception system throw_exception)
+set(BOOST_LIBRARY_parameter_SHA512 42ca9ab48cd3f871104f9b435129ffe2e7a25c6dbb65102b4b9e3bd7ff2b5d5f69a2a876585607b6fc8199d4204839d7241eecfc5d2f9be6381c362f57124780)
+set(BOOST_LIBRARY_parameter_DEPENDENCIES config core function fusion mp11 mpl optional preprocessor type_traits utility)
+set(BOOST_LIBRARY_parameter_python_SHA512 64d32f11042db4d88f4c96e1f68c12cc9eee007398054ddd02c4b884247e2aa673ec69a3c51a7774e88d58c40758af63e2e523f46f0680bfd7ce3d5398cc3bb1)
+set(BOOST_LIBRARY_parameter_python_DEPENDENCIES config mpl parameter preprocessor python)
+set(BOOST_LIBRARY_pfr_SHA512 19e6c58ade33a01ca6686aa9d19d4725dec448ba8bdeced15f1e72b0a691092c8009b82b72d1ad7d632121b19953255d47446833b63943b1e964eaf3c487d61e)
+set(BOOST_LIBRARY_pfr_DEPENDENCIES config)
+set(BOOST_LIBRARY_phoenix_SHA512 6d54655310d4ec03217bb8e88b28fa56bf8512a00223b602df072eaba3f35ead1f89aeb58e4084e955bb08f34497093707daf848678c324b857a51c6462eff80)
+set(BOOST_LIBRARY_phoenix_DEPENDENCIES assert bind config core function fusion mpl predef preprocessor proto range smart_ptr type_traits utility)
+set(BOOST_LIBRARY_poly_collection_SHA512 eee224078f2b9752156537f0e9672123b19426abd7f559cddc28d6cfbf44b5461b0e32c157cf207018a18ee91f9e03e6ebd83dd1389ce91ad416648dfae00682)
+set(BOOST_LIBRARY_poly_collection_DEPENDENCIES assert config core iterator mp11 mpl type_erasure type_traits)
+set(BOOST_LIBRARY_polygon_SHA512 85b77ef37d4e370ec463129da539f4767e2a1fc957d8f4349d4d36ada77ec9ad440733a93e55a756fc20c9f23bcdc6cd4b1aea6b65881e112e3c69853881e561)
+set(BOOST_LIBRARY_polygon_DEPENDENCIES config)
+set(BOOST_LIBRARY_pool_SHA512 56b22505892f282b95e37d314d1d233f2f1649c725fdadfbd4f59ab7551164a88412a641625957fc4e3442e116616437667c768e6e0c7dec8fb94a2188ee1a28)
+set(BOOST_LIBRARY_pool_DEPENDENCIES assert config integer throw_exception type_traits winapi)
+set(BOOST_LIBRARY_predef_SHA512 b908034a88b91c1a35e2933207a09e06862994ee36f5c62d2e58842bbb4d2bcfe10069350bfb330276f6b4e1e0ff213a4f2f7b7f0ac54c12e022c6c397b32ef0)
+set(BOOST_LIBRARY_predef_DEPENDENCIES config)
+set(BOOST_LIBRARY_preprocessor_SHA512 f7b4c108c8276da8b441136af2e24dba67842e1461f4f1add56722680c2f8194f87e06610be09ad8c65145e5fd1f74430027fa606599d1b2d2824a0805cfcf01)
+set(BOOST_LIBRARY_preprocessor_DEPENDENCIES config)
+set(BOOST_LIBRARY_process_SHA512 a084c71effdd591b83a7fbff85bdea925da1436dc452267ceafd0f7bd875dcd9611cd28a92c06548e9130bb596703ea05932cd94063724cfecf6d861cceebe21)
+set(BOOST_LIBRARY_process_DEPENDENCIES algorithm asio assert config core filesystem fusion io iterator move optional system throw_exception tokenizer type_index type_traits utility winapi)
+set(BOOST_LIBRARY_process_PATCHES opt-filesystem.patch)
+set(BOOST_LIBRARY_process_SUPPORTS "!uwp & !emscripten & !android")
+set(BOOST_LIBRARY_program_options_SHA512 bf0fe8d2dc75fd29bc61eb594a1871cc73412467c61dfbac6f1996793426b406c48c7c61d7eb0db5264c70028529fde1181bf3d591980acd5fb465c44bd92d85)
+set(BOOST_LIBRARY_program_options_DEPENDENCIES any bind config core detail function iterator lexical_cast smart_ptr static_assert throw_exception tokenizer type_traits)
+set(BOOST_LIBRARY_property_map_SHA512 d5d3c448695d5be850413a1c68fd91eaab94e2b0ad14f365f5fa96dc2d0e4cb9c13e6f4bfa9b14bdd9e4549b86e3205851e52c8c13f5c2c46ba6e495e12bb48e)
+set(BOOST_LIBRARY_property_map_DEPENDENCIES any assert concept_check config core function iterator lexical_cast mpl smart_ptr static_assert throw_exception type_index type_traits utility)
+set(BOOST_LIBRARY_property_map_parallel_SHA512 000cfb346a7c150af595541cc4dcbabdfaa668dee2f2c05ff780ba5c290f4013de6fc354687a2f16197c68831746ab210a1af6d1218d53231ffd3135909b2bf0)
+set(BOOST_LIBRARY_property_map_parallel_DEPENDENCIES assert concept_check config function mpi mpl multi_index optional property_map serialization smart_ptr static_assert type_traits)
+set(BOOST_LIBRARY_property_tree_SHA512 5fc15952d51dd298adb8b3b9121bdae6eb7188aae0518ba3591dcd83ef0d73b57771f8b7ee9d939ff3a682d853feeb409b82d0d63f96bf7a720d6dde6be83399)
+set(BOOST_LIBRARY_property_tree_DEPENDENCIES any assert bind config core iterator mpl multi_index optional range serialization static_assert throw_exception type_traits)
+set(BOOST_LIBRARY_proto_SHA512 4e89061602f4a2646eeb570e65adf588dab169461527aa60cb3c2328a227c81ec233311af431dd14ab0fe1f14d64486b0b10cbcb9ddfa156289a11661abfb117)
+set(BOOST_LIBRARY_proto_DEPENDENCIES config core fusion mpl preprocessor range static_assert type_traits typeof utility)
+set(BOOST_LIBRARY_ptr_container_SHA512 fd45d221bc9dfb81822943c8bcfa02285f3054977bb07285c5754b8cef7c3db4ecb90e591410bc636e3474ae71ec2e232e5f2d3ea4a46caf14182633b1954213)
+set(BOOST_LIBRARY_ptr_container_DEPENDENCIES array assert circular_buffer config core iterator mpl range smart_ptr static_assert type_traits unordered utility)
+set(BOOST_LIBRARY_python_SHA512 8823bd211c2c505cc990ee7aeae6a064801538fba018dde80b6118b4434909029f2ffaa3b53cdbb6b51500adbd5314de37da01c6960afeebe57b15582cec322a)
+set(BOOST_LIBRARY_python_DEPENDENCIES align bind config conversion core detail foreach function graph integer iterator lexical_cast mpl numeric_conversion preprocessor property_map smart_ptr static_assert tuple type_traits utility)
+set(BOOST_LIBRARY_python_PATCHES remove_undef.diff)
+set(BOOST_LIBRARY_python_SUPPORTS "!uwp & !emscripten & !ios & !android")
+set(BOOST_LIBRARY_python_EXTERNAL ON)
+set(BOOST_LIBRARY_qvm_SHA512 93dc58a5de6576523478856863daea225a26667463b4b0f188a78c82f11fe2610095600f70491877e866f7eb1bf76616fbb339f951f9342e6edbe143ef57cb1c)
+set(BOOST_LIBRARY_qvm_DEPENDENCIES config)
+set(BOOST_LIBRARY_random_SHA512 eb436d7cec4ff70b4532dc63b8d2f32ab1bc21a8734072dde91424b8beaf76a72c172c00ddea821882509ddd63385a260ea412064a74542cbe537b3e66ef0d89)
+set(BOOST_LIBRARY_random_DEPENDENCIES array assert config core dynamic_bitset integer io range static_assert system throw_exception type_traits utility)
+set(BOOST_LIBRARY_random_SUPPORTS "!uwp")
+set(BOOST_LIBRARY_range_SHA512 1da5bf0546ac612afe9dac522a8207ff27d2714144790729791d9b2b3151691d9f23fdea9a6a16517cf8de88e7717f1b8916c953d0c81fc4444ba2c399bea9d6)
+set(BOOST_LIBRARY_range_DEPENDENCIES array assert concept_check config container_hash conversion core detail iterator mpl optional preprocessor regex static_assert tuple type_traits utility)
+set(BOOST_LIBRARY_ratio_SHA512 5d355b1cfafc4a4548c049a7cb90faef9a3942934f798444ccdf322d720c62af1b257992f8e80ce3b48cefbbe3cdfd21b984fc4b5c3ed8cfcbc0222b1c9f2f34)
+set(BOOST_LIBRARY_ratio_DEPENDENCIES config)
+set(BOOST_LIBRARY_rational_SHA512 720b7fb736135c0f3d5ca237ad72d64b36394bccaff68ef0038f7f65f3da8d6914fafd4ed645e3a85b16702d65075f5130d18905ad10c390dabedeab4e6bfda3)
+set(BOOST_LIBRARY_rational_DEPENDENCIES assert config core integer static_assert throw_exception type_traits utility)
+set(BOOST_LIBRARY_redis_SHA512 918ad6b11a787125d344fad9b62d83e4ab7a4ba098e37be854345befb4e48bcd3b56fc6c2797fc454e3ca2ac1d26b1a5f958720e81e0bd71d1a0b308cdb215bc)
+set(BOOST_LIBRARY_redis_DEPENDENCIES asio assert config core mp11 system throw_exception)
+set(BOOST_LIBRARY_regex_SHA512 4c52620fd8f754e8053b5c70cab7a274e311751356c90546f7f54d2700d744638ffc0db0e974ae80ef15efc4564ce8c81a98c02604f8e6ed0a7cc9b94e0d8aae)
+set(BOOST_LIBRARY_regex_DEPENDENCIES assert concept_check config container_hash core integer mpl predef smart_ptr static_assert throw_exception type_traits)
+set(BOOST_LIBRARY_regex_PATCHES compat.diff)
+set(BOOST_LIBRARY_regex_OPTIONS -DBOOST_REGEX_ENABLE_ICU=OFF)
+set(BOOST_LIBRARY_safe_numerics_SHA512 b9fda40e3012af0431ca29982aba36caf6303e6a80f5738454f6c704f8c8f2e3c826f4f9338da826f61bf81aa0cd26dbf9155105ec4ecfac6c61e0e8506622e9)
+set(BOOST_LIBRARY_safe_numerics_DEPENDENCIES concept_check config core integer logic mp11)
+set(BOOST_LIBRARY_scope_SHA512 5f16d7f457197bd6d5c0a259ff5fda9508f18fa4acfbe9b619cac1741b346f51e3e21e086f1f97ca2996d1cc5d700f4995b4c785e12a69bf883ba31920ecd20c)
+set(BOOST_LIBRARY_scope_DEPENDENCIES assert config core type_traits)
+set(BOOST_LIBRARY_scope_exit_SHA512 28dbee1fe9f828c2ed31b1284959ef26fb54702823c0a680b1c4058bda829c7afdd77ce5df82f148ee43b4d924c60ba3067a44df1444063f68d3ca7c36e7b4fa)
+set(BOOST_LIBRARY_scope_exit_DEPENDENCIES config function preprocessor type_traits typeof)
+set(BOOST_LIBRARY_serialization_SHA512 c2743ce8a74321aca1637dcf80bc1e43f842a8ca652a3474cdb015efbe1d0e60204d658ce3437939f1756ab312fbefd8c8b1b00f50726cc10b1369d61c97f529)
+set(BOOST_LIBRARY_serialization_DEPENDENCIES array assert config core detail function integer io iterator move mp11 mpl optional predef preprocessor smart_ptr spirit static_assert throw_exception type_traits utility variant variant2)
+set(BOOST_LIBRARY_signals2_SHA512 ad1e6ec601aaea4f9129f6c9e86f4438bc57e0e0b1de3acb69205a9f686095d610ab536a2a68bbd6e1a0412aec6db9b57156a32742903e7f381203422218201c)
+set(BOOST_LIBRARY_signals2_DEPENDENCIES assert bind config core function iterator move mpl optional parameter preprocessor smart_ptr throw_exception tuple type_traits variant)
+set(BOOST_LIBRARY_smart_ptr_SHA512 5b56c43298cdf3dd636e68276954075a3bae9a1fd5736039b779935f106a252ea9e979e12362b89903375ad1de0078c9fa5c81779ffb91d8453e4e02d711e17e)
+set(BOOST_LIBRARY_smart_ptr_DEPENDENCIES assert config core move static_assert throw_exception type_traits)
+set(BOOST_LIBRARY_sort_SHA512 6c6257bc3c7fc12cbef19e0a96390683d6f8a1cd293beafe86ad9b1d425bb58d00a5788bb45bf7b666ab8259f5934db9c07dd862662ec89f16c170f75c75bc1e)
+set(BOOST_LIBRARY_sort_DEPENDENCIES config core range static_assert type_traits)
+set(BOOST_LIBRARY_spirit_SHA512 a1be8a441b62cad7bc96ecd86830b789495f7b8fa74507d3fc0c41dac3c04309f8480c7ca9d56bcf7cb3e9ad42342f05ab9e5a644d96ff7d397e87ac4d900d72)
+set(BOOST_LIBRARY_spirit_DEPENDENCIES array assert config core endian function function_types fusion integer io iterator move mpl optional phoenix pool preprocessor proto range regex smart_ptr static_assert thread throw_exception type_traits typeof unordered utility variant)
+set(BOOST_LIBRARY_stacktrace_SHA512 643338eaafb956dc184c33889fd038602df0fe626e01b7135cf34cb5d716dabaf94511f78f2eafbc27c05d8881b4e0a230cb86e916a9d3705c7b02a5ad42b22d)
+set(BOOST_LIBRARY_stacktrace_DEPENDENCIES assert config container_hash core predef winapi)
+set(BOOST_LIBRARY_stacktrace_PATCHES fix_config-check.diff)
+set(BOOST_LIBRARY_stacktrace_SUPPORTS "!uwp")
+set(BOOST_LIBRARY_stacktrace_EXCLUDED ON)
+set(BOOST_LIBRARY_statechart_SHA512 1aaf8056b13bfe5f6a7dc51e23155e27af872961cc55e8afe470e4a9dc91eab42ccd7d720bc37ee4f7965f4ab37b33c6d7367308c213bacb5a6454ef960e3c51)
+set(BOOST_LIBRARY_statechart_DEPENDENCIES assert bind config conversion core detail function mpl smart_ptr static_assert thread type_traits)
+set(BOOST_LIBRARY_static_assert_SHA512 f32baa358fd0314a903bab2f87ed3ed50e4027830c38c544a5507207a2ecd4deaf698bc3cef1a1e1967dadc360a7a355b7d7eddf890d514acea21cbc4994ad0f)
+set(BOOST_LIBRARY_static_assert_DEPENDENCIES config)
+set(BOOST_LIBRARY_static_string_SHA512 81b975e2bd5b4c9e84a21ae920c989fcbb8119e81935e44e19cbe67ccb5a7a7a5239e8544d75bfa00e3aa654b8d942d73092c05f98e97c9fe6b9e3bc232a5448)
+set(BOOST_LIBRARY_static_string_DEPENDENCIES assert config container_hash core static_assert throw_exception utility)
+set(BOOST_LIBRARY_stl_interfaces_SHA512 522f422512d2fc5a60caa8d471593983b04b3dc9132229a3e873b1e460a02a7627546588e560c31ed927e4d5f74b30d3a25c9f5748d806e461ecee75fbf91a2e)
+set(BOOST_LIBRARY_stl_interfaces_DEPENDENCIES assert config type_traits)
+set(BOOST_LIBRARY_system_SHA512 d51ecdaa3e5ab82b725f608516ce973224c383bdee90a681d099599bfc0dd5774f50f421075a691d52bf5209c1d0d85762217ec1425e39000eb7fb366f69757a)
+set(BOOST_LIBRARY_system_DEPENDENCIES assert config throw_exception variant2 winapi)
+set(BOOST_LIBRARY_system_PATCHES compat.diff)
+set(BOOST_LIBRARY_test_SHA512 16e06e677bddbdc04a4607c653a66ca36fbf812eef4fe82244197a1a0e428ff0a5e3ead3c423c123273d67bc857a634bae889888175119e04691fdd3e5ad2b27)
+set(BOOST_LIBRARY_test_DEPENDENCIES algorithm assert bind config core detail exception function io iterator mpl numeric_conversion optional preprocessor smart_ptr static_assert type_traits utility)
+set(BOOST_LIBRARY_test_SUPPORTS "!uwp")
+set(BOOST_LIBRARY_thread_SHA512 0c10698176e695011b70aea5b0f427bb4265032349297fd6d71cb8b4d82ff4144ce8b5a4bc7ed9587485e51e46764820d3d4688a1e576dd8ec375140bce1f708)
+set(BOOST_LIBRARY_thread_DEPENDENCIES assert atomic bind chrono concept_check config container container_hash core date_time exception function io move optional predef preprocessor smart_ptr static_assert system throw_exception tuple type_traits utility winapi)
+set(BOOST_LIBRARY_throw_exception_SHA512 5474c6bc6dbc2d3dca6ad4baa60be5638fb69863a21cc6e4d2f3b15f23be5f9a89202a806284fac0191532e2411ddaeddfd8f1f5f0feb6348edcd2aa7338ff23)
+set(BOOST_LIBRARY_throw_exception_DEPENDENCIES assert config)
+set(BOOST_LIBRARY_timer_SHA512 464cde448fcd3254f3087f51ef4cfce6624f8e73f71e0c16f92471544df0559056c30a073b259bc3201cfea6452d2648ea576c0e30eece8b1fc37375ee612a4f)
+set(BOOST_LIBRARY_timer_DEPENDENCIES config io predef)
+set(BOOST_LIBRARY_tokenizer_SHA512 9aff6bdee0abcfd25febef7bf94bff96f6146356ea3c83549f11e6b05c730cce8c24c88fb1bf325f4f69a4aaea9de37be11d73f12c6844c9e56dfa46068b217e)
+set(BOOST_LIBRARY_tokenizer_DEPENDENCIES assert config core iterator throw_exception type_traits)
+set(BOOST_LIBRARY_tti_SHA512 a05af5933e961634dec75971d3398562ba983367fde7387a76bdbf874b758049fe4fa2358d8b7fb480e71c1be813efe4ef87291816d8693eb5f61d0da594e033)
+set(BOOST_LIBRARY_tti_DEPENDENCIES config function_types mpl preprocessor type_traits)
+set(BOOST_LIBRARY_tuple_SHA512 7a2d8bfed1db0f99d6b19c77afa0b0ab55d01a4d5a49605395e65eb3919e24fb75b28c8db999f2c8e8f935d0a2a9f63abda1f2b024bc0b1d51e0ccee71f70e67)
+set(BOOST_LIBRARY_tuple_DEPENDENCIES config core static_assert type_traits)
+set(BOOST_LIBRARY_type_erasure_SHA512 48c24dafdd631057b09c11fc790cee8674211ee21296e1880bd6211f094f409c15a25b453b5914fd89456730d6e42bd7e123376fab6f6c3093b4b788c5141e18)
+set(BOOST_LIBRARY_type_erasure_DEPENDENCIES assert config core fusion iterator mp11 mpl preprocessor smart_ptr thread throw_exception type_traits typeof vmd)
+set(BOOST_LIBRARY_type_index_SHA512 be51ca7a6cbdaae4f13f30f73a075f2898ca5eb3048febd173a6d17cf42c3fbea2508f03f2cfb3364f469ef7d30a124e13a944a16e7be961dd0dfdd83781c4e5)
+set(BOOST_LIBRARY_type_index_DEPENDENCIES config container_hash core throw_exception)
+set(BOOST_LIBRARY_type_traits_SHA512 35f59eb0ae7b854ee0a4b0a307cbc25514fb2d47684bfde760d4fbb8f6c6fb1b93ed919feef08d6fb6339dae25b7e1cc1eb0164a762d247a126e282a562cec98)
+set(BOOST_LIBRARY_type_traits_DEPENDENCIES config static_assert)
+set(BOOST_LIBRARY_typeof_SHA512 08194c921a05ba1d5981e21c2515d575b16c42dcb25fda8a06362130583249659d920c78b0020ccf8f1ab447695aa9fae1f61333bfb3ae0c92387ed138e467f5)
+set(BOOST_LIBRARY_typeof_DEPENDENCIES config)
+set(BOOST_LIBRARY_ublas_SHA512 456300b79bce700364ed3349cfd8ea8c33e68047b671d865035eb10e72a736d49a24825110264e5ca2fc4fb5f7472b27ff540976231e0547b4632a24017c5614)
+set(BOOST_LIBRARY_ublas_DEPENDENCIES compute concept_check config core interval iterator mpl range serialization smart_ptr static_assert type_traits typeof)
+set(BOOST_LIBRARY_units_SHA512 36923eeb494682959057d190c9900dc70b1f966bdb37f5029cade89bb1e1db2ae934825fa02fd11b069c3ed7866ce7c09af6eda86a28357d5f6092e3cd0a8c7d)
+set(BOOST_LIBRARY_units_DEPENDENCIES assert config core integer io lambda math mpl preprocessor static_assert type_traits typeof)
+set(BOOST_LIBRARY_unordered_SHA512 65865639d5e3d9f323cfffbdf532224b1f06f2c04a6a25e7f282a4051814101835c71747642bf7a8a704b6fbcde9006b03abac2e5a1e185a205fc88c3b3394e1)
+set(BOOST_LIBRARY_unordered_DEPENDENCIES assert config container_hash core mp11 predef throw_exception)
+set(BOOST_LIBRARY_url_SHA512 f03f2e3d00a9b1591a1e432613b76ae4e0c5bb633cb8e9725282833b93227edf7f929d4ac138f5a585fe6e66ce030cf00043c73cab02f5ac87edf6c4b07f8c31)
+set(BOOST_LIBRARY_url_DEPENDENCIES align assert config core mp11 optional static_assert system throw_exception type_traits variant2)
+set(BOOST_LIBRARY_utility_SHA512 ce7e43702f0e5f02448408abd21878002d6148e75ac1cf31fc568169807cafbf8128bea5ba3fca84ef977e62acc09342111c9c59ad152cef39da8d57e3cd6cb5)
+set(BOOST_LIBRARY_utility_DEPENDENCIES assert config core io preprocessor throw_exception type_traits)
+set(BOOST_LIBRARY_uuid_SHA512 0c9ec80278696c7c1e1398e1f01bee52adc0afef647d3619c63ba700899329fc82520b7afda8871537163659229d96e6223bf30b6e962084a578051821707864)
+set(BOOST_LIBRARY_uuid_DEPENDENCIES assert config throw_exception type_traits)
+set(BOOST_LIBRARY_variant_SHA512 cb40d94f19955af79483ef0e3c01e32ffde6c57ca38b915867a8f9151a6db967117f22ca2382fa5f728d6222515355dedf6871a54ebc66b8038caa9cd2113e0a)
+set(BOOST_LIBRARY_variant_DEPENDENCIES assert config container_hash core detail integer mpl preprocessor static_assert throw_exception type_index type_traits utility)
+set(BOOST_LIBRARY_variant2_SHA512 0b85a5d229ab6e75575ed1379922d28c227c89f6e6e72302ba723b3a32d4ab13740c2c7a09c35714c1713ed426be1bf7bf14ef5d4e05e894ecc6d1fd83f019ac)
+set(BOOST_LIBRARY_variant2_DEPENDENCIES assert config mp11)
+set(BOOST_LIBRARY_vmd_SHA512 9ec3e6cb7b269f8f0403404ee1afd775e993825f7939a960f2656a2dbe7bb6af0364009f24aaf3c6bb5f6cc2249780cb281ee7f4147401d0e479b3b2cdf24806)
+set(BOOST_LIBRARY_vmd_DEPENDENCIES config preprocessor)
+set(BOOST_LIBRARY_wave_SHA512 2eb0b5327720dd6d58a083c9a5a2d0316bbc2b8d7618aa51929e3f97e6cff7d30b7f1cfce027801d9355dc1d5d78daa7bc2ca891598da25a8e759c82438e6ded)
+set(BOOST_LIBRARY_wave_DEPENDENCIES assert concept_check config core filesystem format iterator lexical_cast mpl multi_index optional pool preprocessor serialization smart_ptr spirit static_assert throw_exception type_traits)
+set(BOOST_LIBRARY_wave_SUPPORTS "!uwp")
+set(BOOST_LIBRARY_winapi_SHA512 e03553565112ec318f63bd7af4829f0406c022ce4df5e0d46667971f6b6c7fc5f538644102591bdc864ac71f431efc606592bb457fe40688fdbf911ac064a28c)
+set(BOOST_LIBRARY_winapi_DEPENDENCIES config predef)
+set(BOOST_LIBRARY_xpressive_SHA512 cf9bb9b0680f43fbbcebe32441b81978ac036c20d1579fce375623e7a03c90276ba5b2b2363fe7988655afabaed42d296e8d2af5b6339a7bddd7b4b44d265054)
+set(BOOST_LIBRARY_xpressive_DEPENDENCIES assert config conversion core exception fusion integer iterator lexical_cast mpl numeric_conversion optional preprocessor proto range smart_ptr spirit static_assert throw_exception type_traits typeof utility)
+set(BOOST_LIBRARY_yap_SHA512 81bdbe0e6d14556fbcca7c13073f2d18811288e8420e775f97e43bce00ea0d34aed61c2aec30a9b0427caa63374d60366c6437e6818b5672d91b828ed6e9d88d)
+set(BOOST_LIBRARY_yap_DEPENDENCIES config hana preprocessor type_index)
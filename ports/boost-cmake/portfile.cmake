@@ -34,6 +34,7 @@ vcpkg_cmake_install()
 file(INSTALL "${SOURCE_PATH_CMAKE}/include/" DESTINATION "${CURRENT_PACKAGES_DIR}/share/boost/cmake-build")
 
 file(INSTALL
+    "${CMAKE_CURRENT_LIST_DIR}/boost-libraries.cmake"
     "${CMAKE_CURRENT_LIST_DIR}/vcpkg-port-config.cmake"
     DESTINATION "${CURRENT_PACKAGES_DIR}/share/${PORT}")
 
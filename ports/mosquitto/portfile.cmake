@@ -13,6 +13,13 @@ vcpkg_from_github(
 
 string(COMPARE EQUAL "${VCPKG_LIBRARY_LINKAGE}" "static" STATIC_LINKAGE)
 
+vcpkg_check_features(OUT_FEATURE_OPTIONS FEATURE_OPTIONS
+    FEATURES
+        broker          WITH_BROKER
+        plugins         WITH_PLUGINS
+        plugins         WITH_CJSON
+)
+
 vcpkg_cmake_configure(
     SOURCE_PATH "${SOURCE_PATH}"
     OPTIONS
@@ -24,12 +31,12 @@ vcpkg_cmake_configure(
         -DWITH_TLS_PSK=ON
         -DWITH_THREADING=ON
         -DDOCUMENTATION=OFF
-        -DWITH_PLUGINS=OFF
-        -DWITH_CJSON=OFF
         -DWITH_CLIENTS=OFF
         -DWITH_APPS=OFF
-        -DWITH_BROKER=OFF
         -DWITH_BUNDLED_DEPS=OFF
+        # The broker installs to sbin
+        -DCMAKE_INSTALL_SBINDIR=bin
+        ${FEATURE_OPTIONS}
     MAYBE_UNUSED_VARIABLES
         WITH_WEBSOCKETS
         STATIC_WEBSOCKETS
@@ -38,6 +45,16 @@ vcpkg_cmake_configure(
 vcpkg_cmake_install()
 vcpkg_copy_pdbs()
 
+if("broker" IN_LIST FEATURES)
+    vcpkg_copy_tools(TOOL_NAMES mosquitto AUTO_CLEAN)
+    # Example configuration files (mosquitto.conf, aclfile.example, ...)
+    if(EXISTS "${CURRENT_PACKAGES_DIR}/etc/mosquitto")
+        file(MAKE_DIRECTORY "${CURRENT_PACKAGES_DIR}/share/${PORT}")
+        file(RENAME "${CURRENT_PACKAGES_DIR}/etc/mosquitto" "${CURRENT_PACKAGES_DIR}/share/${PORT}/examples")
+    endif()
+    file(REMOVE_RECURSE "${CURRENT_PACKAGES_DIR}/etc" "${CURRENT_PACKAGES_DIR}/debug/etc")
+endif()
+
 vcpkg_fixup_pkgconfig()
 
 file(REMOVE_RECURSE "${CURRENT_PACKAGES_DIR}/debug/include")
@@ -328,6 +328,29 @@ if("contrib" IN_LIST FEATURES)
   endif()
 endif()
 
+# CPU optimizations can be chosen in the triplet file, e.g.
+#   set(VCPKG_OPENCV_CPU_BASELINE "AVX2")
+#   set(VCPKG_OPENCV_CPU_DISPATCH "AVX512_SKX")
+# The values are lists of OpenCV optimization names (see OpenCVCompilerOptimizations.cmake).
+# OpenCV's defaults are used for the variables which are not defined.
+foreach(cpu_option IN ITEMS CPU_BASELINE CPU_DISPATCH)
+  if(DEFINED VCPKG_OPENCV_${cpu_option})
+    string(REPLACE ";" "," cpu_value "${VCPKG_OPENCV_${cpu_option}}")
+    string(TOUPPER "${cpu_value}" cpu_value)
+    if(NOT cpu_value MATCHES "^([A-Z0-9_]+(,[A-Z0-9_]+)*)?\$")
+      message(FATAL_ERROR "VCPKG_OPENCV_${cpu_option} must be a list of OpenCV CPU optimization names, not '${VCPKG_OPENCV_${cpu_option}}'.")
+    endif()
+    if(cpu_value MATCHES "(^|,)(NATIVE|DETECT)(,|\$)")
+      message(WARNING "VCPKG_OPENCV_${cpu_option}=${cpu_value} depends on the build machine, which is not part of the package ABI hash.")
+    endif()
+    if(NOT "intrinsics" IN_LIST FEATURES)
+      message(WARNING "Without the intrinsics feature, VCPKG_OPENCV_${cpu_option} only changes compiler flags and not the universal intrinsics code paths.")
+    endif()
+    message(STATUS "Using ${cpu_option}=${cpu_value}")
+    list(APPEND ADDITIONAL_BUILD_FLAGS "-D${cpu_option}=${cpu_value}")
+  endif()
+endforeach()
+
 vcpkg_cmake_configure(
     SOURCE_PATH "${SOURCE_PATH}"
     OPTIONS
@@ -13,7 +13,7 @@ vcpkg_from_github(
         fix-feature-sqlite3.patch
         fix-error-c3861.patch
         fix-InstallDataMysql.patch
-        pocosqlitecipher.patch
+        sqlite-compile-options.patch
 )
 
 file(REMOVE "${SOURCE_PATH}/Foundation/src/pcre.h")
@@ -23,18 +23,98 @@ file(REMOVE "${SOURCE_PATH}/cmake/FindPCRE.cmake")
 file(REMOVE "${SOURCE_PATH}/XML/src/expat_config.h")
 file(REMOVE "${SOURCE_PATH}/cmake/FindMySQL.cmake")
 
+# Compile-time settings of SQLite, which can be set in the triplet file. If any of them is set, the SQLite
+# bundled with Poco is compiled into DataSQLite with these settings instead of linking the sqlite3 port:
+# POCO_CIPHER_SQLITE_PAGE_SIZE: default page size (SQLITE_DEFAULT_PAGE_SIZE), a power of two from 512 to 65536
+# POCO_CIPHER_SQLITE_WAL_SYNCHRONOUS: default synchronous mode in WAL mode (SQLITE_DEFAULT_WAL_SYNCHRONOUS),
+#   OFF, NORMAL, FULL or EXTRA
+# POCO_CIPHER_SQLITE_MEMSTATUS: whether memory statistics are collected (SQLITE_DEFAULT_MEMSTATUS)
+# POCO_CIPHER_SQLITE_THREADSAFE: threading mode (SQLITE_THREADSAFE), 0 single-thread, 1 serialized, 2 multi-thread
+set(sqlite_options "")
+if("sqlite3" IN_LIST FEATURES)
+    # These need SQLCipher, which is not part of this port
+    foreach(variable IN ITEMS POCO_CIPHER_SQLCIPHER_KDF_ITER POCO_CIPHER_SQLCIPHER_CRYPTO)
+        if(DEFINED ${variable})
+            message(FATAL_ERROR "${variable} cannot be applied: the sqlite3 feature of ${PORT} builds SQLite, not SQLCipher")
+        endif()
+    endforeach()
+
+    set(sqlite_definitions "")
+    if(DEFINED POCO_CIPHER_SQLITE_PAGE_SIZE)
+        if(NOT POCO_CIPHER_SQLITE_PAGE_SIZE MATCHES "^(512|1024|2048|4096|8192|16384|32768|65536)$")
+            message(FATAL_ERROR "POCO_CIPHER_SQLITE_PAGE_SIZE must be a power of two from 512 to 65536, not '${POCO_CIPHER_SQLITE_PAGE_SIZE}'")
+        endif()
+        list(APPEND sqlite_definitions "SQLITE_DEFAULT_PAGE_SIZE=${POCO_CIPHER_SQLITE_PAGE_SIZE}")
+    endif()
+    if(DEFINED POCO_CIPHER_SQLITE_WAL_SYNCHRONOUS)
+        set(synchronous_modes OFF NORMAL FULL EXTRA)
+        string(TOUPPER "${POCO_CIPHER_SQLITE_WAL_SYNCHRONOUS}" synchronous_mode)
+        list(FIND synchronous_modes "${synchronous_mode}" synchronous_value)
+        if(synchronous_value EQUAL "-1")
+            message(FATAL_ERROR "POCO_CIPHER_SQLITE_WAL_SYNCHRONOUS must be OFF, NORMAL, FULL or EXTRA, not '${POCO_CIPHER_SQLITE_WAL_SYNCHRONOUS}'")
+        endif()
+        list(APPEND sqlite_definitions "SQLITE_DEFAULT_WAL_SYNCHRONOUS=${synchronous_value}")
+    endif()
+    if(DEFINED POCO_CIPHER_SQLITE_MEMSTATUS)
+        if(POCO_CIPHER_SQLITE_MEMSTATUS)
+            list(APPEND sqlite_definitions "SQLITE_DEFAULT_MEMSTATUS=1")
+        else()
+            list(APPEND sqlite_definitions "SQLITE_DEFAULT_MEMSTATUS=0")
+        endif()
+    endif()
+    if(DEFINED POCO_CIPHER_SQLITE_THREADSAFE)
+        if(NOT POCO_CIPHER_SQLITE_THREADSAFE MATCHES "^[012]$")
+            message(FATAL_ERROR "POCO_CIPHER_SQLITE_THREADSAFE must be 0, 1 or 2, not '${POCO_CIPHER_SQLITE_THREADSAFE}'")
+        endif()
+        list(APPEND sqlite_definitions "SQLITE_THREADSAFE=${POCO_CIPHER_SQLITE_THREADSAFE}")
+    endif()
+
+    if(NOT sqlite_definitions STREQUAL "")
+        # See sqlite-compile-options.patch; these definitions replace Poco's defaults for the bundled SQLite
+        if(NOT DEFINED POCO_CIPHER_SQLITE_THREADSAFE)
+            list(APPEND sqlite_definitions "SQLITE_THREADSAFE=1")
+        endif()
+        list(JOIN sqlite_definitions " " sqlite_definitions)
+        set(sqlite_options
+            -DPOCO_DATA_SQLITE_BUNDLED=ON
+            "-DPOCO_DATA_SQLITE_DEFINITIONS=${sqlite_definitions}"
+        )
+    endif()
+endif()
+
 # define Poco linkage type
 string(COMPARE EQUAL "${VCPKG_LIBRARY_LINKAGE}" "static" POCO_STATIC)
 string(COMPARE EQUAL "${VCPKG_CRT_LINKAGE}" "static" POCO_MT)
 
+# Every Poco component is a feature; components which are not requested are not built
 vcpkg_check_features(OUT_FEATURE_OPTIONS FEATURE_OPTIONS
     FEATURES
-        pdf         ENABLE_PDF
-        netssl      ENABLE_NETSSL
-        netssl      FORCE_OPENSSL 
-        netssl      ENABLE_CRYPTO
-        sqlite3     ENABLE_DATA_SQLITE
-        postgresql  ENABLE_DATA_POSTGRESQL
+        activerecord            ENABLE_ACTIVERECORD
+        activerecord-compiler   ENABLE_ACTIVERECORD_COMPILER
+        cppparser               ENABLE_CPPPARSER
+        crypto                  ENABLE_CRYPTO
+        data                    ENABLE_DATA
+        encodings               ENABLE_ENCODINGS
+        encodings-compiler      ENABLE_ENCODINGS_COMPILER
+        json                    ENABLE_JSON
+        jwt                     ENABLE_JWT
+        mongodb                 ENABLE_MONGODB
+        net                     ENABLE_NET
+        netssl                  ENABLE_NETSSL
+        netssl                  FORCE_OPENSSL
+        odbc                    ENABLE_DATA_ODBC
+        pagecompiler            ENABLE_PAGECOMPILER
+        pagecompiler            ENABLE_PAGECOMPILER_FILE2PAGE
+        pdf                     ENABLE_PDF
+        pocodoc                 ENABLE_POCODOC
+        postgresql              ENABLE_DATA_POSTGRESQL
+        prometheus              ENABLE_PROMETHEUS
+        redis                   ENABLE_REDIS
+        sevenzip                ENABLE_SEVENZIP
+        sqlite3                 ENABLE_DATA_SQLITE
+        util                    ENABLE_UTIL
+        xml                     ENABLE_XML
+        zip                     ENABLE_ZIP
 )
 
 if ("mysql" IN_LIST FEATURES OR "mariadb" IN_LIST FEATURES)
@@ -52,27 +132,17 @@ vcpkg_cmake_configure(
         -DPOCO_STATIC=${POCO_STATIC}
         -DPOCO_MT=${POCO_MT}
         -DENABLE_TESTS=OFF
-        # Allow enabling and disabling components
-        # POCO_ENABLE_SQL_ODBC, POCO_ENABLE_SQL_MYSQL and POCO_ENABLE_SQL_POSTGRESQL are
-        # defined on the fly if the required librairies are present
-        -DENABLE_ENCODINGS=ON
-        -DENABLE_ENCODINGS_COMPILER=ON
-        -DENABLE_XML=ON
-        -DENABLE_JSON=ON
-        -DENABLE_MONGODB=ON
-        # -DPOCO_ENABLE_SQL_SQLITE=ON # SQLITE are not supported.
-        -DENABLE_REDIS=ON
-        -DENABLE_UTIL=ON
-        -DENABLE_NET=ON
-        -DENABLE_SEVENZIP=ON
-        -DENABLE_ZIP=ON
-        -DENABLE_CPPPARSER=ON
-        -DENABLE_POCODOC=ON
-        -DENABLE_PAGECOMPILER=ON
-        -DENABLE_PAGECOMPILER_FILE2PAGE=ON
         -DPOCO_DISABLE_INTERNAL_OPENSSL=ON
         -DENABLE_APACHECONNECTOR=OFF
         -DENABLE_DATA_MYSQL=${POCO_USE_MYSQL}
+        ${sqlite_options}
+    MAYBE_UNUSED_VARIABLES
+        ENABLE_ACTIVERECORD_COMPILER
+        ENABLE_ENCODINGS_COMPILER
+        ENABLE_PAGECOMPILER
+        ENABLE_PAGECOMPILER_FILE2PAGE
+        ENABLE_POCODOC
+        FORCE_OPENSSL
 )
 
 vcpkg_cmake_install()
@@ -80,7 +150,22 @@ vcpkg_cmake_install()
 vcpkg_copy_pdbs()
 
 # Move apps to the tools folder
-vcpkg_copy_tools(TOOL_NAMES cpspc f2cpsp PocoDoc tec arc AUTO_CLEAN)
+set(tool_names "")
+if("pagecompiler" IN_LIST FEATURES)
+    list(APPEND tool_names cpspc f2cpsp)
+endif()
+if("pocodoc" IN_LIST FEATURES)
+    list(APPEND tool_names PocoDoc)
+endif()
+if("encodings-compiler" IN_LIST FEATURES)
+    list(APPEND tool_names tec)
+endif()
+if("activerecord-compiler" IN_LIST FEATURES)
+    list(APPEND tool_names arc)
+endif()
+if(tool_names)
+    vcpkg_copy_tools(TOOL_NAMES ${tool_names} AUTO_CLEAN)
+endif()
 
 # Copy additional include files not part of any libraries
 if(EXISTS "${CURRENT_PACKAGES_DIR}/include/Poco/SQL")
@@ -11,6 +11,8 @@ vcpkg_from_github(
         fix-arm64-msvc.patch
 )
 
+# protoc is only built for the host triplet. Other triplets build the libraries and use
+# the protoc of the host protobuf package, see vcpkg-cmake-wrapper.cmake.
 string(COMPARE EQUAL "${TARGET_TRIPLET}" "${HOST_TRIPLET}" protobuf_BUILD_PROTOC_BINARIES)
 string(COMPARE EQUAL "${VCPKG_LIBRARY_LINKAGE}" "dynamic" protobuf_BUILD_SHARED_LIBS)
 string(COMPARE EQUAL "${VCPKG_CRT_LINKAGE}" "static" protobuf_MSVC_STATIC_RUNTIME)
@@ -56,6 +58,9 @@ vcpkg_cmake_configure(
         -Dprotobuf_BUILD_LIBPROTOC=${protobuf_BUILD_LIBPROTOC}
         -Dprotobuf_ABSL_PROVIDER=package
         ${FEATURE_OPTIONS}
+    OPTIONS_DEBUG
+        # Only the release protoc is installed as a tool
+        -Dprotobuf_BUILD_PROTOC_BINARIES=OFF
 )
 
 vcpkg_cmake_install()
@@ -69,8 +74,6 @@ if(protobuf_BUILD_PROTOC_BINARIES)
         list(GET VERSION_LIST 2 VERSION_PATCH)
         vcpkg_copy_tools(TOOL_NAMES protoc protoc-${VERSION_MINOR}.${VERSION_PATCH}.0 AUTO_CLEAN)
     endif()
-else()
-    file(COPY "${CURRENT_HOST_INSTALLED_DIR}/tools/${PORT}" DESTINATION "${CURRENT_PACKAGES_DIR}/tools")
 endif()
 
 vcpkg_replace_string("${CURRENT_PACKAGES_DIR}/share/${PORT}/protobuf-config.cmake"
@@ -6,6 +6,7 @@ function(boost_configure_and_install)
   string(REPLACE "-" "_" boost_lib_name "${PORT}")
   string(REPLACE "boost_" "" boost_lib_name "${boost_lib_name}")
   set(boost_lib_name_config "${boost_lib_name}")
+  set(boost_lib_super_build_name "${boost_lib_name}")
 
   set(headers_only OFF)
   if(NOT EXISTS "${arg_SOURCE_PATH}/src" OR Z_VCPKG_BOOST_FORCE_HEADER_ONLY) # regex|system|math are header only and only install libs due to compat
@@ -31,7 +32,18 @@ function(boost_configure_and_install)
     file(RENAME "${arg_SOURCE_PATH}.tmp/" "${target_path}")
   endif()
 
-  file(WRITE "${arg_SOURCE_PATH}/CMakeLists.txt" " \
+  set(installed_from_super_build OFF)
+  if(VCPKG_BOOST_SUPER_BUILD)
+    z_vcpkg_boost_super_build_install(installed_from_super_build
+      LIBRARY "${boost_lib_super_build_name}"
+      SOURCE_PATH "${arg_SOURCE_PATH}"
+      HEADERS_ONLY "${headers_only}"
+      OPTIONS ${arg_OPTIONS}
+    )
+  endif()
+
+  if(NOT installed_from_super_build)
+    file(WRITE "${arg_SOURCE_PATH}/CMakeLists.txt" " \
   cmake_minimum_required(VERSION 3.25) \n\
  \n\
   project(Boost VERSION ${VERSION} LANGUAGES CXX) \n\
@@ -44,25 +56,26 @@ function(boost_configure_and_install)
   include(BoostRoot) \n\
   ")
 
-  if("${PORT}" MATCHES "boost-(mpi|graph-parallel|property-map-parallel)")
-    list(APPEND arg_OPTIONS -DBOOST_ENABLE_MPI=ON)
-  endif()
+    if("${PORT}" MATCHES "boost-(mpi|graph-parallel|property-map-parallel)")
+      list(APPEND arg_OPTIONS -DBOOST_ENABLE_MPI=ON)
+    endif()
 
-  if("${PORT}" MATCHES "boost-(python|parameter-python)")
-    list(APPEND arg_OPTIONS -DBOOST_ENABLE_PYTHON=ON)
-  endif()
+    if("${PORT}" MATCHES "boost-(python|parameter-python)")
+      list(APPEND arg_OPTIONS -DBOOST_ENABLE_PYTHON=ON)
+    endif()
 
-  vcpkg_cmake_configure(
-    SOURCE_PATH "${arg_SOURCE_PATH}"
-    OPTIONS
-      -DBOOST_INCLUDE_LIBRARIES=${boost_lib_name}
-      -DBOOST_RUNTIME_LINK=${VCPKG_CRT_LINKAGE}
-      "-DBOOST_INSTALL_INCLUDE_SUBDIR="
-      "-DCMAKE_MSVC_DEBUG_INFORMATION_FORMAT="
-      ${arg_OPTIONS}
-  )
+    vcpkg_cmake_configure(
+      SOURCE_PATH "${arg_SOURCE_PATH}"
+      OPTIONS
+        -DBOOST_INCLUDE_LIBRARIES=${boost_lib_name}
+        -DBOOST_RUNTIME_LINK=${VCPKG_CRT_LINKAGE}
+        "-DBOOST_INSTALL_INCLUDE_SUBDIR="
+        "-DCMAKE_MSVC_DEBUG_INFORMATION_FORMAT="
+        ${arg_OPTIONS}
+    )
 
-  vcpkg_cmake_install()
+    vcpkg_cmake_install()
+  endif()
 
   file(GLOB cmake_paths "${CURRENT_PACKAGES_DIR}/lib/cmake/*" LIST_DIRECTORIES true)
   file(GLOB cmake_files "${CURRENT_PACKAGES_DIR}/lib/cmake/*" LIST_DIRECTORIES false)
@@ -0,0 +1,375 @@
+include_guard(GLOBAL)
+
+# Opt-in super-build of the boost libraries, enabled by setting VCPKG_BOOST_SUPER_BUILD in the triplet.
+# The boost libraries of a triplet are configured and built together in one tree,
+# buildtrees/boost-super-build/<triplet>-<key>, which records the install rules of every library
+# in a component of its own. Each port installs its component from this tree into its package
+# instead of running its own configure and build. A port whose sources or options differ from
+# the super-build falls back to building on its own.
+# By default, each port adds the closure of its own library to the tree, so that the tree grows to
+# the closure of the ports being installed; libraries which are already built are not built again.
+# VCPKG_BOOST_SUPER_BUILD_LIBRARIES instead builds the closure of the given libraries at once,
+# in parallel, with the first boost port; other libraries are then built on their own.
+
+# Evaluates the platform expression `expression` for the target triplet
+function(z_vcpkg_boost_platform_supported out_var expression)
+  set("${out_var}" ON PARENT_SCOPE)
+  if(expression STREQUAL "")
+    return()
+  endif()
+  set(identifiers windows uwp mingw linux osx ios android emscripten freebsd openbsd)
+  string(REGEX REPLACE "([()!&|,])" " \\1 " expression "${expression}")
+  separate_arguments(tokens UNIX_COMMAND "${expression}")
+  set(condition "")
+  foreach(token IN LISTS tokens)
+    if(token STREQUAL "!")
+      list(APPEND condition NOT)
+    elseif(token STREQUAL "&")
+      list(APPEND condition AND)
+    elseif(token MATCHES "^[|,]\$")
+      list(APPEND condition OR)
+    elseif(token MATCHES "^[()]\$")
+      list(APPEND condition "${token}")
+    elseif(token IN_LIST identifiers)
+      string(TOUPPER "${token}" token)
+      if(VCPKG_TARGET_IS_${token})
+        list(APPEND condition TRUE)
+      else()
+        list(APPEND condition FALSE)
+      endif()
+    elseif(token MATCHES "^(x86|x64|arm64|wasm32)\$")
+      if(VCPKG_TARGET_ARCHITECTURE STREQUAL token)
+        list(APPEND condition TRUE)
+      else()
+        list(APPEND condition FALSE)
+      endif()
+    elseif(token STREQUAL "arm")
+      if(VCPKG_TARGET_ARCHITECTURE MATCHES "^arm")
+        list(APPEND condition TRUE)
+      else()
+        list(APPEND condition FALSE)
+      endif()
+    elseif(token STREQUAL "static")
+      if(VCPKG_LIBRARY_LINKAGE STREQUAL "static")
+        list(APPEND condition TRUE)
+      else()
+        list(APPEND condition FALSE)
+      endif()
+    elseif(token STREQUAL "staticcrt")
+      if(VCPKG_CRT_LINKAGE STREQUAL "static")
+        list(APPEND condition TRUE)
+      else()
+        list(APPEND condition FALSE)
+      endif()
+    elseif(token STREQUAL "native")
+      if(TARGET_TRIPLET STREQUAL HOST_TRIPLET)
+        list(APPEND condition TRUE)
+      else()
+        list(APPEND condition FALSE)
+      endif()
+    else()
+      # Unknown identifiers are not evaluated; such libraries are built on their own
+      set("${out_var}" OFF PARENT_SCOPE)
+      return()
+    endif()
+  endforeach()
+  if(NOT (${condition}))
+    set("${out_var}" OFF PARENT_SCOPE)
+  endif()
+endfunction()
+
+# Path of `library` below libs/ in a boost tree
+function(z_vcpkg_boost_library_path out_var library)
+  if(library MATCHES "^numeric_(.+)\$")
+    set(library "numeric/${CMAKE_MATCH_1}")
+  elseif(library MATCHES "^(ublas|odeint|interval)\$")
+    set(library "numeric/${library}")
+  endif()
+  set("${out_var}" "${library}" PARENT_SCOPE)
+endfunction()
+
+# Libraries of the super-build which `port_library` needs: the closure of VCPKG_BOOST_SUPER_BUILD_LIBRARIES,
+# or else of `port_library`. Only libraries without external dependencies, features which change their
+# build, or support limitations excluding the triplet, whose dependencies can be built together
+# with them, are part of it. Expects the library table of boost-cmake.
+function(z_vcpkg_boost_super_build_libraries out_var port_library)
+  set(candidates "")
+  foreach(library IN LISTS BOOST_LIBRARIES)
+    if(BOOST_LIBRARY_${library}_EXTERNAL OR BOOST_LIBRARY_${library}_EXCLUDED)
+      continue()
+    endif()
+    z_vcpkg_boost_platform_supported(supported "${BOOST_LIBRARY_${library}_SUPPORTS}")
+    if(supported)
+      list(APPEND candidates "${library}")
+    endif()
+  endforeach()
+
+  set(changed ON)
+  while(changed)
+    set(changed OFF)
+    foreach(library IN LISTS candidates)
+      foreach(dependency IN LISTS BOOST_LIBRARY_${library}_DEPENDENCIES)
+        if(NOT dependency IN_LIST candidates)
+          list(REMOVE_ITEM candidates "${library}")
+          set(changed ON)
+          break()
+        endif()
+      endforeach()
+    endforeach()
+  endwhile()
+
+  set(libraries "")
+  if(DEFINED VCPKG_BOOST_SUPER_BUILD_LIBRARIES)
+    set(pending ${VCPKG_BOOST_SUPER_BUILD_LIBRARIES})
+  else()
+    set(pending "${port_library}")
+  endif()
+  while(NOT pending STREQUAL "")
+    list(POP_FRONT pending library)
+    if(library IN_LIST candidates AND NOT library IN_LIST libraries)
+      list(APPEND libraries "${library}")
+      list(APPEND pending ${BOOST_LIBRARY_${library}_DEPENDENCIES})
+    endif()
+  endwhile()
+  list(SORT libraries)
+  set("${out_var}" "${libraries}" PARENT_SCOPE)
+endfunction()
+
+# Adds `libraries` to the super-build tree and builds it unless they were built already.
+# Sets out_dir to the super-build tree, or to "" if it cannot be created.
+function(z_vcpkg_boost_super_build out_dir libraries)
+  set("${out_dir}" "" PARENT_SCOPE)
+  set(table "${CURRENT_INSTALLED_DIR}/share/boost-cmake/boost-libraries.cmake")
+  file(SHA512 "${table}" table_hash)
+  file(SHA512 "${CMAKE_CURRENT_FUNCTION_LIST_FILE}" super_build_hash)
+  # Not keyed on the libraries: the tree of a triplet grows with the ports being installed
+  set(key_data "${VERSION};${TARGET_TRIPLET};${VCPKG_BUILD_TYPE};${VCPKG_CRT_LINKAGE};${VCPKG_LIBRARY_LINKAGE};${table_hash};${super_build_hash}")
+  foreach(file IN ITEMS "${TARGET_TRIPLET_FILE}" "${CURRENT_INSTALLED_DIR}/share/boost-cmake/vcpkg_abi_info.txt")
+    if(EXISTS "${file}")
+      file(SHA512 "${file}" file_hash)
+      string(APPEND key_data ";${file_hash}")
+    endif()
+  endforeach()
+  # The compiler which builds the tree, including the toolchain which selects it
+  vcpkg_cmake_get_vars(cmake_vars_file)
+  include("${cmake_vars_file}")
+  string(APPEND key_data ";${VCPKG_DETECTED_CMAKE_CXX_COMPILER};${VCPKG_DETECTED_CMAKE_CXX_COMPILER_ID};${VCPKG_DETECTED_CMAKE_CXX_COMPILER_VERSION};${VCPKG_CHAINLOAD_TOOLCHAIN_FILE}")
+  if(EXISTS "${VCPKG_CHAINLOAD_TOOLCHAIN_FILE}")
+    file(SHA512 "${VCPKG_CHAINLOAD_TOOLCHAIN_FILE}" toolchain_hash)
+    string(APPEND key_data ";${toolchain_hash}")
+  endif()
+  string(SHA512 key "${key_data}")
+  string(SUBSTRING "${key}" 0 16 key)
+
+  set(super_build_root "${BUILDTREES_DIR}/boost-super-build")
+  set(super_dir "${super_build_root}/${TARGET_TRIPLET}-${key}")
+  file(MAKE_DIRECTORY "${super_build_root}")
+  file(LOCK "${super_dir}.lock" GUARD FUNCTION)
+  set(built_libraries "")
+  if(EXISTS "${super_dir}/build.stamp")
+    file(STRINGS "${super_dir}/libraries.txt" built_libraries)
+    set(missing_libraries ${libraries})
+    list(REMOVE_ITEM missing_libraries ${built_libraries})
+    if(missing_libraries STREQUAL "")
+      set("${out_dir}" "${super_dir}" PARENT_SCOPE)
+      return()
+    endif()
+  else()
+    # Trees of earlier configurations of this triplet are not used any more
+    file(GLOB stale_dirs LIST_DIRECTORIES true RELATIVE "${super_build_root}" "${super_build_root}/${TARGET_TRIPLET}-*")
+    # Only the trees of this triplet, not of triplets named like <triplet>-<suffix>
+    string(REPEAT "[0-9a-f]" 16 key_regex)
+    list(FILTER stale_dirs INCLUDE REGEX "^${TARGET_TRIPLET}-${key_regex}$")
+    foreach(stale_dir IN LISTS stale_dirs)
+      set(stale_dir "${super_build_root}/${stale_dir}")
+      if(IS_DIRECTORY "${stale_dir}" AND NOT stale_dir STREQUAL super_dir)
+        file(REMOVE_RECURSE "${stale_dir}")
+      endif()
+    endforeach()
+    file(REMOVE_RECURSE "${super_dir}")
+    set(missing_libraries ${libraries})
+  endif()
+  # If this fails, the next port creates the tree anew
+  file(REMOVE "${super_dir}/build.stamp")
+
+  list(LENGTH missing_libraries libraries_count)
+  message(STATUS "Adding ${libraries_count} boost libraries to the super-build ${super_dir}")
+
+  set(sources "")
+  foreach(library IN LISTS missing_libraries)
+    z_vcpkg_boost_library_path(library_path "${library}")
+
+    string(REPLACE "_" "-" port_dir "boost-${library}")
+    set(patches "")
+    foreach(patch IN LISTS BOOST_LIBRARY_${library}_PATCHES)
+      set(patch "${CURRENT_PORT_DIR}/../${port_dir}/${patch}")
+      if(NOT EXISTS "${patch}")
+        message(STATUS "Patch ${patch} not found, building ${PORT} without the boost super-build")
+        return()
+      endif()
+      list(APPEND patches "${patch}")
+    endforeach()
+
+    # Named like the downloads of vcpkg_from_github, so the ports find them in the cache
+    vcpkg_download_distfile(archive
+      URLS "https://github.com/boostorg/${library}/archive/boost-${VERSION}.tar.gz"
+      FILENAME "boostorg-${library}-boost-${VERSION}.tar.gz"
+      SHA512 "${BOOST_LIBRARY_${library}_SHA512}"
+    )
+    vcpkg_extract_source_archive(source_path
+      ARCHIVE "${archive}"
+      SOURCE_BASE "boost-${VERSION}"
+      WORKING_DIRECTORY "${super_dir}/sources/${library}"
+      PATCHES ${patches}
+    )
+    cmake_path(GET source_path FILENAME source_name)
+    string(APPEND sources "${library}=${source_name}\n")
+    set(target_path "${super_dir}/src/libs/${library_path}")
+    cmake_path(GET target_path PARENT_PATH parent_path)
+    file(MAKE_DIRECTORY "${parent_path}")
+    file(RENAME "${source_path}" "${target_path}")
+  endforeach()
+  file(REMOVE_RECURSE "${super_dir}/sources")
+  file(APPEND "${super_dir}/sources.txt" "${sources}")
+
+  set(libraries ${built_libraries} ${missing_libraries})
+  list(SORT libraries)
+  set(library_paths "")
+  set(library_options "")
+  foreach(library IN LISTS libraries)
+    z_vcpkg_boost_library_path(library_path "${library}")
+    list(APPEND library_paths "${library_path}")
+    list(APPEND library_options ${BOOST_LIBRARY_${library}_OPTIONS})
+  endforeach()
+  list(JOIN library_paths ";" include_libraries)
+  # FORCE, so that a reconfiguration of the tree picks up the added libraries
+  file(WRITE "${super_dir}/libraries.cmake" "set(BOOST_INCLUDE_LIBRARIES \"${include_libraries}\" CACHE STRING \"\" FORCE)\n")
+
+  # The install rules of each library are recorded in a component named after it
+  file(WRITE "${super_dir}/src/CMakeLists.txt" "\
+cmake_minimum_required(VERSION 3.25)
+
+project(Boost VERSION ${VERSION} LANGUAGES CXX)
+
+set(BOOST_SUPERPROJECT_VERSION \${PROJECT_VERSION})
+set(BOOST_SUPERPROJECT_SOURCE_DIR \"\${PROJECT_SOURCE_DIR}\")
+
+list(APPEND CMAKE_MODULE_PATH \"${CURRENT_INSTALLED_DIR}/share/boost/cmake-build\")
+
+macro(add_subdirectory z_vcpkg_source_dir)
+  if(CMAKE_CURRENT_SOURCE_DIR STREQUAL PROJECT_SOURCE_DIR)
+    set(z_vcpkg_library \"\${z_vcpkg_source_dir}\")
+    cmake_path(ABSOLUTE_PATH z_vcpkg_library BASE_DIRECTORY \"\${PROJECT_SOURCE_DIR}\" NORMALIZE)
+    cmake_path(RELATIVE_PATH z_vcpkg_library BASE_DIRECTORY \"\${PROJECT_SOURCE_DIR}\")
+    if(z_vcpkg_library MATCHES \"^libs/(.+)\$\")
+      string(MAKE_C_IDENTIFIER \"\${CMAKE_MATCH_1}\" CMAKE_INSTALL_DEFAULT_COMPONENT_NAME)
+    endif()
+  endif()
+  _add_subdirectory(\${ARGV})
+endmacro()
+
+include(BoostRoot)
+")
+  # Dependencies are targets of the super-build, not installed packages
+  file(WRITE "${super_dir}/boost-config/BoostConfig.cmake" "# Boost libraries are provided by the super-build\n")
+
+  block(SCOPE_FOR VARIABLES)
+    set(CURRENT_BUILDTREES_DIR "${super_dir}")
+    set(CURRENT_PACKAGES_DIR "${super_dir}/install")
+    if(NOT built_libraries STREQUAL "")
+      # vcpkg_cmake_configure would start the build trees anew, so they are reconfigured in place
+      # and only the added libraries are built.
+      foreach(suffix IN ITEMS rel dbg)
+        if(EXISTS "${super_dir}/${TARGET_TRIPLET}-${suffix}/CMakeCache.txt")
+          file(STRINGS "${super_dir}/${TARGET_TRIPLET}-${suffix}/CMakeCache.txt" generator REGEX "^CMAKE_GENERATOR:INTERNAL=")
+          string(REGEX REPLACE "^[^=]*=" "" generator "${generator}")
+          set(Z_VCPKG_CMAKE_GENERATOR "${generator}" CACHE INTERNAL "The generator which was used to configure CMake.")
+          vcpkg_execute_required_process(
+            COMMAND "${CMAKE_COMMAND}" "-C${super_dir}/libraries.cmake" ${library_options} .
+            WORKING_DIRECTORY "${super_dir}/${TARGET_TRIPLET}-${suffix}"
+            LOGNAME "config-boost-super-build-${TARGET_TRIPLET}-${suffix}"
+          )
+        endif()
+      endforeach()
+    else()
+      vcpkg_cmake_configure(
+        SOURCE_PATH "${super_dir}/src"
+        LOGFILE_BASE config-boost-super-build
+        OPTIONS
+          "-C${super_dir}/libraries.cmake"
+          -DBOOST_RUNTIME_LINK=${VCPKG_CRT_LINKAGE}
+          "-DBOOST_INSTALL_INCLUDE_SUBDIR="
+          "-DCMAKE_MSVC_DEBUG_INFORMATION_FORMAT="
+          "-DBoost_DIR=${super_dir}/boost-config"
+          ${library_options}
+        MAYBE_UNUSED_VARIABLES
+          Boost_DIR
+      )
+    endif()
+    vcpkg_cmake_build(LOGFILE_BASE build-boost-super-build)
+  endblock()
+  # The port may still configure its own build
+  unset(Z_VCPKG_CMAKE_GENERATOR CACHE)
+
+  list(JOIN libraries "\n" libraries)
+  file(WRITE "${super_dir}/libraries.txt" "${libraries}\n")
+  file(TOUCH "${super_dir}/build.stamp")
+  set("${out_dir}" "${super_dir}" PARENT_SCOPE)
+endfunction()
+
+# Installs `LIBRARY` from the super-build into the package if it is part of it and was built
+# from the same sources and options as the port. Sets out_var to ON if it was installed.
+function(z_vcpkg_boost_super_build_install out_var)
+  cmake_parse_arguments(PARSE_ARGV 1 "arg" "" "LIBRARY;SOURCE_PATH;HEADERS_ONLY" "OPTIONS")
+  set("${out_var}" OFF PARENT_SCOPE)
+
+  set(table "${CURRENT_INSTALLED_DIR}/share/boost-cmake/boost-libraries.cmake")
+  if(VCPKG_USE_HEAD_VERSION OR NOT EXISTS "${table}")
+    return()
+  endif()
+  include("${table}")
+  z_vcpkg_boost_super_build_libraries(libraries "${arg_LIBRARY}")
+  if(NOT arg_LIBRARY IN_LIST libraries)
+    return()
+  endif()
+  set(options ${arg_OPTIONS})
+  set(super_build_options ${BOOST_LIBRARY_${arg_LIBRARY}_OPTIONS})
+  list(SORT options)
+  list(SORT super_build_options)
+  if(NOT options STREQUAL super_build_options)
+    message(STATUS "The options of ${PORT} differ from the boost super-build, building it on its own")
+    return()
+  endif()
+
+  z_vcpkg_boost_super_build(super_dir "${libraries}")
+  if(super_dir STREQUAL "")
+    return()
+  endif()
+  file(STRINGS "${super_dir}/sources.txt" sources REGEX "^${arg_LIBRARY}=")
+  cmake_path(GET arg_SOURCE_PATH FILENAME source_name)
+  if(NOT sources STREQUAL "${arg_LIBRARY}=${source_name}")
+    message(STATUS "The sources of ${PORT} differ from the boost super-build, building it on its own")
+    return()
+  endif()
+
+  z_vcpkg_boost_library_path(library_path "${arg_LIBRARY}")
+  string(MAKE_C_IDENTIFIER "${library_path}" component)
+  set(build_types "")
+  if(NOT DEFINED VCPKG_BUILD_TYPE OR VCPKG_BUILD_TYPE STREQUAL "release")
+    list(APPEND build_types "rel;Release;${CURRENT_PACKAGES_DIR}")
+  endif()
+  if(NOT arg_HEADERS_ONLY AND (NOT DEFINED VCPKG_BUILD_TYPE OR VCPKG_BUILD_TYPE STREQUAL "debug"))
+    list(APPEND build_types "dbg;Debug;${CURRENT_PACKAGES_DIR}/debug")
+  endif()
+  message(STATUS "Installing ${arg_LIBRARY} from the boost super-build")
+  while(NOT build_types STREQUAL "")
+    list(POP_FRONT build_types suffix config prefix)
+    vcpkg_execute_required_process(
+      COMMAND "${CMAKE_COMMAND}" --install "${super_dir}/${TARGET_TRIPLET}-${suffix}"
+        --config "${config}" --component "${component}" --prefix "${prefix}"
+      WORKING_DIRECTORY "${super_dir}"
+      LOGNAME "install-${TARGET_TRIPLET}-${suffix}"
+    )
+  endwhile()
+  set("${out_var}" ON PARENT_SCOPE)
+endfunction()
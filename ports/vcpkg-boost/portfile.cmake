@@ -1,6 +1,7 @@
 file(INSTALL
     "${CMAKE_CURRENT_LIST_DIR}/usage.in"
     "${CMAKE_CURRENT_LIST_DIR}/boost-install.cmake"
+    "${CMAKE_CURRENT_LIST_DIR}/boost-super-build.cmake"
     "${CMAKE_CURRENT_LIST_DIR}/vcpkg-port-config.cmake"
     DESTINATION "${CURRENT_PACKAGES_DIR}/share/${PORT}")
 
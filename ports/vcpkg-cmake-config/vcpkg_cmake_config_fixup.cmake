@@ -16,6 +16,7 @@ function(vcpkg_cmake_config_fixup)
         set(arg_TOOLS_PATH "tools/${PORT}")
     endif()
     set(target_path "share/${arg_PACKAGE_NAME}")
+    z_vcpkg_trace_begin(trace)
 
     string(REPLACE "." "\\." EXECUTABLE_SUFFIX "${VCPKG_TARGET_EXECUTABLE_SUFFIX}")
 
@@ -223,6 +224,7 @@ get_filename_component(_IMPORT_PREFIX "${_IMPORT_PREFIX}" PATH)]]
     if(remaining_files STREQUAL "")
         file(REMOVE_RECURSE "${CURRENT_PACKAGES_DIR}/debug/share")
     endif()
+    z_vcpkg_trace_end("${trace}" NAME "fixup ${arg_PACKAGE_NAME}" CATEGORY fixup)
 endfunction()
 
 # Match a command from "<needle>" to ")\n". On match, returns the command and
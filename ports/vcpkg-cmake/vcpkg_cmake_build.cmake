@@ -1,5 +1,161 @@
 include_guard(GLOBAL)
 
+function(z_vcpkg_cmake_build_shell_quote out_var arg)
+    string(REPLACE "'" "'\\''" arg "${arg}")
+    string(REPLACE "$" "$$" arg "${arg}")
+    set("${out_var}" "'${arg}'" PARENT_SCOPE)
+endfunction()
+
+# Finds a GNU make which can serve as jobserver for the build tool of `generator`.
+# Ninja only joins fifo jobservers (ninja 1.13, GNU make 4.4); make also joins pipe jobservers.
+# vcpkg acquires ninja 1.10.2, so Ninja builds only take part with a newer ninja from the system
+# (VCPKG_FORCE_SYSTEM_BINARIES); Unix Makefiles builds always can.
+function(z_vcpkg_cmake_build_find_jobserver out_make out_make_args generator build_dir)
+    set("${out_make}" "" PARENT_SCOPE)
+    if(CMAKE_HOST_WIN32 OR X_VCPKG_NO_CONCURRENT_CONFIGS)
+        return()
+    endif()
+    find_program(Z_VCPKG_CMAKE_BUILD_GNU_MAKE NAMES gmake make)
+    if(NOT Z_VCPKG_CMAKE_BUILD_GNU_MAKE)
+        return()
+    endif()
+    execute_process(
+        COMMAND "${Z_VCPKG_CMAKE_BUILD_GNU_MAKE}" --version
+        OUTPUT_VARIABLE make_version
+        ERROR_QUIET
+    )
+    if(NOT make_version MATCHES "^GNU Make ([0-9]+\\.[0-9]+)")
+        return()
+    endif()
+    set(make_version "${CMAKE_MATCH_1}")
+
+    if(generator STREQUAL "Ninja")
+        if(make_version VERSION_LESS "4.4")
+            return()
+        endif()
+        file(STRINGS "${build_dir}/CMakeCache.txt" ninja REGEX "^CMAKE_MAKE_PROGRAM:[^=]*=")
+        string(REGEX REPLACE "^[^=]*=" "" ninja "${ninja}")
+        execute_process(
+            COMMAND "${ninja}" --version
+            OUTPUT_VARIABLE ninja_version
+            OUTPUT_STRIP_TRAILING_WHITESPACE
+            ERROR_QUIET
+        )
+        if(NOT ninja_version MATCHES "^[0-9]+\\.[0-9]+" OR ninja_version VERSION_LESS "1.13")
+            return()
+        endif()
+        set(make_args "--jobserver-style=fifo")
+    elseif(generator STREQUAL "Unix Makefiles")
+        set(make_args "")
+    else()
+        return()
+    endif()
+    set("${out_make}" "${Z_VCPKG_CMAKE_BUILD_GNU_MAKE}" PARENT_SCOPE)
+    set("${out_make_args}" "${make_args}" PARENT_SCOPE)
+endfunction()
+
+# Builds all configurations at once under a GNU make jobserver of VCPKG_CONCURRENCY jobs.
+# Each configuration runs `command` without a job count, so the build tools share the
+# jobserver's tokens. make runs like any other build of vcpkg_execute_build_process: under the
+# build governor, traced, and with a throttle remembered for the next builds. Sets out_failed to
+# the build types which did not build successfully; their logs are kept for the message.
+function(z_vcpkg_cmake_build_concurrently out_failed make make_args logfile_base build_types)
+    set(run_dir "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-concurrent-${logfile_base}")
+    file(REMOVE_RECURSE "${run_dir}")
+    file(MAKE_DIRECTORY "${run_dir}")
+
+    list(JOIN build_types " " targets)
+    set(makefile "all: ${targets}\n.PHONY: all ${targets}\n")
+    foreach(build_type IN LISTS build_types)
+        set(recipe "")
+        foreach(arg IN ITEMS
+            "${CMAKE_COMMAND}"
+            "-DZ_VCPKG_CMAKE_BUILD_COMMAND=${Z_VCPKG_CMAKE_BUILD_COMMAND_${build_type}}"
+            "-DZ_VCPKG_CMAKE_BUILD_WORKING_DIRECTORY=${Z_VCPKG_CMAKE_BUILD_DIR_${build_type}}"
+            "-DZ_VCPKG_CMAKE_BUILD_LOG=${CURRENT_BUILDTREES_DIR}/${Z_VCPKG_CMAKE_BUILD_LOGNAME_${build_type}}"
+            "-DZ_VCPKG_CMAKE_BUILD_STATUS=${run_dir}/${build_type}.status"
+            -P "${CMAKE_CURRENT_FUNCTION_LIST_FILE}"
+        )
+            z_vcpkg_cmake_build_shell_quote(arg "${arg}")
+            string(APPEND recipe " ${arg}")
+        endforeach()
+        # `+` hands the jobserver to the recipe
+        string(APPEND makefile "${build_type}:\n\t+@${recipe}\n")
+        z_vcpkg_trace_ninja_log_length(ninja_log_length_${build_type} "${Z_VCPKG_CMAKE_BUILD_DIR_${build_type}}/.ninja_log")
+    endforeach()
+    file(WRITE "${run_dir}/Makefile" "${makefile}")
+
+    if(logfile_base STREQUAL "install")
+        set(trace_category install)
+    else()
+        set(trace_category build)
+    endif()
+    z_vcpkg_trace_begin(trace)
+    z_vcpkg_execute_build_process_run(error_code governor_summary
+        "${run_dir}" "${run_dir}/make-out.log" "${run_dir}/make-err.log"
+        "${make}" -j${VCPKG_CONCURRENCY} ${make_args} -f Makefile)
+    set(peak_rss_mib "")
+    if(governor_summary MATCHES "peak_rss_mib=([0-9]+)")
+        set(peak_rss_mib "${CMAKE_MATCH_1}")
+    endif()
+    z_vcpkg_trace_end("${trace}" NAME "${logfile_base}-${TARGET_TRIPLET}" CATEGORY "${trace_category}" PEAK_RSS_MIB "${peak_rss_mib}"
+        ARGS jobs "${VCPKG_CONCURRENCY}" exit_code "${error_code}" concurrent ON)
+    foreach(build_type IN LISTS build_types)
+        z_vcpkg_trace_ninja_log("${trace}" "${Z_VCPKG_CMAKE_BUILD_DIR_${build_type}}/.ninja_log" "${ninja_log_length_${build_type}}")
+    endforeach()
+
+    # The jobserver cannot be limited per configuration, so a throttled run leaves the remembered
+    # concurrency to the sequential builds, which start again from there.
+    if(governor_summary MATCHES "max_stopped=([1-9][0-9]*)")
+        math(EXPR safe_jobs "${VCPKG_CONCURRENCY} - ${CMAKE_MATCH_1}")
+        if(safe_jobs LESS "1")
+            set(safe_jobs 1)
+        endif()
+        message(STATUS "Build was throttled due to memory pressure, using ${safe_jobs} jobs in the future")
+        foreach(build_type IN LISTS build_types)
+            file(WRITE "${DOWNLOADS}/tools/build-concurrency/${TARGET_TRIPLET}/${PORT}/${Z_VCPKG_CMAKE_BUILD_LOGNAME_${build_type}}.txt" "${safe_jobs}\n")
+        endforeach()
+    endif()
+
+    set(failed "")
+    foreach(build_type IN LISTS build_types)
+        set(status "")
+        if(EXISTS "${run_dir}/${build_type}.status")
+            file(READ "${run_dir}/${build_type}.status" status)
+        endif()
+        if(NOT status STREQUAL "0")
+            list(APPEND failed "${build_type}")
+            # The build which follows writes the same logs
+            set(stringified_logs "")
+            foreach(suffix IN ITEMS out err)
+                set(log "${CURRENT_BUILDTREES_DIR}/${Z_VCPKG_CMAKE_BUILD_LOGNAME_${build_type}}-${suffix}.log")
+                if(EXISTS "${log}")
+                    file(RENAME "${log}" "${run_dir}/${Z_VCPKG_CMAKE_BUILD_LOGNAME_${build_type}}-${suffix}.log")
+                endif()
+            endforeach()
+            foreach(log IN ITEMS
+                "${run_dir}/${Z_VCPKG_CMAKE_BUILD_LOGNAME_${build_type}}-out.log"
+                "${run_dir}/${Z_VCPKG_CMAKE_BUILD_LOGNAME_${build_type}}-err.log"
+                "${run_dir}/make-out.log"
+                "${run_dir}/make-err.log"
+            )
+                if(EXISTS "${log}")
+                    file(SIZE "${log}" log_size)
+                    if(NOT log_size EQUAL "0")
+                        file(TO_NATIVE_PATH "${log}" native_log)
+                        string(APPEND stringified_logs "    ${native_log}\n")
+                    endif()
+                endif()
+            endforeach()
+            message(STATUS "Concurrent ${build_type} build failed, building it again. See logs for more information:\n${stringified_logs}")
+        endif()
+    endforeach()
+    if(failed STREQUAL "")
+        file(REMOVE_RECURSE "${run_dir}")
+    endif()
+    set("${out_failed}" "${failed}" PARENT_SCOPE)
+endfunction()
+
 function(vcpkg_cmake_build)
     cmake_parse_arguments(PARSE_ARGV 0 "arg" "DISABLE_PARALLEL;ADD_BIN_TO_PATH" "TARGET;LOGFILE_BASE" "")
 
@@ -41,8 +197,47 @@ function(vcpkg_cmake_build)
         vcpkg_list(SET target_param "--target" "${arg_TARGET}")
     endif()
 
+    vcpkg_list(SET build_types)
     foreach(build_type IN ITEMS debug release)
         if(NOT DEFINED VCPKG_BUILD_TYPE OR "${VCPKG_BUILD_TYPE}" STREQUAL "${build_type}")
+            vcpkg_list(APPEND build_types "${build_type}")
+        endif()
+    endforeach()
+
+    # Both configurations share one jobserver, so the serial tail of one overlaps with the other.
+    # Configurations which fail are built again below, with the usual retries and logs.
+    list(LENGTH build_types number_of_build_types)
+    if(number_of_build_types EQUAL "2" AND NOT arg_DISABLE_PARALLEL AND NOT arg_ADD_BIN_TO_PATH)
+        z_vcpkg_cmake_build_find_jobserver(make make_args "${Z_VCPKG_CMAKE_GENERATOR}"
+            "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-rel")
+        foreach(build_type IN LISTS build_types)
+            if(build_type STREQUAL "debug")
+                set(short_build_type "dbg")
+                set(config "Debug")
+            else()
+                set(short_build_type "rel")
+                set(config "Release")
+            endif()
+            set(Z_VCPKG_CMAKE_BUILD_LOGNAME_${build_type} "${arg_LOGFILE_BASE}-${TARGET_TRIPLET}-${short_build_type}")
+            set(Z_VCPKG_CMAKE_BUILD_DIR_${build_type} "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-${short_build_type}")
+            set(Z_VCPKG_CMAKE_BUILD_COMMAND_${build_type}
+                "${CMAKE_COMMAND}" --build . --config "${config}" ${target_param} -- ${build_param})
+            if(X_PORT_PROFILE)
+                vcpkg_list(PREPEND Z_VCPKG_CMAKE_BUILD_COMMAND_${build_type} "${CMAKE_COMMAND}" "-E" "time")
+            endif()
+            # Builds which had to be throttled for memory before keep their own job count
+            if(EXISTS "${DOWNLOADS}/tools/build-concurrency/${TARGET_TRIPLET}/${PORT}/${Z_VCPKG_CMAKE_BUILD_LOGNAME_${build_type}}.txt")
+                set(make "")
+            endif()
+        endforeach()
+        if(NOT make STREQUAL "")
+            message(STATUS "Building ${TARGET_TRIPLET}-dbg and ${TARGET_TRIPLET}-rel")
+            z_vcpkg_cmake_build_concurrently(build_types "${make}" "${make_args}" "${arg_LOGFILE_BASE}" "${build_types}")
+        endif()
+    endif()
+
+    foreach(build_type IN ITEMS debug release)
+        if("${build_type}" IN_LIST build_types)
             if("${build_type}" STREQUAL "debug")
                 set(short_build_type "dbg")
                 set(config "Debug")
@@ -89,3 +284,15 @@ function(vcpkg_cmake_build)
         endif()
     endforeach()
 endfunction()
+
+# Configuration mode, invoked by the Makefile of z_vcpkg_cmake_build_concurrently
+if(CMAKE_SCRIPT_MODE_FILE STREQUAL CMAKE_CURRENT_LIST_FILE AND DEFINED Z_VCPKG_CMAKE_BUILD_COMMAND)
+    execute_process(
+        COMMAND ${Z_VCPKG_CMAKE_BUILD_COMMAND}
+        WORKING_DIRECTORY "${Z_VCPKG_CMAKE_BUILD_WORKING_DIRECTORY}"
+        OUTPUT_FILE "${Z_VCPKG_CMAKE_BUILD_LOG}-out.log"
+        ERROR_FILE "${Z_VCPKG_CMAKE_BUILD_LOG}-err.log"
+        RESULT_VARIABLE error_code
+    )
+    file(WRITE "${Z_VCPKG_CMAKE_BUILD_STATUS}" "${error_code}")
+endif()
@@ -243,6 +243,7 @@ function(vcpkg_cmake_configure)
         "-DCMAKE_INSTALL_PREFIX=${CURRENT_PACKAGES_DIR}/debug"
         ${arg_OPTIONS} ${arg_OPTIONS_DEBUG})
 
+    z_vcpkg_trace_begin(trace)
     if(NOT arg_DISABLE_PARALLEL_CONFIGURE)
         vcpkg_list(APPEND arg_OPTIONS "-DCMAKE_DISABLE_SOURCE_CHANGES=ON")
 
@@ -277,6 +278,7 @@ function(vcpkg_cmake_configure)
                 "../CMakeFiles/CMakeConfigureLog.yaml" ALIAS "rel-CMakeConfigureLog.yaml.log"
                 ${parallel_log_args}
         )
+        z_vcpkg_trace_ninja_log("${trace}" "${build_dir_release}/vcpkg-parallel-configure/.ninja_log" 0)
         
         vcpkg_list(APPEND config_logs
             "${CURRENT_BUILDTREES_DIR}/${arg_LOGFILE_BASE}-out.log"
@@ -314,6 +316,7 @@ function(vcpkg_cmake_configure)
                 "${CURRENT_BUILDTREES_DIR}/${arg_LOGFILE_BASE}-rel-err.log")
         endif()
     endif()
+    z_vcpkg_trace_end("${trace}" NAME "${arg_LOGFILE_BASE}" CATEGORY configure)
     
     set(all_unused_variables)
     foreach(config_log IN LISTS config_logs)
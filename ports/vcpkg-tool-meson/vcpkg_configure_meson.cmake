@@ -39,6 +39,9 @@ function(z_vcpkg_meson_set_proglist_variables config_type)
                     z_vcpkg_meson_convert_compiler_flags_to_list(${prog}flags "${VCPKG_COMBINED_${prog}_FLAGS_${config_type}}")
                 endif()
                 list(PREPEND ${prog}flags "${VCPKG_DETECTED_CMAKE_${prog}_COMPILER}")
+                if(prog MATCHES "^(C|CXX)$" AND NOT "${Z_VCPKG_COMPILER_LAUNCHER}" STREQUAL "")
+                    list(PREPEND ${prog}flags "${Z_VCPKG_COMPILER_LAUNCHER}")
+                endif()
                 list(FILTER ${prog}flags EXCLUDE REGEX "(-|/)nologo") # Breaks compiler detection otherwise
                 z_vcpkg_meson_convert_list_to_python_array(${prog}flags ${${prog}flags})
                 set("${var_to_set}" "${meson_${prog}} = ${${prog}flags}" PARENT_SCOPE)
@@ -54,6 +57,9 @@ function(z_vcpkg_meson_set_proglist_variables config_type)
                     z_vcpkg_meson_convert_compiler_flags_to_list(${prog}flags "${VCPKG_COMBINED_${prog}_FLAGS_${config_type}}")
                 endif()
                 list(PREPEND ${prog}flags "${VCPKG_DETECTED_CMAKE_${prog}_COMPILER}")
+                if(prog MATCHES "^(C|CXX)$" AND NOT "${Z_VCPKG_COMPILER_LAUNCHER}" STREQUAL "")
+                    list(PREPEND ${prog}flags "${Z_VCPKG_COMPILER_LAUNCHER}")
+                endif()
                 list(FILTER ${prog}flags EXCLUDE REGEX "(-|/)nologo") # Breaks compiler detection otherwise
                 z_vcpkg_meson_convert_list_to_python_array(${prog}flags ${${prog}flags})
                 string(TOLOWER "${prog}" proglower)
@@ -29,6 +29,7 @@ $semverVersion = ($version -replace "(\d+(\.\d+){1,3}).*", "`$1")
 $defaultPortVersion = 0
 $portVersions = @{
     'boost-build'           = 1
+    'boost-cmake'           = 1
 }
 
 function Get-PortVersion {
@@ -175,6 +176,16 @@ $suppressPlatformForDependency = @{
     "boost-property-map-parallel" = @("boost-mpi");
 }
 
+# Options which the super-build of vcpkg-boost passes for the default features of a library,
+# or "exclude" for libraries whose default features depend on the platform or on other ports.
+$superBuildData = @{
+    "boost-iostreams"  = @{ "exclude" = $true };
+    "boost-math"       = @{ "options" = @("-DBOOST_MATH_BUILD_WITH_LEGACY_FUNCTIONS=OFF") };
+    "boost-odeint"     = @{ "options" = @("-DBOOST_ENABLE_MPI=OFF") };
+    "boost-regex"      = @{ "options" = @("-DBOOST_REGEX_ENABLE_ICU=OFF") };
+    "boost-stacktrace" = @{ "exclude" = $true };
+}
+
 function GeneratePortName() {
     param (
         [string]$Library
@@ -418,6 +429,47 @@ function GeneratePort() {
         -NoNewline
 }
 
+# Lines of boost-cmake/boost-libraries.cmake, the table of libraries read by the super-build
+function GenerateSuperBuildEntry() {
+    param (
+        [string]$Library,
+        [string]$Hash,
+        $Dependencies = @()
+    )
+
+    $portName = GeneratePortName $Library
+    $lines = @("set(BOOST_LIBRARY_$($Library)_SHA512 $Hash)")
+    if ($Dependencies.Count -gt 0) {
+        $lines += @("set(BOOST_LIBRARY_$($Library)_DEPENDENCIES $(($Dependencies | Sort-Object) -join ' '))")
+    }
+    [Array]$patches = Get-Item -Path "$portsDir/$portName/*.patch"
+    [Array]$diffs = Get-Item -Path "$portsDir/$portName/*.diff"
+    [Array]$allmods = $patches + $diffs
+    if ($null -ne $allmods -and $allmods.Count -gt 0) {
+        $lines += @("set(BOOST_LIBRARY_$($Library)_PATCHES $(($allmods | ForEach-Object name) -join ' '))")
+    }
+    if ($portData.Contains($portName)) {
+        if ($portData[$portName].Contains('supports')) {
+            $lines += @("set(BOOST_LIBRARY_$($Library)_SUPPORTS `"$($portData[$portName]['supports'])`")")
+        }
+        $external = @($portData[$portName]['dependencies'] | Where-Object { $null -ne $_ } | ForEach-Object {
+                if ($_ -is [string]) { $_ } else { $_.name }
+            } | Where-Object { -not $_.StartsWith("boost-") })
+        if ($external.Count -gt 0) {
+            $lines += @("set(BOOST_LIBRARY_$($Library)_EXTERNAL ON)")
+        }
+    }
+    if ($superBuildData.Contains($portName)) {
+        if ($superBuildData[$portName]['exclude']) {
+            $lines += @("set(BOOST_LIBRARY_$($Library)_EXCLUDED ON)")
+        }
+        if ($superBuildData[$portName].Contains('options')) {
+            $lines += @("set(BOOST_LIBRARY_$($Library)_OPTIONS $($superBuildData[$portName]['options'] -join ' '))")
+        }
+    }
+    $lines
+}
+
 if (!(Test-Path "$scriptsDir/boost")) {
     "Cloning boost..."
     Push-Location $scriptsDir
@@ -462,6 +514,8 @@ if ($libraries.Length -eq 0) {
 }
 
 $boostPortDependencies = @()
+$superBuildLibraries = @()
+$superBuildLines = @()
 
 foreach ($library in $libraries) {
     $archive = "$downloads/boostorg-$library-boost-$version.tar.gz"
@@ -643,6 +697,7 @@ foreach ($library in $libraries) {
             $deps = $deps | Select-Object -Unique
         }
 
+        $libraryDependencies = $deps
         $deps = @($deps | ForEach-Object { GeneratePortDependency $_ -ForLibrary $library })
 
         if ($library -ne 'cmake') {
@@ -658,6 +713,8 @@ foreach ($library in $libraries) {
             -Dependencies $deps
 
         $boostPortDependencies += @(GeneratePortDependency $library)
+        $superBuildLibraries += @($library)
+        $superBuildLines += @(GenerateSuperBuildEntry -Library $library -Hash $hash -Dependencies $libraryDependencies)
     }
     finally {
         Pop-Location
@@ -692,6 +749,19 @@ if ($updateServicePorts) {
         -License "BSL-1.0" `
         -Dependencies @("boost-uninstall", @{ name = "vcpkg-boost"; host = $true }, @{ name = "vcpkg-cmake"; host = $true }, @{ name = "vcpkg-cmake-config"; host = $true })
 
+    # Generate the table of libraries for the super-build
+    $tableLines = @(
+        "# Automatically generated by scripts/boost/generate-ports.ps1"
+        ""
+        "set(BOOST_LIBRARIES"
+    )
+    $tableLines += @($superBuildLibraries | Sort-Object | ForEach-Object { "    $_" })
+    $tableLines += @(")", "") + $superBuildLines + @("")
+    Set-Content -LiteralPath "$portsDir/boost-cmake/boost-libraries.cmake" `
+        -Value "$($tableLines -join "`n")" `
+        -Encoding UTF8 `
+        -NoNewline
+
 
     # Generate manifest files for boost-build
     GeneratePortManifest `
@@ -0,0 +1,358 @@
+import os
+import sys
+import json
+import time
+import heapq
+import argparse
+import statistics
+
+from mergePortTraces import load_traces
+from portGraph import TripletGraph, load_graph, refresh_graph, save_graph, parse_port_features, \
+    GRAPH_PATH, PORTS_DIRECTORY
+
+
+SCRIPT_DIRECTORY = os.path.dirname(os.path.abspath(__file__))
+BUILDTREES_DIRECTORY = os.path.join(SCRIPT_DIRECTORY, '../buildtrees')
+HISTORY_PATH = os.path.join(SCRIPT_DIRECTORY, '../downloads/tools/build-history/history.json')
+MANIFEST_PATH = os.path.join(SCRIPT_DIRECTORY, '../vcpkg.json')
+HISTORY_FORMAT = 1
+HISTORY_SAMPLES = 10
+DEFAULT_DURATION_MS = 60 * 1000
+DEFAULT_PEAK_RSS_MIB = 1024
+POLICIES = ['critical-path', 'longest-first', 'most-dependents', 'fifo']
+
+
+# History of port builds: {"<port>:<triplet>": [{"start_us", "duration_ms", "cpu_ms", "peak_rss_mib"}, ...]}
+
+def load_history(history_path):
+    if not os.path.exists(history_path):
+        return {'format': HISTORY_FORMAT, 'builds': {}}
+    with open(history_path, 'r', encoding='utf-8') as history_file:
+        history = json.load(history_file)
+    if history.get('format') != HISTORY_FORMAT:
+        print(f'Warning: Ignoring {history_path} of an unknown format', file=sys.stderr)
+        return {'format': HISTORY_FORMAT, 'builds': {}}
+    return history
+
+
+def save_history(history, history_path):
+    os.makedirs(os.path.dirname(os.path.abspath(history_path)), exist_ok=True)
+    temp_path = f'{history_path}.{os.getpid()}.tmp'
+    with open(temp_path, 'w', encoding='utf-8') as history_file:
+        json.dump(history, history_file, indent=2)
+    os.replace(temp_path, history_path)
+
+
+def get_port_builds(traces):
+    """{"<port>:<triplet>": build} of the port events in traces written with X_PORT_TRACE"""
+    builds = {}
+    for name, events in traces:
+        build = None
+        peak_rss_mib = None
+        for event in events:
+            if event.get('ph') != 'X':
+                continue
+            event_peak_rss_mib = event.get('args', {}).get('peak_rss_mib')
+            if event_peak_rss_mib is not None:
+                peak_rss_mib = max(peak_rss_mib or 0, event_peak_rss_mib)
+            if event.get('cat') == 'port':
+                build = {'start_us': event['ts'], 'duration_ms': event.get('dur', 0) / 1000,
+                         'cpu_ms': event.get('args', {}).get('cpu_ms')}
+        if build is not None:
+            build['peak_rss_mib'] = peak_rss_mib
+            builds[name] = build
+    return builds
+
+
+def record_builds(history, builds):
+    recorded_count = 0
+    for name, build in builds.items():
+        samples = history['builds'].setdefault(name, [])
+        if any(sample['start_us'] == build['start_us'] for sample in samples):
+            continue
+        samples.append(build)
+        del samples[:-HISTORY_SAMPLES]
+        recorded_count += 1
+    return recorded_count
+
+
+class Estimate:
+    def __init__(self, duration_ms, cores, peak_rss_mib, known):
+        self.duration_ms = duration_ms
+        self.cores = cores
+        self.peak_rss_mib = peak_rss_mib
+        self.known = known
+
+
+def estimate_builds(history, ports, triplet, core_budget):
+    """Median duration and parallelism and the highest peak memory of the recorded builds of each port."""
+    all_durations = [sample['duration_ms'] for samples in history['builds'].values() for sample in samples]
+    default_duration_ms = statistics.median(all_durations) if all_durations else DEFAULT_DURATION_MS
+    estimates = {}
+    for port_name in ports:
+        samples = history['builds'].get(f'{port_name}:{triplet}', [])
+        if not samples:
+            estimates[port_name] = Estimate(default_duration_ms, 1, DEFAULT_PEAK_RSS_MIB, False)
+            continue
+        duration_ms = statistics.median(sample['duration_ms'] for sample in samples)
+        parallelism = [sample['cpu_ms'] / sample['duration_ms'] for sample in samples
+                       if sample.get('cpu_ms') and sample['duration_ms'] > 0]
+        cores = min(max(round(statistics.median(parallelism)), 1), core_budget) if parallelism else 1
+        peak_rss = [sample['peak_rss_mib'] for sample in samples if sample.get('peak_rss_mib') is not None]
+        estimates[port_name] = Estimate(duration_ms, cores, max(peak_rss) if peak_rss else DEFAULT_PEAK_RSS_MIB, True)
+    return estimates
+
+
+# Build graph
+
+def get_build_graph(graph_path, triplet, host_triplet, roots, features):
+    """{port: set of dependencies} of the ports installed for `roots` on a triplet"""
+    graph = load_graph(graph_path)
+    if refresh_graph(graph, [PORTS_DIRECTORY]) or not os.path.exists(graph_path):
+        save_graph(graph, graph_path)
+    triplet_graph = TripletGraph(graph, triplet, host_triplet, features, False, roots)
+    if triplet_graph.resolved:
+        save_graph(graph, graph_path)
+    return {port_name: triplet_graph.dependencies(port_name) for port_name in triplet_graph.active_features}
+
+
+def get_manifest_roots(manifest_path):
+    with open(manifest_path, 'r', encoding='utf-8') as manifest_file:
+        manifest = json.load(manifest_file)
+    roots = []
+    features = {}
+    for dependency in manifest.get('dependencies', []):
+        if isinstance(dependency, str):
+            roots.append(dependency)
+            continue
+        roots.append(dependency['name'])
+        features[dependency['name']] = [feature if isinstance(feature, str) else feature['name']
+                                        for feature in dependency.get('features', [])]
+    return roots, features
+
+
+def get_dependents(dependencies):
+    dependents = {port_name: set() for port_name in dependencies}
+    for port_name, port_dependencies in dependencies.items():
+        for dependency in port_dependencies:
+            dependents[dependency].add(port_name)
+    return dependents
+
+
+def get_topological_order(dependencies):
+    """Kahn's algorithm taking ready ports by name, like a plain dependency resolution."""
+    remaining = {port_name: len(port_dependencies) for port_name, port_dependencies in dependencies.items()}
+    dependents = get_dependents(dependencies)
+    ready = sorted(port_name for port_name, count in remaining.items() if count == 0)
+    order = []
+    while ready:
+        port_name = heapq.heappop(ready)
+        order.append(port_name)
+        for dependent in dependents[port_name]:
+            remaining[dependent] -= 1
+            if remaining[dependent] == 0:
+                heapq.heappush(ready, dependent)
+    if len(order) != len(dependencies):
+        raise ValueError('The dependency graph has a cycle')
+    return order
+
+
+def get_priorities(policy, dependencies, estimates):
+    """Higher priorities start first"""
+    order = get_topological_order(dependencies)
+    dependents = get_dependents(dependencies)
+    if policy == 'critical-path':
+        # Longest path from the start of a port to the end of the build
+        priorities = {}
+        for port_name in reversed(order):
+            priorities[port_name] = estimates[port_name].duration_ms + max(
+                (priorities[dependent] for dependent in dependents[port_name]), default=0)
+        return priorities
+    if policy == 'longest-first':
+        return {port_name: estimates[port_name].duration_ms for port_name in order}
+    if policy == 'most-dependents':
+        transitive = {}
+        for port_name in reversed(order):
+            transitive[port_name] = set(dependents[port_name]).union(
+                *(transitive[dependent] for dependent in dependents[port_name]))
+        return {port_name: len(transitive[port_name]) for port_name in order}
+    return {port_name: -i for i, port_name in enumerate(order)}
+
+
+def simulate(dependencies, estimates, policy, core_budget, memory_budget_mib):
+    """Event-driven list scheduling: whenever a build ends, start the ready builds in priority order
+    which fit into the free cores and memory. A build which does not fit at all runs alone."""
+    priorities = get_priorities(policy, dependencies, estimates)
+    remaining = {port_name: len(port_dependencies) for port_name, port_dependencies in dependencies.items()}
+    dependents = get_dependents(dependencies)
+    ready = [port_name for port_name, count in remaining.items() if count == 0]
+    running = []
+    timeline = {}
+    now = 0
+    free_cores = core_budget
+    free_memory_mib = memory_budget_mib
+    busy_core_ms = 0
+    while ready or running:
+        ready.sort(key=lambda port_name: (-priorities[port_name], port_name))
+        for port_name in list(ready):
+            estimate = estimates[port_name]
+            if (estimate.cores <= free_cores and estimate.peak_rss_mib <= free_memory_mib) or not running:
+                ready.remove(port_name)
+                free_cores -= estimate.cores
+                free_memory_mib -= estimate.peak_rss_mib
+                end = now + estimate.duration_ms
+                heapq.heappush(running, (end, port_name))
+                timeline[port_name] = (now, end)
+                busy_core_ms += min(estimate.cores, core_budget) * estimate.duration_ms
+        now, port_name = heapq.heappop(running)
+        free_cores += estimates[port_name].cores
+        free_memory_mib += estimates[port_name].peak_rss_mib
+        for dependent in dependents[port_name]:
+            remaining[dependent] -= 1
+            if remaining[dependent] == 0:
+                ready.append(dependent)
+    makespan_ms = max((end for _, end in timeline.values()), default=0)
+    utilization = busy_core_ms / (makespan_ms * core_budget) if makespan_ms else 0
+    return timeline, makespan_ms, utilization
+
+
+# Timelines as Chrome traces, like the ones merged by mergePortTraces.py
+
+def assign_lanes(timeline):
+    lanes = {}
+    lane_ends = []
+    for port_name, (start, end) in sorted(timeline.items(), key=lambda item: item[1]):
+        lane = next((i for i, lane_end in enumerate(lane_ends) if lane_end <= start), len(lane_ends))
+        if lane == len(lane_ends):
+            lane_ends.append(end)
+        else:
+            lane_ends[lane] = end
+        lanes[port_name] = lane + 1
+    return lanes
+
+
+def timeline_events(timeline, pid, process_name):
+    events = [{'name': 'process_name', 'ph': 'M', 'pid': pid, 'args': {'name': process_name}}]
+    lanes = assign_lanes(timeline)
+    for port_name, (start, end) in timeline.items():
+        events.append({'name': port_name, 'cat': 'port', 'ph': 'X', 'ts': int(start * 1000),
+                       'dur': int((end - start) * 1000), 'pid': pid, 'tid': lanes[port_name], 'args': {}})
+    return events
+
+
+def write_trace(trace_path, events):
+    with open(trace_path, 'w', encoding='utf-8') as trace_file:
+        json.dump({'traceEvents': events, 'displayTimeUnit': 'ms'}, trace_file)
+
+
+def get_actual_timeline(builds, triplet):
+    """{port: (start_ms, end_ms)} of the traced builds of a triplet, relative to the first start"""
+    timeline = {}
+    for name, build in builds.items():
+        port_name, _, build_triplet = name.partition(':')
+        if build_triplet == triplet:
+            start_ms = build['start_us'] / 1000
+            timeline[port_name] = (start_ms, start_ms + build['duration_ms'])
+    first_start = min((start for start, _ in timeline.values()), default=0)
+    return {port_name: (start - first_start, end - first_start) for port_name, (start, end) in timeline.items()}
+
+
+def print_timeline(timeline, estimates):
+    print(f'{"Port":<40}{"Start (s)":>12}{"End (s)":>12}{"Cores":>8}{"MiB":>8}')
+    for port_name, (start, end) in sorted(timeline.items(), key=lambda item: item[1]):
+        estimate = estimates[port_name]
+        known = '' if estimate.known else ' (no history)'
+        print(f'{port_name:<40}{start / 1000:>12.1f}{end / 1000:>12.1f}{estimate.cores:>8}'
+              f'{estimate.peak_rss_mib:>8}{known}')
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Schedules port builds longest-critical-path-first from a history of traced builds.')
+    parser.add_argument('--history', default=HISTORY_PATH, help='path of the build history')
+    subparsers = parser.add_subparsers(dest='command', required=True)
+
+    record_parser = subparsers.add_parser('record', help='add the traces in buildtrees to the history')
+    record_parser.add_argument('--buildtrees', default=BUILDTREES_DIRECTORY)
+
+    for command, help_text in (('plan', 'predict the timeline of a build'),
+                               ('simulate', 'compare the makespan of the scheduling policies'),
+                               ('compare', 'compare the predicted timeline with the traces in buildtrees')):
+        command_parser = subparsers.add_parser(command, help=help_text)
+        command_parser.add_argument('ports', nargs='*', help='ports to install, by default the dependencies of the manifest')
+        command_parser.add_argument('--manifest', default=MANIFEST_PATH)
+        command_parser.add_argument('--features', nargs='*', default=[], metavar='PORT[FEATURES]')
+        command_parser.add_argument('--triplet', required=True)
+        command_parser.add_argument('--host-triplet', help='by default the triplet')
+        command_parser.add_argument('--graph', default=GRAPH_PATH, help='path of the port graph snapshot')
+        command_parser.add_argument('--cores', type=int, default=os.cpu_count())
+        command_parser.add_argument('--memory-mib', type=int, default=16 * 1024)
+        if command != 'simulate':
+            command_parser.add_argument('--policy', choices=POLICIES, default='critical-path')
+            command_parser.add_argument('--trace', help='write the timeline as a Chrome trace to this file')
+        if command == 'plan':
+            command_parser.add_argument('--order', action='store_true', help='only print the ports in start order')
+        if command == 'compare':
+            command_parser.add_argument('--buildtrees', default=BUILDTREES_DIRECTORY)
+    args = parser.parse_args()
+
+    history = load_history(args.history)
+    if args.command == 'record':
+        builds = get_port_builds(load_traces(args.buildtrees))
+        recorded_count = record_builds(history, builds)
+        save_history(history, args.history)
+        print(f'Recorded {recorded_count} of {len(builds)} traced builds in {args.history}')
+        return
+
+    if args.ports:
+        roots, features = args.ports, {}
+    else:
+        roots, features = get_manifest_roots(args.manifest)
+    for port_name, port_features in parse_port_features(args.features).items():
+        features.setdefault(port_name, []).extend(port_features)
+    try:
+        dependencies = get_build_graph(args.graph, args.triplet, args.host_triplet or args.triplet, roots, features)
+    except ValueError as e:
+        print(f'Error: {e}', file=sys.stderr)
+        sys.exit(1)
+    estimates = estimate_builds(history, dependencies, args.triplet, args.cores)
+    unknown_count = sum(1 for estimate in estimates.values() if not estimate.known)
+    if unknown_count:
+        print(f'Warning: {unknown_count} of {len(estimates)} ports have no recorded builds', file=sys.stderr)
+
+    if args.command == 'simulate':
+        print(f'{"Policy":<20}{"Makespan (s)":>14}{"Utilization":>14}')
+        for policy in POLICIES:
+            _, makespan_ms, utilization = simulate(dependencies, estimates, policy, args.cores, args.memory_mib)
+            print(f'{policy:<20}{makespan_ms / 1000:>14.1f}{utilization:>14.1%}')
+        return
+
+    timeline, makespan_ms, utilization = simulate(dependencies, estimates, args.policy, args.cores, args.memory_mib)
+    if args.command == 'plan':
+        if args.order:
+            for port_name, _ in sorted(timeline.items(), key=lambda item: item[1]):
+                print(port_name)
+        else:
+            print_timeline(timeline, estimates)
+            print(f'\nPredicted makespan: {makespan_ms / 1000:.1f} s, core utilization {utilization:.1%}')
+        if args.trace:
+            write_trace(args.trace, timeline_events(timeline, 1, f'predicted ({args.policy})'))
+        return
+
+    actual = get_actual_timeline(get_port_builds(load_traces(args.buildtrees)), args.triplet)
+    print(f'{"Port":<40}{"Predicted (s)":>16}{"Actual (s)":>16}{"Start delta (s)":>18}')
+    for port_name, (start, end) in sorted(timeline.items(), key=lambda item: item[1]):
+        if port_name not in actual:
+            continue
+        actual_start, actual_end = actual[port_name]
+        print(f'{port_name:<40}{(end - start) / 1000:>16.1f}{(actual_end - actual_start) / 1000:>16.1f}'
+              f'{(actual_start - start) / 1000:>18.1f}')
+    actual_makespan_ms = max((end for _, end in actual.values()), default=0)
+    print(f'\nPredicted makespan: {makespan_ms / 1000:.1f} s, actual: {actual_makespan_ms / 1000:.1f} s')
+    if args.trace:
+        write_trace(args.trace, timeline_events(timeline, 1, f'predicted ({args.policy})')
+                    + timeline_events(actual, 2, 'actual'))
+
+
+if __name__ == "__main__":
+    main()
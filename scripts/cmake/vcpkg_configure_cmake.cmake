@@ -283,6 +283,7 @@ function(vcpkg_configure_cmake)
         "-DCMAKE_INSTALL_PREFIX=${CURRENT_PACKAGES_DIR}/debug"
         ${arg_OPTIONS} ${arg_OPTIONS_DEBUG})
 
+    z_vcpkg_trace_begin(trace)
     if(ninja_host AND CMAKE_HOST_WIN32 AND NOT arg_DISABLE_PARALLEL_CONFIGURE)
         vcpkg_list(APPEND arg_OPTIONS "-DCMAKE_DISABLE_SOURCE_CHANGES=ON")
 
@@ -319,6 +320,7 @@ function(vcpkg_configure_cmake)
                 "../../${TARGET_TRIPLET}-dbg/CMakeCache.txt" ALIAS "dbg-CMakeCache.txt.log"
                 "../CMakeCache.txt" ALIAS "rel-CMakeCache.txt.log"
         )
+        z_vcpkg_trace_ninja_log("${trace}" "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-rel/vcpkg-parallel-configure/.ninja_log" 0)
         
         vcpkg_list(APPEND config_logs
             "${CURRENT_BUILDTREES_DIR}/${arg_LOGNAME}-out.log"
@@ -352,6 +354,7 @@ function(vcpkg_configure_cmake)
                 "${CURRENT_BUILDTREES_DIR}/${arg_LOGNAME}-rel-err.log")
         endif()
     endif()
+    z_vcpkg_trace_end("${trace}" NAME "${arg_LOGNAME}" CATEGORY configure)
     
     # Check unused variables
     vcpkg_list(SET all_unused_variables)
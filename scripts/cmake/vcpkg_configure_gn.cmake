@@ -34,11 +34,17 @@ function(vcpkg_configure_gn)
 
     vcpkg_find_acquire_program(GN)
 
+    # Honored by the Chromium-style toolchains, see z_vcpkg_compiler_cache_setup
+    set(cc_wrapper "")
+    if(NOT "${Z_VCPKG_COMPILER_LAUNCHER}" STREQUAL "")
+        set(cc_wrapper " cc_wrapper=\"${Z_VCPKG_COMPILER_LAUNCHER}\"")
+    endif()
+
     if(NOT DEFINED VCPKG_BUILD_TYPE OR VCPKG_BUILD_TYPE STREQUAL "debug")
         z_vcpkg_configure_gn_generate(
             SOURCE_PATH "${arg_SOURCE_PATH}"
             CONFIG "${TARGET_TRIPLET}-dbg"
-            ARGS "--args=${arg_OPTIONS} ${arg_OPTIONS_DEBUG}"
+            ARGS "--args=${arg_OPTIONS} ${arg_OPTIONS_DEBUG}${cc_wrapper}"
         )
     endif()
 
@@ -46,7 +52,7 @@ function(vcpkg_configure_gn)
         z_vcpkg_configure_gn_generate(
             SOURCE_PATH "${arg_SOURCE_PATH}"
             CONFIG "${TARGET_TRIPLET}-rel"
-            ARGS "--args=${arg_OPTIONS} ${arg_OPTIONS_RELEASE}"
+            ARGS "--args=${arg_OPTIONS} ${arg_OPTIONS_RELEASE}${cc_wrapper}"
         )
     endif()
 endfunction()
@@ -231,10 +231,159 @@ macro(z_vcpkg_append_to_configure_environment inoutstring var defaultval)
     endif()
 endmacro()
 
+# Autoconf results which only depend on the toolchain, the flags and the host tools.
+# Results which depend on installed libraries or on the port (functions, library headers, ...) are never shared.
+function(z_vcpkg_configure_make_is_cacheable out_var name)
+    set(patterns
+        "ac_cv_(objext|exeext)"
+        "ac_cv_(c|cxx)_compiler_gnu"
+        "ac_cv_prog_cc_(g|c89|c99|c11|c23|stdc)"
+        "ac_cv_prog_cxx_(g|cxx98|cxx11|stdcxx)"
+        "ac_cv_prog_(CPP|CXXCPP|AWK)"
+        "ac_cv_prog_make_[A-Za-z0-9_]+_set"
+        "ac_cv_path_(GREP|EGREP|FGREP|SED|install|mkdir)"
+        "ac_cv_header_stdc"
+        "ac_cv_header_(assert|ctype|errno|float|inttypes|limits|locale|math|memory|minix_config|setjmp|signal|stdarg|stdbool|stddef|stdint|stdio|stdlib|string|strings|time|unistd|wchar)_h"
+        "ac_cv_header_sys_(stat|time|types)_h"
+        "ac_cv_c_(bigendian|char_unsigned|const|inline|restrict)"
+        "ac_cv_c_u?int(8|16|32|64)_t"
+        "ac_cv_sizeof_(char|short|int|long|long_long|unsigned_char|unsigned_short|unsigned_int|unsigned_long|unsigned_long_long|void_p|float|double|long_double|size_t)"
+        "ac_cv_type_(_Bool|long_double|long_long_int|unsigned_long_long_int|size_t|ssize_t|pid_t|mode_t|uid_t|u?int(8|16|32|64)_t|u?intptr_t)"
+        "ac_cv_safe_to_define___extensions__"
+        "ac_cv_should_define__xopen_source"
+        "am_cv_(CC|CXX)_dependencies_compiler_type"
+        "am_cv_(ar_interface|make_support_nested_variables|prog_cc_c_o)"
+        "lt_cv_(sys_max_cmd_len|path_LD|path_NM|nm_interface|prog_gnu_ld|ld_reload_flag|objdir|ar_at_file|truncate_bin)"
+        "lt_cv_(deplibs_check_method|file_magic_cmd|file_magic_test_file|to_host_file_cmd|to_tool_file_cmd)"
+        "lt_cv_sys_global_symbol_[a-z_]+"
+        "lt_cv_prog_compiler_(c_o|pic|pic_works|static_works|rtti_exceptions)(_CXX)?"
+    )
+    set(cacheable OFF)
+    foreach(pattern IN LISTS patterns)
+        if(name MATCHES "^${pattern}\$")
+            set(cacheable ON)
+            break()
+        endif()
+    endforeach()
+    set("${out_var}" "${cacheable}" PARENT_SCOPE)
+endfunction()
+
+# The CONFIG_SITE file which collects the cacheable results of all ports configured with
+# the current compilers, flags and tools. It is only used by configure scripts generated by autoconf.
+function(z_vcpkg_configure_make_config_site out_var short_buildtype configure_env build_triplet)
+    set(key_contents "version=1\n")
+    foreach(compiler IN ITEMS VCPKG_DETECTED_CMAKE_C_COMPILER VCPKG_DETECTED_CMAKE_CXX_COMPILER)
+        z_vcpkg_get_cmake_vars_file_stamp(stamp "${${compiler}}")
+        string(APPEND key_contents "${compiler}=${stamp}\n")
+    endforeach()
+    foreach(env IN ITEMS CC CXX CPP CPPFLAGS CFLAGS CXXFLAGS LDFLAGS LIBS PATH INCLUDE C_INCLUDE_PATH CPLUS_INCLUDE_PATH)
+        string(APPEND key_contents "env:${env}=$ENV{${env}}\n")
+    endforeach()
+    string(APPEND key_contents "configure_env=${configure_env}\nbuild_triplet=${build_triplet}\n")
+    string(SHA512 key "${key_contents}")
+    string(SUBSTRING "${key}" 0 16 key)
+
+    if(DEFINED X_VCPKG_CONFIG_SITE_CACHE_DIR)
+        set(cache_dir "${X_VCPKG_CONFIG_SITE_CACHE_DIR}/${TARGET_TRIPLET}")
+    else()
+        set(cache_dir "${DOWNLOADS}/tools/config-site/${TARGET_TRIPLET}")
+    endif()
+    set("${out_var}" "${cache_dir}/${short_buildtype}-${key}.site" PARENT_SCOPE)
+endfunction()
+
+# Adds the cacheable results of config.cache which are not in config_site yet.
+# Variables which the port passes to configure itself are never shared.
+function(z_vcpkg_configure_make_update_config_site config_site cache_file excluded_names)
+    if(NOT EXISTS "${cache_file}")
+        return()
+    endif()
+    set(known_names "")
+    set(contents "# Autoconf results shared by vcpkg_configure_make\n")
+    if(EXISTS "${config_site}")
+        file(READ "${config_site}" contents)
+        file(STRINGS "${config_site}" lines REGEX "^[A-Za-z_][A-Za-z0-9_]*=")
+        foreach(line IN LISTS lines)
+            string(REGEX REPLACE "=.*" "" name "${line}")
+            list(APPEND known_names "${name}")
+        endforeach()
+    endif()
+
+    set(new_lines "")
+    file(STRINGS "${cache_file}" lines REGEX "^[A-Za-z_][A-Za-z0-9_]*=")
+    foreach(line IN LISTS lines)
+        string(REGEX REPLACE "=.*" "" name "${line}")
+        z_vcpkg_configure_make_is_cacheable(cacheable "${name}")
+        if(cacheable AND NOT name IN_LIST known_names AND NOT name IN_LIST excluded_names AND NOT DEFINED ENV{${name}})
+            string(APPEND new_lines "${line}\n")
+        endif()
+    endforeach()
+    if(new_lines STREQUAL "")
+        return()
+    endif()
+
+    # Concurrent builds may lose each other's additions, but never see partial files
+    string(RANDOM LENGTH 8 temp_suffix)
+    file(WRITE "${config_site}.${temp_suffix}.tmp" "${contents}${new_lines}")
+    file(RENAME "${config_site}.${temp_suffix}.tmp" "${config_site}")
+endfunction()
+
+function(z_vcpkg_configure_make_bracket_argument out_var value)
+    set(equals "")
+    while("${value}]" MATCHES "]${equals}]")
+        string(APPEND equals "=")
+    endwhile()
+    set("${out_var}" "[${equals}[${value}]${equals}]" PARENT_SCOPE)
+endfunction()
+
+# Writes a script which runs `command` in `target_dir` with the current values of `env_vars`,
+# such that both configurations can be configured at the same time by ninja.
+function(z_vcpkg_configure_make_parallel_script script short_buildtype target_dir env_vars)
+    set(contents "")
+    foreach(env_var IN LISTS env_vars)
+        if(DEFINED ENV{${env_var}})
+            z_vcpkg_configure_make_bracket_argument(value "$ENV{${env_var}}")
+            string(APPEND contents "set(ENV{${env_var}} ${value})\n")
+        else()
+            string(APPEND contents "unset(ENV{${env_var}})\n")
+        endif()
+    endforeach()
+    string(APPEND contents "execute_process(\n    COMMAND")
+    foreach(arg IN LISTS ARGN)
+        z_vcpkg_configure_make_bracket_argument(arg "${arg}")
+        string(APPEND contents " ${arg}")
+    endforeach()
+    z_vcpkg_configure_make_bracket_argument(target_dir "${target_dir}")
+    string(APPEND contents "
+    WORKING_DIRECTORY ${target_dir}
+    OUTPUT_FILE \"\${CMAKE_CURRENT_LIST_DIR}/${short_buildtype}-out.log\"
+    ERROR_FILE \"\${CMAKE_CURRENT_LIST_DIR}/${short_buildtype}-err.log\"
+    RESULT_VARIABLE error_code
+)
+if(NOT error_code STREQUAL \"0\")
+    message(FATAL_ERROR \"Configure failed: \${error_code}\")
+endif()
+")
+    file(WRITE "${script}" "${contents}")
+endfunction()
+
+function(z_vcpkg_configure_make_after_configure target_dir config_site excluded_names)
+    if(VCPKG_TARGET_IS_WINDOWS AND NOT VCPKG_TARGET_IS_MINGW AND VCPKG_LIBRARY_LINKAGE STREQUAL dynamic)
+        file(GLOB_RECURSE libtool_files "${target_dir}*/libtool")
+        foreach(lt_file IN LISTS libtool_files)
+            file(READ "${lt_file}" _contents)
+            string(REPLACE ".dll.lib" ".lib" _contents "${_contents}")
+            file(WRITE "${lt_file}" "${_contents}")
+        endforeach()
+    endif()
+    if(NOT config_site STREQUAL "")
+        z_vcpkg_configure_make_update_config_site("${config_site}" "${target_dir}/config.cache" "${excluded_names}")
+    endif()
+endfunction()
+
 function(vcpkg_configure_make)
     # parse parameters such that semicolons in options arguments to COMMAND don't get erased
     cmake_parse_arguments(PARSE_ARGV 0 arg
-        "AUTOCONFIG;SKIP_CONFIGURE;COPY_SOURCE;DISABLE_VERBOSE_FLAGS;NO_ADDITIONAL_PATHS;ADD_BIN_TO_PATH;NO_DEBUG;USE_WRAPPERS;NO_WRAPPERS;DETERMINE_BUILD_TRIPLET"
+        "AUTOCONFIG;SKIP_CONFIGURE;COPY_SOURCE;DISABLE_VERBOSE_FLAGS;NO_ADDITIONAL_PATHS;ADD_BIN_TO_PATH;NO_DEBUG;USE_WRAPPERS;NO_WRAPPERS;DETERMINE_BUILD_TRIPLET;PARALLEL_CONFIGURE"
         "SOURCE_PATH;PROJECT_SUBPATH;PRERUN_SHELL;BUILD_TRIPLET"
         "OPTIONS;OPTIONS_DEBUG;OPTIONS_RELEASE;CONFIGURE_ENVIRONMENT_VARIABLES;CONFIG_DEPENDENT_ENVIRONMENT;ADDITIONAL_MSYS_PACKAGES"
     )
@@ -586,6 +735,14 @@ function(vcpkg_configure_make)
         z_vcpkg_make_set_env(AR AR)
         z_vcpkg_make_set_env(LD LINKER)
         unset(z_vcpkg_make_set_env)
+        if(NOT "${Z_VCPKG_COMPILER_LAUNCHER}" STREQUAL "")
+            foreach(envvar IN ITEMS CC CXX)
+                string(FIND "$ENV{${envvar}}" "${Z_VCPKG_COMPILER_LAUNCHER} " launcher_index)
+                if(DEFINED ENV{${envvar}} AND NOT launcher_index EQUAL "0")
+                    set(ENV{${envvar}} "${Z_VCPKG_COMPILER_LAUNCHER} $ENV{${envvar}}")
+                endif()
+            endforeach()
+        endif()
     endif()
 
     list(FILTER z_vcm_all_tools INCLUDE REGEX " ")
@@ -786,6 +943,23 @@ function(vcpkg_configure_make)
         message(STATUS "Warning: Arguments with embedded space may be handled incorrectly by configure:\n   ${flags}")
     endif()
 
+    # Share the toolchain probes of autoconf-generated configure scripts across ports, see z_vcpkg_configure_make_is_cacheable
+    set(use_config_site OFF)
+    if(NOT arg_SKIP_CONFIGURE AND NOT X_VCPKG_NO_CONFIG_SITE_CACHE AND NOT DEFINED ENV{CONFIG_SITE} AND EXISTS "${src_dir}/configure")
+        file(STRINGS "${src_dir}/configure" generated_by_autoconf REGEX "Generated by GNU Autoconf" LIMIT_COUNT 1)
+        if(generated_by_autoconf)
+            set(use_config_site ON)
+        endif()
+    endif()
+    set(config_site_excluded_names "")
+    foreach(option IN LISTS arg_OPTIONS arg_OPTIONS_RELEASE arg_OPTIONS_DEBUG)
+        if(option MATCHES "^(-C|--config-cache|--cache-file=.*)\$")
+            set(use_config_site OFF)
+        elseif(option MATCHES "^([A-Za-z_][A-Za-z0-9_]*)=")
+            list(APPEND config_site_excluded_names "${CMAKE_MATCH_1}")
+        endif()
+    endforeach()
+
     foreach(var IN ITEMS arg_OPTIONS arg_OPTIONS_RELEASE arg_OPTIONS_DEBUG)
         vcpkg_list(SET tmp)
         foreach(element IN LISTS "${var}")
@@ -795,6 +969,34 @@ function(vcpkg_configure_make)
         vcpkg_list(JOIN tmp " " "${var}")
     endforeach()
 
+    # Like vcpkg_cmake_configure, run both configure scripts at once through ninja.
+    # The loop below records the environment of each configuration instead of running it.
+    # Configure scripts may write into the source directory, so this needs a copy of the sources
+    # per configuration (COPY_SOURCE), or a port which states with PARALLEL_CONFIGURE that its
+    # configure leaves the sources alone.
+    list(LENGTH all_buildtypes number_of_buildtypes)
+    set(parallel_configure OFF)
+    if(number_of_buildtypes EQUAL "2" AND NOT arg_SKIP_CONFIGURE AND (arg_COPY_SOURCE OR arg_PARALLEL_CONFIGURE))
+        if(DEFINED ENV{VCPKG_FORCE_SYSTEM_BINARIES})
+            find_program(NINJA NAMES ninja ninja-build)
+        else()
+            vcpkg_find_acquire_program(NINJA)
+        endif()
+        if(NINJA)
+            set(parallel_configure ON)
+            set(parallel_dir "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-parallel-configure")
+            file(REMOVE_RECURSE "${parallel_dir}")
+            file(MAKE_DIRECTORY "${parallel_dir}")
+            set(ninja_configure_contents "rule CreateProcess\n  command = \$process\n\n")
+            vcpkg_list(SET parallel_log_args)
+            vcpkg_list(SET parallel_env_vars
+                PATH PKG_CONFIG PKG_CONFIG_PATH CONFIG_SITE CC CC_FOR_BUILD
+                CPPFLAGS CPPFLAGS_FOR_BUILD CFLAGS CFLAGS_FOR_BUILD CXXFLAGS RCFLAGS LDFLAGS LDFLAGS_FOR_BUILD ARFLAGS
+                _LINK_ LIB LIBPATH LIBRARY_PATH ${arg_CONFIG_DEPENDENT_ENVIRONMENT}
+            )
+        endif()
+    endif()
+
     foreach(current_buildtype IN LISTS all_buildtypes)
         foreach(ENV_VAR ${arg_CONFIG_DEPENDENT_ENVIRONMENT})
             if(DEFINED ENV{${ENV_VAR}})
@@ -854,29 +1056,48 @@ function(vcpkg_configure_make)
         endforeach()
         unset(lib_env_vars)
 
-        set(command "${base_cmd}" -c "${configure_env} ./${relative_build_path}/configure ${arg_BUILD_TRIPLET} ${arg_OPTIONS} ${arg_OPTIONS_${current_buildtype}}")
-        
         if(arg_ADD_BIN_TO_PATH)
             set(path_backup $ENV{PATH})
             vcpkg_add_to_path("${CURRENT_INSTALLED_DIR}${path_suffix_${current_buildtype}}/bin")
         endif()
+
+        set(config_site_${current_buildtype} "")
+        set(cache_file_option "")
+        if(use_config_site)
+            z_vcpkg_configure_make_config_site(config_site_${current_buildtype} "${short_name_${current_buildtype}}" "${configure_env}" "${arg_BUILD_TRIPLET}")
+            if(EXISTS "${config_site_${current_buildtype}}")
+                set(ENV{CONFIG_SITE} "${config_site_${current_buildtype}}")
+            endif()
+            set(cache_file_option "--cache-file=config.cache")
+        endif()
+
+        set(command "${base_cmd}" -c "${configure_env} ./${relative_build_path}/configure ${arg_BUILD_TRIPLET} ${cache_file_option} ${arg_OPTIONS} ${arg_OPTIONS_${current_buildtype}}")
         debug_message("Configure command:'${command}'")
-        if (NOT arg_SKIP_CONFIGURE)
+        if(parallel_configure)
+            set(short_name "${short_name_${current_buildtype}}")
+            set(target_dir_${current_buildtype} "${target_dir}")
+            z_vcpkg_configure_make_parallel_script("${parallel_dir}/${short_name}.cmake" "${short_name}" "${target_dir}" "${parallel_env_vars}" ${command})
+            string(APPEND ninja_configure_contents "build ../${TARGET_TRIPLET}-${short_name}/config.status: CreateProcess\n")
+            string(APPEND ninja_configure_contents "  process = \"${CMAKE_COMMAND}\" -P ${short_name}.cmake\n\n")
+            vcpkg_list(APPEND parallel_log_args
+                "${short_name}-out.log"
+                "${short_name}-err.log"
+                "../${TARGET_TRIPLET}-${short_name}/config.log" ALIAS "${short_name}-config.log"
+            )
+        elseif(NOT arg_SKIP_CONFIGURE)
             message(STATUS "Configuring ${TARGET_TRIPLET}-${short_name_${current_buildtype}}")
+            z_vcpkg_trace_begin(trace)
             vcpkg_execute_required_process(
                 COMMAND ${command}
                 WORKING_DIRECTORY "${target_dir}"
                 LOGNAME "config-${TARGET_TRIPLET}-${short_name_${current_buildtype}}"
                 SAVE_LOG_FILES config.log
             )
-            if(VCPKG_TARGET_IS_WINDOWS AND NOT VCPKG_TARGET_IS_MINGW AND VCPKG_LIBRARY_LINKAGE STREQUAL dynamic)
-                file(GLOB_RECURSE libtool_files "${target_dir}*/libtool")
-                foreach(lt_file IN LISTS libtool_files)
-                    file(READ "${lt_file}" _contents)
-                    string(REPLACE ".dll.lib" ".lib" _contents "${_contents}")
-                    file(WRITE "${lt_file}" "${_contents}")
-                endforeach()
-            endif()
+            z_vcpkg_trace_end("${trace}" NAME "config-${TARGET_TRIPLET}-${short_name_${current_buildtype}}" CATEGORY configure)
+            z_vcpkg_configure_make_after_configure("${target_dir}" "${config_site_${current_buildtype}}" "${config_site_excluded_names}")
+        endif()
+        if(use_config_site)
+            unset(ENV{CONFIG_SITE})
         endif()
         z_vcpkg_restore_pkgconfig_path()
         
@@ -897,6 +1118,23 @@ function(vcpkg_configure_make)
         endforeach()
     endforeach()
 
+    if(parallel_configure)
+        file(WRITE "${parallel_dir}/build.ninja" "${ninja_configure_contents}")
+        message(STATUS "Configuring ${TARGET_TRIPLET}")
+        z_vcpkg_trace_begin(trace)
+        vcpkg_execute_required_process(
+            COMMAND "${NINJA}" -v
+            WORKING_DIRECTORY "${parallel_dir}"
+            LOGNAME "config-${TARGET_TRIPLET}"
+            SAVE_LOG_FILES ${parallel_log_args}
+        )
+        z_vcpkg_trace_end("${trace}" NAME "config-${TARGET_TRIPLET}" CATEGORY configure)
+        z_vcpkg_trace_ninja_log("${trace}" "${parallel_dir}/.ninja_log" 0)
+        foreach(current_buildtype IN LISTS all_buildtypes)
+            z_vcpkg_configure_make_after_configure("${target_dir_${current_buildtype}}" "${config_site_${current_buildtype}}" "${config_site_excluded_names}")
+        endforeach()
+    endif()
+
     # Export matching make program for vcpkg_build_make (cache variable)
     if(CMAKE_HOST_WIN32 AND MSYS_ROOT)
         find_program(Z_VCPKG_MAKE make PATHS "${MSYS_ROOT}/usr/bin" NO_DEFAULT_PATH REQUIRED)
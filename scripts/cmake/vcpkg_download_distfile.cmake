@@ -1,5 +1,9 @@
+if(CMAKE_SCRIPT_MODE_FILE STREQUAL CMAKE_CURRENT_LIST_FILE)
+    cmake_minimum_required(VERSION 3.24) # policies are recorded when the functions below are defined
+endif()
+
 function(z_vcpkg_check_hash result file_path sha512)
-    file(SHA512 "${file_path}" file_hash)
+    z_vcpkg_file_sha512(file_hash "${file_path}" EXPECTED "${sha512}")
     string(TOLOWER "${sha512}" sha512_lower)
     string(COMPARE EQUAL "${file_hash}" "${sha512_lower}" hash_match)
     set("${result}" "${hash_match}" PARENT_SCOPE)
@@ -28,6 +32,295 @@ function(z_vcpkg_download_distfile_test_hash file_path kind error_advice sha512
     endif()
 endfunction()
 
+# Number of segments a large file is split into, X_VCPKG_DOWNLOAD_SEGMENTS or at most 4
+function(z_vcpkg_download_distfile_segment_count out_var)
+    if(X_VCPKG_DOWNLOAD_SEGMENTS MATCHES "^[1-9][0-9]*$")
+        set(segments "${X_VCPKG_DOWNLOAD_SEGMENTS}")
+    elseif(VCPKG_CONCURRENCY GREATER "0" AND VCPKG_CONCURRENCY LESS "4")
+        set(segments "${VCPKG_CONCURRENCY}")
+    else()
+        set(segments 4)
+    endif()
+    set("${out_var}" "${segments}" PARENT_SCOPE)
+endfunction()
+
+# Splits `size` bytes into at most `count` byte ranges "<first>-<last>" of at least `min_size` bytes
+function(z_vcpkg_download_distfile_plan_segments out_var size count min_size)
+    math(EXPR max_count "${size} / ${min_size}")
+    if(max_count LESS count)
+        set(count "${max_count}")
+    endif()
+    if(count LESS "1")
+        set(count 1)
+    endif()
+    math(EXPR segment_size "(${size} + ${count} - 1) / ${count}")
+    set(segments "")
+    set(first 0)
+    while(first LESS size)
+        math(EXPR last "${first} + ${segment_size} - 1")
+        if(last GREATER_EQUAL size)
+            math(EXPR last "${size} - 1")
+        endif()
+        list(APPEND segments "${first}-${last}")
+        math(EXPR first "${last} + 1")
+    endwhile()
+    set("${out_var}" "${segments}" PARENT_SCOPE)
+endfunction()
+
+# Asks for the first byte of `url`; a server which supports ranges answers with the total size.
+# A server which ignores the range sends the whole file instead, which is kept in `probe_file`;
+# out_complete is set to ON if that transfer succeeded.
+function(z_vcpkg_download_distfile_probe out_size out_complete url probe_file headers)
+    set(headers_param "")
+    foreach(header IN LISTS headers)
+        list(APPEND headers_param HTTPHEADER "${header}")
+    endforeach()
+    file(DOWNLOAD "${url}" "${probe_file}"
+        RANGE_START 0 RANGE_END 0
+        ${headers_param}
+        INACTIVITY_TIMEOUT 60
+        STATUS status
+        LOG log
+    )
+    set(size "")
+    set(complete OFF)
+    list(GET status 0 status_code)
+    if(log MATCHES "[Cc]ontent-[Rr]ange: *bytes 0-0/([0-9]+)")
+        set(size "${CMAKE_MATCH_1}")
+    elseif(status_code EQUAL "0")
+        set(complete ON)
+    endif()
+    if(NOT complete)
+        file(REMOVE "${probe_file}")
+    endif()
+    set("${out_size}" "${size}" PARENT_SCOPE)
+    set("${out_complete}" "${complete}" PARENT_SCOPE)
+endfunction()
+
+# Worker for one segment, see z_vcpkg_download_distfile_segmented. Bytes which are already
+# present in `segment_file` are kept, so an interrupted download continues where it stopped.
+# Nothing is printed since the workers run as a pipeline; errors go to `segment_file`.err.
+function(z_vcpkg_download_distfile_fetch_segment segment_file range urls headers)
+    string(REPLACE "-" ";" range "${range}")
+    list(GET range 0 first)
+    list(GET range 1 last)
+    math(EXPR expected_size "${last} - ${first} + 1")
+    set(headers_param "")
+    foreach(header IN LISTS headers)
+        list(APPEND headers_param HTTPHEADER "${header}")
+    endforeach()
+
+    set(errors "")
+    set(attempts "")
+    foreach(unused RANGE 1 3)
+        list(APPEND attempts ${urls})
+    endforeach()
+    foreach(url IN LISTS attempts)
+        set(current_size 0)
+        if(EXISTS "${segment_file}")
+            file(SIZE "${segment_file}" current_size)
+        endif()
+        if(current_size EQUAL expected_size)
+            break()
+        elseif(current_size GREATER expected_size)
+            file(REMOVE "${segment_file}")
+            set(current_size 0)
+        endif()
+
+        math(EXPR resume_from "${first} + ${current_size}")
+        file(REMOVE "${segment_file}.part")
+        file(DOWNLOAD "${url}" "${segment_file}.part"
+            RANGE_START "${resume_from}" RANGE_END "${last}"
+            ${headers_param}
+            INACTIVITY_TIMEOUT 60
+            STATUS status
+        )
+        # Keep whatever arrived, also after a failure
+        if(EXISTS "${segment_file}.part")
+            if(current_size EQUAL "0")
+                file(RENAME "${segment_file}.part" "${segment_file}")
+            else()
+                execute_process(
+                    COMMAND "${CMAKE_COMMAND}" -E cat "${segment_file}" "${segment_file}.part"
+                    OUTPUT_FILE "${segment_file}.joined"
+                    RESULT_VARIABLE error_code
+                )
+                if(error_code EQUAL "0")
+                    file(RENAME "${segment_file}.joined" "${segment_file}")
+                endif()
+                file(REMOVE "${segment_file}.part" "${segment_file}.joined")
+            endif()
+        endif()
+        list(GET status 1 status_message)
+        string(APPEND errors "${url}: ${status_message}\n")
+    endforeach()
+
+    set(current_size 0)
+    if(EXISTS "${segment_file}")
+        file(SIZE "${segment_file}" current_size)
+    endif()
+    if(current_size EQUAL expected_size)
+        file(REMOVE "${segment_file}.err")
+    else()
+        file(WRITE "${segment_file}.err" "${errors}")
+    endif()
+endfunction()
+
+# Fetches `size` bytes in parallel segments which are kept in `partial_dir`
+function(z_vcpkg_download_distfile_fetch_segments out_ok out_segment_files partial_dir filename size urls headers)
+    z_vcpkg_download_distfile_segment_count(segment_count)
+    z_vcpkg_download_distfile_plan_segments(ranges "${size}" "${segment_count}" 16777216)
+    list(LENGTH urls number_of_urls)
+
+    # The workers run as one pipeline: execute_process starts all of them at once and
+    # this needs no build tool, which might itself have to be downloaded first.
+    set(commands "")
+    set(segment_files "")
+    set(index 0)
+    foreach(range IN LISTS ranges)
+        # Rotate the URLs so that each mirror serves a share of the segments
+        math(EXPR rotation "${index} % ${number_of_urls}")
+        set(segment_urls "${urls}")
+        foreach(unused RANGE 1 "${rotation}")
+            if(rotation EQUAL "0")
+                break()
+            endif()
+            list(POP_FRONT segment_urls url)
+            list(APPEND segment_urls "${url}")
+        endforeach()
+        set(segment_file "${partial_dir}/${range}")
+        list(APPEND segment_files "${segment_file}")
+        list(APPEND commands COMMAND "${CMAKE_COMMAND}"
+            "-DZ_VCPKG_DOWNLOAD_SEGMENT_FILE=${segment_file}"
+            "-DZ_VCPKG_DOWNLOAD_SEGMENT_RANGE=${range}"
+            "-DZ_VCPKG_DOWNLOAD_SEGMENT_URLS=${segment_urls}"
+            -P "${SCRIPTS}/cmake/vcpkg_download_distfile.cmake"
+        )
+        math(EXPR index "${index} + 1")
+    endforeach()
+    list(LENGTH ranges number_of_segments)
+    message(STATUS "Downloading ${filename} in ${number_of_segments} segment(s) from ${number_of_urls} URL(s)...")
+    # Headers may carry credentials, so they are not put on the command lines of the workers
+    set(ENV{Z_VCPKG_DOWNLOAD_SEGMENT_HEADERS} "${headers}")
+    execute_process(${commands} OUTPUT_QUIET ERROR_VARIABLE worker_errors)
+    unset(ENV{Z_VCPKG_DOWNLOAD_SEGMENT_HEADERS})
+
+    foreach(segment_file IN LISTS segment_files)
+        if(EXISTS "${segment_file}.err" OR NOT EXISTS "${segment_file}")
+            set(errors "")
+            if(EXISTS "${segment_file}.err")
+                file(READ "${segment_file}.err" errors)
+            endif()
+            message(STATUS "Downloading ${filename} failed, partial data is kept in ${partial_dir}\n${errors}${worker_errors}")
+            set("${out_ok}" OFF PARENT_SCOPE)
+            return()
+        endif()
+    endforeach()
+    set("${out_ok}" ON PARENT_SCOPE)
+    set("${out_segment_files}" "${segment_files}" PARENT_SCOPE)
+endfunction()
+
+# Downloads `urls` to `out_file` without vcpkg's download tool, see X_VCPKG_SEGMENTED_DOWNLOADS.
+# Servers which support ranges are asked for several segments in parallel, spread over all URLs,
+# and the segments survive interrupted installs in downloads/partial. Otherwise the file is
+# downloaded once, by the probe. Sets out_ok to OFF on failure.
+function(z_vcpkg_download_distfile_segmented out_ok out_file filename sha512 skip_sha512 urls headers)
+    set("${out_ok}" OFF PARENT_SCOPE)
+    string(SHA512 partial_key "${filename};${sha512}")
+    string(SUBSTRING "${partial_key}" 0 16 partial_key)
+    get_filename_component(partial_name "${filename}" NAME)
+    set(partial_dir "${DOWNLOADS}/partial/${partial_name}-${partial_key}")
+    if(skip_sha512)
+        # Without a hash, segments of an earlier download may belong to different contents
+        file(REMOVE_RECURSE "${partial_dir}")
+    endif()
+    file(MAKE_DIRECTORY "${partial_dir}")
+
+    set(size "")
+    set(range_urls "")
+    foreach(url IN LISTS urls)
+        z_vcpkg_download_distfile_probe(url_size complete "${url}" "${out_file}" "${headers}")
+        if(complete)
+            # The server ignored the range and the whole file is already there
+            break()
+        elseif(NOT url_size STREQUAL "" AND (size STREQUAL "" OR url_size EQUAL size))
+            set(size "${url_size}")
+            list(APPEND range_urls "${url}")
+        endif()
+    endforeach()
+    if(NOT complete AND size STREQUAL "")
+        message(STATUS "Downloading ${filename} failed: no URL could be used")
+        return()
+    endif()
+    if(complete)
+        set(segment_files "")
+    else()
+        z_vcpkg_download_distfile_fetch_segments(ok segment_files "${partial_dir}" "${filename}" "${size}" "${range_urls}" "${headers}")
+        if(NOT ok)
+            return()
+        endif()
+    endif()
+
+    # CMake cannot hash a stream, so the joined file is hashed once more. The segments are
+    # not hashed on their own: only the hash of the whole file is known.
+    if(NOT segment_files STREQUAL "")
+        get_filename_component(out_dir "${out_file}" DIRECTORY)
+        file(MAKE_DIRECTORY "${out_dir}")
+        execute_process(
+            COMMAND "${CMAKE_COMMAND}" -E cat ${segment_files}
+            OUTPUT_FILE "${out_file}"
+            RESULT_VARIABLE error_code
+        )
+        if(NOT error_code EQUAL "0")
+            message(FATAL_ERROR "Could not join the segments of ${filename} in ${partial_dir}")
+        endif()
+    endif()
+    if(NOT skip_sha512)
+        z_vcpkg_check_hash(hash_match "${out_file}" "${sha512}")
+        if(NOT hash_match)
+            # Never resume from data which produced a wrong file
+            file(REMOVE_RECURSE "${partial_dir}")
+            file(REMOVE "${out_file}")
+            message(FATAL_ERROR
+                "\nFile does not have expected hash:\n"
+                "        File path: [ ${out_file} ]\n"
+                "    Expected hash: [ ${sha512} ]\n"
+                "The file may have been corrupted in transit.\n")
+        endif()
+    endif()
+    file(REMOVE_RECURSE "${partial_dir}")
+    set("${out_ok}" ON PARENT_SCOPE)
+endfunction()
+
+# vcpkg's download tool is the only one which knows the asset caches. They are configured either in
+# X_VCPKG_ASSET_SOURCES or with --x-asset-sources, which is not visible to portfiles. Sets out_var to ON
+# if asset sources are known to be configured; otherwise the own downloaders must ask
+# z_vcpkg_download_distfile_from_asset_cache first.
+function(z_vcpkg_download_distfile_asset_sources_configured out_var)
+    if(DEFINED ENV{X_VCPKG_ASSET_SOURCES} OR DEFINED X_VCPKG_ASSET_SOURCES)
+        set("${out_var}" ON PARENT_SCOPE)
+    else()
+        set("${out_var}" OFF PARENT_SCOPE)
+    endif()
+endfunction()
+
+# Asks vcpkg's download tool for `sha512` without passing any URL, so only the asset caches are used.
+# Sets out_ok to ON if the file was found there.
+function(z_vcpkg_download_distfile_from_asset_cache out_ok file_path sha512)
+    vcpkg_execute_in_download_mode(
+        COMMAND "$ENV{VCPKG_COMMAND}" x-download "${file_path}" "--sha512=${sha512}"
+        RESULT_VARIABLE error_code
+        OUTPUT_VARIABLE output
+        ERROR_VARIABLE output
+        WORKING_DIRECTORY "${DOWNLOADS}"
+    )
+    if("${error_code}" EQUAL "0" AND EXISTS "${file_path}")
+        set("${out_ok}" ON PARENT_SCOPE)
+    else()
+        set("${out_ok}" OFF PARENT_SCOPE)
+    endif()
+endfunction()
+
 function(z_vcpkg_download_distfile_via_aria)
     cmake_parse_arguments(PARSE_ARGV 1 arg
         "SKIP_SHA512"
@@ -42,24 +335,41 @@ function(z_vcpkg_download_distfile_via_aria)
         vcpkg_list(APPEND headers_param "--header=${header}")
     endforeach()
 
-    foreach(URL IN LISTS arg_URLS)
-        debug_message("Download Command: ${ARIA2} ${URL} -o temp/${filename} -l download-${filename}-detailed.log ${headers_param}")
-        vcpkg_execute_in_download_mode(
-            COMMAND ${ARIA2} ${URL}
-            -o temp/${arg_FILENAME}
-            -l download-${arg_FILENAME}-detailed.log
-            ${headers_param}
-            OUTPUT_FILE download-${arg_FILENAME}-out.log
-            ERROR_FILE download-${arg_FILENAME}-err.log
-            RESULT_VARIABLE error_code
-            WORKING_DIRECTORY "${DOWNLOADS}"
-        )
-        
-        if ("${error_code}" STREQUAL "0")
-            break()
-        endif()
-    endforeach()
+    # aria2 verifies the hash itself, so the file is not read again afterwards.
+    # The partial file is keyed by the hash, so that only the same contents are ever continued.
+    get_filename_component(partial_name "${arg_FILENAME}" NAME)
+    vcpkg_list(SET checksum_param)
+    if(arg_SKIP_SHA512)
+        set(partial_file "partial/${partial_name}")
+        file(REMOVE "${DOWNLOADS}/${partial_file}" "${DOWNLOADS}/${partial_file}.aria2")
+    else()
+        string(TOLOWER "${arg_SHA512}" sha512_lower)
+        vcpkg_list(SET checksum_param "--checksum=sha-512=${sha512_lower}")
+        set(partial_file "partial/${sha512_lower}-${partial_name}")
+    endif()
+    z_vcpkg_download_distfile_segment_count(segments)
+
+    # All URLs are passed at once: aria2 treats them as mirrors and spreads the segments over them.
+    # Partial files are kept outside of temp/ so that an interrupted download can be continued.
+    debug_message("Download Command: ${ARIA2} ${arg_URLS} -o ${partial_file} -c -s ${segments} -l download-${arg_FILENAME}-detailed.log ${headers_param}")
+    vcpkg_execute_in_download_mode(
+        COMMAND ${ARIA2} ${arg_URLS}
+        -o "${partial_file}"
+        --continue=true
+        --split=${segments}
+        --max-connection-per-server=${segments}
+        -l download-${arg_FILENAME}-detailed.log
+        ${checksum_param}
+        ${headers_param}
+        OUTPUT_FILE download-${arg_FILENAME}-out.log
+        ERROR_FILE download-${arg_FILENAME}-err.log
+        RESULT_VARIABLE error_code
+        WORKING_DIRECTORY "${DOWNLOADS}"
+    )
     if (NOT "${error_code}" STREQUAL "0")
+        # Only an interrupted install leaves the partial file behind; after a failure or a hash
+        # mismatch it must not be continued.
+        file(REMOVE "${DOWNLOADS}/${partial_file}" "${DOWNLOADS}/${partial_file}.aria2")
         message(STATUS
             "Downloading ${arg_FILENAME}... Failed.\n"
             "    Exit Code: ${error_code}\n"
@@ -68,15 +378,8 @@ function(z_vcpkg_download_distfile_via_aria)
             "        ${DOWNLOADS}/download-${arg_FILENAME}-err.log\n"
             "        ${DOWNLOADS}/download-${arg_FILENAME}-detailed.log\n"
         )
-        z_vcpkg_download_distfile_show_proxy_and_fail("${error_code}")
+        message(FATAL_ERROR "Download failed, halting portfile.")
     else()
-        z_vcpkg_download_distfile_test_hash(
-            "${DOWNLOADS}/temp/${arg_FILENAME}"
-            "downloaded file"
-            "The file may have been corrupted in transit."
-            "${arg_SHA512}"
-            ${arg_SKIP_SHA512}
-        )
         file(REMOVE
             ${DOWNLOADS}/download-${arg_FILENAME}-out.log
             ${DOWNLOADS}/download-${arg_FILENAME}-err.log
@@ -84,7 +387,11 @@ function(z_vcpkg_download_distfile_via_aria)
         )
         get_filename_component(downloaded_file_dir "${downloaded_file_path}" DIRECTORY)
         file(MAKE_DIRECTORY "${downloaded_file_dir}")
-        file(RENAME "${DOWNLOADS}/temp/${arg_FILENAME}" "${downloaded_file_path}")
+        file(RENAME "${DOWNLOADS}/${partial_file}" "${downloaded_file_path}")
+        if(NOT arg_SKIP_SHA512)
+            z_vcpkg_file_sha512_remember("${downloaded_file_path}" "${arg_SHA512}")
+            z_vcpkg_download_store_add("${downloaded_file_path}" sha512 "${arg_SHA512}")
+        endif()
     endif()
 endfunction()
 
@@ -148,6 +455,17 @@ If you do not know the SHA512, add it as 'SHA512 0' and re-run this command.")
         endif()
     endif()
 
+    if(NOT arg_SKIP_SHA512 AND NOT _VCPKG_NO_DOWNLOADS)
+        z_vcpkg_download_store_collect()
+    endif()
+    if(NOT arg_SKIP_SHA512)
+        # The same contents may already have been downloaded under another name, e.g. by a fork of the port
+        z_vcpkg_download_store_lookup(found_in_store "${downloaded_file_path}" sha512 "${arg_SHA512}")
+        if(found_in_store)
+            message(STATUS "Linked ${arg_FILENAME} from the download store.")
+        endif()
+    endif()
+
     set(download_file_path_part "${DOWNLOADS}/temp/${arg_FILENAME}")
 
     # Works around issue #3399
@@ -165,6 +483,7 @@ If you do not know the SHA512, add it as 'SHA512 0' and re-run this command.")
             string(APPEND advice_message " To re-download this file please delete cached file at path ${downloaded_file_path} and retry.")
         endif()
 
+        z_vcpkg_trace_begin(trace)
         z_vcpkg_download_distfile_test_hash(
             "${downloaded_file_path}"
             "cached file"
@@ -172,7 +491,11 @@ If you do not know the SHA512, add it as 'SHA512 0' and re-run this command.")
             "${arg_SHA512}"
             "${arg_SKIP_SHA512}"
         )
+        z_vcpkg_trace_end("${trace}" NAME "download ${arg_FILENAME}" CATEGORY download ARGS cached ON)
         message(STATUS "Using cached ${arg_FILENAME}.")
+        if(NOT arg_SKIP_SHA512)
+            z_vcpkg_download_store_add("${downloaded_file_path}" sha512 "${arg_SHA512}")
+        endif()
     endif()
 
     # vcpkg_download_distfile_ALWAYS_REDOWNLOAD only triggers when NOT _VCPKG_NO_DOWNLOADS
@@ -186,10 +509,35 @@ If you do not know the SHA512, add it as 'SHA512 0' and re-run this command.")
         return()
     endif()
 
+    set(own_downloader "")
     if(NOT arg_DISABLE_ARIA2 AND _VCPKG_DOWNLOAD_TOOL STREQUAL "ARIA2" AND NOT EXISTS "${downloaded_file_path}")
+        set(own_downloader ARIA2)
+    elseif(X_VCPKG_SEGMENTED_DOWNLOADS AND (NOT EXISTS "${downloaded_file_path}" OR arg_ALWAYS_REDOWNLOAD))
+        set(own_downloader SEGMENTED)
+    endif()
+    if(NOT own_downloader STREQUAL "")
+        # The own downloaders go to the URLs directly, so they must neither bypass an asset cache
+        # nor x-block-origin.
+        z_vcpkg_download_distfile_asset_sources_configured(asset_sources_configured)
+        if(asset_sources_configured)
+            set(own_downloader "")
+        elseif(NOT arg_SKIP_SHA512)
+            z_vcpkg_download_distfile_from_asset_cache(found_in_asset_cache "${downloaded_file_path}" "${arg_SHA512}")
+            if(found_in_asset_cache)
+                message(STATUS "Downloaded ${arg_FILENAME} from an asset cache.")
+                z_vcpkg_file_sha512_remember("${downloaded_file_path}" "${arg_SHA512}")
+                z_vcpkg_download_store_add("${downloaded_file_path}" sha512 "${arg_SHA512}")
+                set("${out_var}" "${downloaded_file_path}" PARENT_SCOPE)
+                return()
+            endif()
+        endif()
+    endif()
+
+    if(own_downloader STREQUAL "ARIA2")
         if (arg_SKIP_SHA512)
             set(OPTION_SKIP_SHA512 "SKIP_SHA512")
         endif()
+        z_vcpkg_trace_begin(trace)
         z_vcpkg_download_distfile_via_aria(
             "${OPTION_SKIP_SHA512}"
             FILENAME "${arg_FILENAME}"
@@ -197,6 +545,7 @@ If you do not know the SHA512, add it as 'SHA512 0' and re-run this command.")
             URLS "${arg_URLS}"
             HEADERS "${arg_HEADERS}"
         )
+        z_vcpkg_trace_end("${trace}" NAME "download ${arg_FILENAME}" CATEGORY download ARGS cached OFF)
         set("${out_var}" "${downloaded_file_path}" PARENT_SCOPE)
         return()
     endif()
@@ -217,7 +566,28 @@ If you do not know the SHA512, add it as 'SHA512 0' and re-run this command.")
         vcpkg_list(SET sha512_param "--sha512=${arg_SHA512}")
     endif()
 
-    if(NOT EXISTS "${downloaded_file_path}" OR arg_ALWAYS_REDOWNLOAD)
+    set(segmented_download_ok OFF)
+    if(own_downloader STREQUAL "SEGMENTED")
+        z_vcpkg_trace_begin(trace)
+        z_vcpkg_download_distfile_segmented(segmented_download_ok
+            "${download_file_path_part}" "${arg_FILENAME}" "${arg_SHA512}" "${arg_SKIP_SHA512}"
+            "${arg_URLS}" "${arg_HEADERS}")
+        if(segmented_download_ok)
+            get_filename_component(downloaded_file_dir "${downloaded_file_path}" DIRECTORY)
+            file(MAKE_DIRECTORY "${downloaded_file_dir}")
+            file(RENAME "${download_file_path_part}" "${downloaded_file_path}")
+            if(NOT arg_SKIP_SHA512)
+                z_vcpkg_file_sha512_remember("${downloaded_file_path}" "${arg_SHA512}")
+                z_vcpkg_download_store_add("${downloaded_file_path}" sha512 "${arg_SHA512}")
+            endif()
+            z_vcpkg_trace_end("${trace}" NAME "download ${arg_FILENAME}" CATEGORY download ARGS cached OFF)
+        else()
+            message(STATUS "Falling back to vcpkg's download tool")
+        endif()
+    endif()
+
+    if(NOT segmented_download_ok AND (NOT EXISTS "${downloaded_file_path}" OR arg_ALWAYS_REDOWNLOAD))
+        z_vcpkg_trace_begin(trace)
         vcpkg_execute_in_download_mode(
             COMMAND "$ENV{VCPKG_COMMAND}" x-download
                 "${downloaded_file_path}"
@@ -230,7 +600,19 @@ If you do not know the SHA512, add it as 'SHA512 0' and re-run this command.")
         if(NOT "${error_code}" EQUAL "0")
             message(FATAL_ERROR "Download failed, halting portfile.")
         endif()
+        if(NOT arg_SKIP_SHA512)
+            # vcpkg's download tool has verified the hash
+            z_vcpkg_file_sha512_remember("${downloaded_file_path}" "${arg_SHA512}")
+            z_vcpkg_download_store_add("${downloaded_file_path}" sha512 "${arg_SHA512}")
+        endif()
+        z_vcpkg_trace_end("${trace}" NAME "download ${arg_FILENAME}" CATEGORY download ARGS cached OFF)
     endif()
 
     set("${out_var}" "${downloaded_file_path}" PARENT_SCOPE)
 endfunction()
+
+# Segment mode, invoked by z_vcpkg_download_distfile_segmented
+if(CMAKE_SCRIPT_MODE_FILE STREQUAL CMAKE_CURRENT_LIST_FILE AND DEFINED Z_VCPKG_DOWNLOAD_SEGMENT_FILE)
+    z_vcpkg_download_distfile_fetch_segment("${Z_VCPKG_DOWNLOAD_SEGMENT_FILE}" "${Z_VCPKG_DOWNLOAD_SEGMENT_RANGE}"
+        "${Z_VCPKG_DOWNLOAD_SEGMENT_URLS}" "$ENV{Z_VCPKG_DOWNLOAD_SEGMENT_HEADERS}")
+endif()
@@ -1,3 +1,7 @@
+if(CMAKE_SCRIPT_MODE_FILE STREQUAL CMAKE_CURRENT_LIST_FILE)
+    cmake_minimum_required(VERSION 3.21) # policies are recorded when the functions below are defined
+endif()
+
 set(Z_VCPKG_EXECUTE_BUILD_PROCESS_RETRY_ERROR_MESSAGES
     "LINK : fatal error LNK1102:"
     " fatal error C1060: "
@@ -17,6 +21,297 @@ set(Z_VCPKG_EXECUTE_BUILD_PROCESS_RETRY_ERROR_MESSAGES
 )
 list(JOIN Z_VCPKG_EXECUTE_BUILD_PROCESS_RETRY_ERROR_MESSAGES "|" Z_VCPKG_EXECUTE_BUILD_PROCESS_RETRY_ERROR_MESSAGES)
 
+# Replaces the job count (VCPKG_CONCURRENCY) passed to the build tool by `jobs`.
+# Sets out_found to ON if the command contained a recognized job count.
+function(z_vcpkg_execute_build_process_set_jobs out_command out_found jobs)
+    set(command "")
+    set(found OFF)
+    set(previous "")
+    foreach(arg IN LISTS ARGN)
+        if(arg MATCHES "^(-j|/m:|/p:MultiProcMaxCount=)${VCPKG_CONCURRENCY}$")
+            set(arg "${CMAKE_MATCH_1}${jobs}")
+            set(found ON)
+        elseif(arg STREQUAL "${VCPKG_CONCURRENCY}" AND previous MATCHES "^(-j|-jobs|--jobs)$")
+            set(arg "${jobs}")
+            set(found ON)
+        endif()
+        list(APPEND command "${arg}")
+        set(previous "${arg}")
+    endforeach()
+    set("${out_command}" "${command}" PARENT_SCOPE)
+    set("${out_found}" "${found}" PARENT_SCOPE)
+endfunction()
+
+# Sets out_var to the available memory in KiB
+function(z_vcpkg_build_governor_mem_available out_var)
+    file(STRINGS "/proc/meminfo" mem_available REGEX "^MemAvailable:")
+    string(REGEX REPLACE "[^0-9]" "" mem_available "${mem_available}")
+    set("${out_var}" "${mem_available}" PARENT_SCOPE)
+endfunction()
+
+# Samples the process tree of a running build, see z_vcpkg_execute_build_process_run.
+# The available memory is polled every 0.1 s, and the process tree is scanned once per second or
+# as soon as memory runs low. The concurrency is lowered in steps as memory runs out:
+# - below twice the reserve, compiler or linker processes which just started are stopped (SIGSTOP)
+#   before they allocate, so that fewer jobs run at once;
+# - below the reserve, the most recently started running job is stopped as well;
+# - below half the reserve, stopping is not enough since stopped processes keep their memory: the
+#   largest stopped job is killed, so that the build fails and is retried with fewer jobs.
+# Stopped jobs are continued once three times the reserve is available again.
+# Linkers may additionally be limited to `max_links` concurrently running processes.
+# With `observe_only`, the tree is only sampled for the summary (used by X_PORT_TRACE).
+function(z_vcpkg_build_governor_watch pid_file summary_file max_links observe_only)
+    set(job_regex "^(cc1|cc1plus|cc1obj|cc1objplus|as|clang|clang\\+\\+|clang-[0-9]+|ld|ld\\.bfd|ld\\.gold|ld\\.lld|lld|mold|collect2|lto1|lto-wrapper|rustc)$")
+    set(link_regex "^(ld|ld\\.bfd|ld\\.gold|ld\\.lld|lld|mold|collect2|lto1|lto-wrapper)$")
+
+    file(STRINGS "/proc/meminfo" mem_total REGEX "^MemTotal:")
+    string(REGEX REPLACE "[^0-9]" "" mem_total "${mem_total}")
+    if(NOT "${X_VCPKG_BUILD_GOVERNOR_RESERVE}" STREQUAL "") # always defined in the governor process
+        math(EXPR reserve_kib "${X_VCPKG_BUILD_GOVERNOR_RESERVE} * 1024")
+    else()
+        math(EXPR reserve_kib "${mem_total} / 10")
+    endif()
+    math(EXPR critical_kib "${reserve_kib} / 2")
+    math(EXPR pressure_kib "${reserve_kib} * 2")
+    math(EXPR resume_kib "${reserve_kib} * 3")
+
+    # The RSS in /proc/<pid>/stat is counted in pages
+    execute_process(COMMAND getconf PAGESIZE OUTPUT_VARIABLE page_size OUTPUT_STRIP_TRAILING_WHITESPACE ERROR_QUIET)
+    if(NOT page_size MATCHES "^[1-9][0-9]*$")
+        set(page_size 4096)
+    endif()
+    math(EXPR page_kib "${page_size} / 1024")
+
+    foreach(iteration RANGE 300)
+        if(EXISTS "${pid_file}")
+            break()
+        endif()
+        execute_process(COMMAND "${CMAKE_COMMAND}" -E sleep 0.1)
+    endforeach()
+    if(NOT EXISTS "${pid_file}")
+        return()
+    endif()
+    file(STRINGS "${pid_file}" root_pid LIMIT_COUNT 1)
+
+    set(stopped "")
+    set(seen_jobs "")
+    set(killed 0)
+    set(peak_rss_kib 0)
+    set(max_stopped 0)
+    set(peak_links 0)
+    set(max_stopped_links 0)
+    while(EXISTS "/proc/${root_pid}/stat")
+        file(READ "/proc/${root_pid}/stat" root_stat)
+        if(root_stat MATCHES "\\) Z ")
+            break()
+        endif()
+
+        # Collect the tree below the build process
+        file(GLOB proc_dirs LIST_DIRECTORIES true "/proc/[0-9]*")
+        set(parents "")
+        foreach(proc_dir IN LISTS proc_dirs)
+            if(NOT EXISTS "${proc_dir}/stat")
+                continue()
+            endif()
+            file(READ "${proc_dir}/stat" stat)
+            if(NOT stat MATCHES "^([0-9]+) \\((.*)\\) (.) ([0-9]+) (.*)$")
+                continue()
+            endif()
+            set(pid "${CMAKE_MATCH_1}")
+            set(proc_${pid}_name "${CMAKE_MATCH_2}")
+            set(proc_${pid}_parent "${CMAKE_MATCH_4}")
+            string(REPLACE " " ";" fields "${CMAKE_MATCH_5}")
+            list(GET fields 19 proc_${pid}_rss) # field 24 of /proc/<pid>/stat, in pages
+            list(APPEND parents "${pid}")
+        endforeach()
+        set(tree "${root_pid}")
+        set(frontier "${root_pid}")
+        while(NOT frontier STREQUAL "")
+            set(next_frontier "")
+            foreach(pid IN LISTS parents)
+                if(proc_${pid}_parent IN_LIST frontier AND NOT pid IN_LIST tree)
+                    list(APPEND tree "${pid}")
+                    list(APPEND next_frontier "${pid}")
+                endif()
+            endforeach()
+            set(frontier "${next_frontier}")
+        endwhile()
+
+        set(rss_pages 0)
+        set(running_jobs "")
+        set(running_links "")
+        set(new_jobs "")
+        set(alive_jobs "")
+        foreach(pid IN LISTS tree)
+            math(EXPR rss_pages "${rss_pages} + ${proc_${pid}_rss}")
+            if(proc_${pid}_name MATCHES "${job_regex}")
+                list(APPEND alive_jobs "${pid}")
+                if(NOT pid IN_LIST seen_jobs)
+                    list(APPEND new_jobs "${pid}")
+                endif()
+                if(NOT pid IN_LIST stopped)
+                    list(APPEND running_jobs "${pid}")
+                    if(proc_${pid}_name MATCHES "${link_regex}")
+                        list(APPEND running_links "${pid}")
+                    endif()
+                endif()
+            endif()
+        endforeach()
+        set(seen_jobs "${alive_jobs}")
+        set(alive_stopped "")
+        foreach(pid IN LISTS stopped)
+            if(pid IN_LIST tree)
+                list(APPEND alive_stopped "${pid}")
+            endif()
+        endforeach()
+        set(stopped "${alive_stopped}")
+
+        math(EXPR rss_kib "${rss_pages} * ${page_kib}")
+        if(rss_kib GREATER peak_rss_kib)
+            set(peak_rss_kib "${rss_kib}")
+        endif()
+        list(LENGTH running_links number_of_links)
+        if(number_of_links GREATER peak_links)
+            set(peak_links "${number_of_links}")
+        endif()
+
+        z_vcpkg_build_governor_mem_available(mem_available)
+
+        list(LENGTH running_jobs number_of_running_jobs)
+        list(LENGTH new_jobs number_of_new_jobs)
+        if(observe_only)
+            # Sampling only
+        elseif(mem_available LESS critical_kib AND NOT stopped STREQUAL "")
+            set(pid_to_kill "")
+            set(largest_rss -1)
+            foreach(pid IN LISTS stopped)
+                if(proc_${pid}_rss GREATER largest_rss)
+                    set(pid_to_kill "${pid}")
+                    set(largest_rss "${proc_${pid}_rss}")
+                endif()
+            endforeach()
+            execute_process(COMMAND kill -KILL "${pid_to_kill}" RESULT_VARIABLE error_code)
+            if(error_code EQUAL "0")
+                list(REMOVE_ITEM stopped "${pid_to_kill}")
+                math(EXPR killed "${killed} + 1")
+                message(STATUS "Memory exhausted (${mem_available} KiB available), killing ${proc_${pid_to_kill}_name} (${pid_to_kill})")
+            endif()
+        elseif(mem_available LESS pressure_kib AND number_of_new_jobs GREATER "0"
+               AND number_of_running_jobs GREATER number_of_new_jobs)
+            # Jobs which did not allocate much yet are the cheapest to hold back
+            foreach(pid_to_stop IN LISTS new_jobs)
+                if(pid_to_stop IN_LIST running_jobs)
+                    execute_process(COMMAND kill -STOP "${pid_to_stop}" RESULT_VARIABLE error_code)
+                    if(error_code EQUAL "0")
+                        list(APPEND stopped "${pid_to_stop}")
+                        message(STATUS "Memory getting low (${mem_available} KiB available), holding back ${proc_${pid_to_stop}_name} (${pid_to_stop})")
+                    endif()
+                endif()
+            endforeach()
+        elseif(mem_available LESS reserve_kib AND number_of_running_jobs GREATER "1")
+            # Never stop the last running job, otherwise the build could not make progress
+            list(GET running_jobs -1 pid_to_stop)
+            execute_process(COMMAND kill -STOP "${pid_to_stop}" RESULT_VARIABLE error_code)
+            if(error_code EQUAL "0")
+                list(APPEND stopped "${pid_to_stop}")
+                message(STATUS "Memory low (${mem_available} KiB available), pausing ${proc_${pid_to_stop}_name} (${pid_to_stop})")
+                if(proc_${pid_to_stop}_name MATCHES "${link_regex}")
+                    math(EXPR max_stopped_links "${max_stopped_links} + 1")
+                endif()
+            endif()
+        elseif(max_links GREATER "0" AND number_of_links GREATER max_links)
+            list(GET running_links -1 pid_to_stop)
+            execute_process(COMMAND kill -STOP "${pid_to_stop}" RESULT_VARIABLE error_code)
+            if(error_code EQUAL "0")
+                list(APPEND stopped "${pid_to_stop}")
+            endif()
+        elseif(NOT stopped STREQUAL "" AND (number_of_running_jobs EQUAL "0" OR
+               (mem_available GREATER resume_kib AND (max_links LESS_EQUAL "0" OR number_of_links LESS max_links))))
+            # Continue the oldest paused job, or any paused job if nothing else is running
+            list(POP_FRONT stopped pid_to_continue)
+            execute_process(COMMAND kill -CONT "${pid_to_continue}")
+        endif()
+
+        list(LENGTH stopped number_of_stopped)
+        if(number_of_stopped GREATER max_stopped)
+            set(max_stopped "${number_of_stopped}")
+        endif()
+
+        foreach(pid IN LISTS parents)
+            unset(proc_${pid}_name)
+            unset(proc_${pid}_parent)
+            unset(proc_${pid}_rss)
+        endforeach()
+        # A linker can allocate gigabytes within a second
+        foreach(poll RANGE 1 10)
+            execute_process(COMMAND "${CMAKE_COMMAND}" -E sleep 0.1)
+            z_vcpkg_build_governor_mem_available(mem_available)
+            if(NOT observe_only AND mem_available LESS pressure_kib)
+                break()
+            endif()
+        endforeach()
+    endwhile()
+
+    foreach(pid IN LISTS stopped)
+        execute_process(COMMAND kill -CONT "${pid}" OUTPUT_QUIET ERROR_QUIET)
+    endforeach()
+
+    math(EXPR peak_rss_mib "${peak_rss_kib} / 1024")
+    file(WRITE "${summary_file}" "peak_rss_mib=${peak_rss_mib}\nmax_stopped=${max_stopped}\npeak_links=${peak_links}\nmax_stopped_links=${max_stopped_links}\nkilled=${killed}\n")
+endfunction()
+
+# Runs the build command. With X_VCPKG_BUILD_GOVERNOR or X_PORT_TRACE on a Linux host, the build
+# runs next to z_vcpkg_build_governor_watch in a pipeline; out_summary receives the governor's summary.
+function(z_vcpkg_execute_build_process_run out_error_code out_summary working_directory log_out log_err)
+    set(summary "")
+    if((X_VCPKG_BUILD_GOVERNOR OR X_PORT_TRACE) AND VCPKG_HOST_IS_LINUX)
+        set(governor_prefix "${log_out}.governor")
+        set(pid_file "${governor_prefix}.pid")
+        set(summary_file "${governor_prefix}.summary")
+        file(REMOVE "${pid_file}" "${summary_file}")
+        if(DEFINED X_VCPKG_BUILD_GOVERNOR_MAX_LINKS)
+            set(max_links "${X_VCPKG_BUILD_GOVERNOR_MAX_LINKS}")
+        else()
+            set(max_links 0)
+        endif()
+        if(X_VCPKG_BUILD_GOVERNOR)
+            set(observe_only OFF)
+        else()
+            set(observe_only ON)
+        endif()
+        execute_process(
+            COMMAND sh -c [[echo $$ > "$1"; out="$2"; err="$3"; shift 3; exec "$@" > "$out" 2> "$err"]]
+                sh "${pid_file}" "${log_out}" "${log_err}" ${ARGN}
+            COMMAND "${CMAKE_COMMAND}"
+                "-DZ_VCPKG_BUILD_GOVERNOR_PID_FILE=${pid_file}"
+                "-DZ_VCPKG_BUILD_GOVERNOR_SUMMARY_FILE=${summary_file}"
+                "-DZ_VCPKG_BUILD_GOVERNOR_MAX_LINKS=${max_links}"
+                "-DZ_VCPKG_BUILD_GOVERNOR_OBSERVE_ONLY=${observe_only}"
+                "-DX_VCPKG_BUILD_GOVERNOR_RESERVE=${X_VCPKG_BUILD_GOVERNOR_RESERVE}"
+                -P "${SCRIPTS}/cmake/vcpkg_execute_build_process.cmake"
+            WORKING_DIRECTORY "${working_directory}"
+            OUTPUT_FILE "${governor_prefix}.log"
+            ERROR_FILE "${governor_prefix}.log"
+            RESULTS_VARIABLE error_codes
+        )
+        list(GET error_codes 0 error_code)
+        if(EXISTS "${summary_file}")
+            file(STRINGS "${summary_file}" summary)
+        endif()
+        file(REMOVE "${pid_file}" "${summary_file}")
+    else()
+        execute_process(
+            COMMAND ${ARGN}
+            WORKING_DIRECTORY "${working_directory}"
+            OUTPUT_FILE "${log_out}"
+            ERROR_FILE "${log_err}"
+            RESULT_VARIABLE error_code
+        )
+    endif()
+    set("${out_error_code}" "${error_code}" PARENT_SCOPE)
+    set("${out_summary}" "${summary}" PARENT_SCOPE)
+endfunction()
+
 function(vcpkg_execute_build_process)
     cmake_parse_arguments(PARSE_ARGV 0 arg "" "WORKING_DIRECTORY;LOGNAME" "COMMAND;NO_PARALLEL_COMMAND")
 
@@ -46,13 +341,28 @@ function(vcpkg_execute_build_process)
         endif()
     endif()
 
-    execute_process(
-        COMMAND ${arg_COMMAND}
-        WORKING_DIRECTORY "${arg_WORKING_DIRECTORY}"
-        OUTPUT_FILE "${log_out}"
-        ERROR_FILE "${log_err}"
-        RESULT_VARIABLE error_code
-    )
+    # Concurrency which was found to be safe with respect to memory in earlier runs of this build.
+    # Every build which succeeds at that concurrency without being throttled doubles it again,
+    # so that a transient memory shortage does not limit the build forever.
+    set(jobs "${VCPKG_CONCURRENCY}")
+    set(limited_by_earlier_builds OFF)
+    set(backed_off OFF)
+    set(concurrency_file "${DOWNLOADS}/tools/build-concurrency/${TARGET_TRIPLET}/${PORT}/${arg_LOGNAME}.txt")
+    z_vcpkg_execute_build_process_set_jobs(unused_command jobs_found "${jobs}" ${arg_COMMAND})
+    if(jobs_found AND EXISTS "${concurrency_file}")
+        file(STRINGS "${concurrency_file}" safe_jobs LIMIT_COUNT 1 REGEX "^[0-9]+$")
+        if(safe_jobs GREATER "0" AND safe_jobs LESS jobs)
+            message(STATUS "Limiting build to ${safe_jobs} jobs due to memory pressure in earlier builds")
+            set(jobs "${safe_jobs}")
+            set(limited_by_earlier_builds ON)
+        endif()
+    endif()
+    z_vcpkg_execute_build_process_set_jobs(command jobs_found "${jobs}" ${arg_COMMAND})
+
+    z_vcpkg_trace_ninja_log_length(ninja_log_length "${arg_WORKING_DIRECTORY}/.ninja_log")
+    z_vcpkg_trace_begin(trace)
+    z_vcpkg_execute_build_process_run(error_code governor_summary
+        "${arg_WORKING_DIRECTORY}" "${log_out}" "${log_err}" ${command})
     if (NOT error_code MATCHES "^[0-9]+$")
         list(JOIN arg_COMMAND " " command)
         message(FATAL_ERROR "Failed to execute command \"${command}\" in working directory \"${arg_WORKING_DIRECTORY}\": ${error_code}")
@@ -61,14 +371,44 @@ function(vcpkg_execute_build_process)
         file(READ "${log_out}" out_contents)
         file(READ "${log_err}" err_contents)
         set(all_contents "${out_contents}${err_contents}")
-        if(all_contents MATCHES "${Z_VCPKG_EXECUTE_BUILD_PROCESS_RETRY_ERROR_MESSAGES}")
+        # A job killed by the governor is reported differently by each compiler
+        if(all_contents MATCHES "${Z_VCPKG_EXECUTE_BUILD_PROCESS_RETRY_ERROR_MESSAGES}" OR governor_summary MATCHES "killed=[1-9]")
             message(WARNING "Please ensure your system has sufficient memory.")
             set(log_out "${log_prefix}-out-1.log")
             set(log_err "${log_prefix}-err-1.log")
-            list(APPEND all_logs "${log_out}" "${log_err}")
 
-            if(DEFINED arg_NO_PARALLEL_COMMAND)
+            if(jobs_found AND jobs GREATER "1")
+                # Back off stepwise instead of restarting at -j1 right away
+                set(backed_off ON)
+                set(iteration 1)
+                while(NOT error_code EQUAL "0" AND jobs GREATER "1" AND
+                      (all_contents MATCHES "${Z_VCPKG_EXECUTE_BUILD_PROCESS_RETRY_ERROR_MESSAGES}" OR governor_summary MATCHES "killed=[1-9]"))
+                    math(EXPR jobs "${jobs} / 2")
+                    set(log_out "${log_prefix}-out-${iteration}.log")
+                    set(log_err "${log_prefix}-err-${iteration}.log")
+                    list(APPEND all_logs "${log_out}" "${log_err}")
+                    if(jobs EQUAL "1" AND DEFINED arg_NO_PARALLEL_COMMAND)
+                        message(STATUS "Restarting build without parallelism")
+                        set(command ${arg_NO_PARALLEL_COMMAND})
+                    else()
+                        message(STATUS "Restarting build with ${jobs} jobs")
+                        z_vcpkg_execute_build_process_set_jobs(command jobs_found "${jobs}" ${arg_COMMAND})
+                    endif()
+                    z_vcpkg_execute_build_process_run(error_code governor_summary
+                        "${arg_WORKING_DIRECTORY}" "${log_out}" "${log_err}" ${command})
+                    if(NOT error_code EQUAL "0")
+                        file(READ "${log_out}" out_contents)
+                        file(READ "${log_err}" err_contents)
+                        set(all_contents "${out_contents}${err_contents}")
+                    endif()
+                    math(EXPR iteration "${iteration} + 1")
+                endwhile()
+                if(error_code EQUAL "0")
+                    file(WRITE "${concurrency_file}" "${jobs}\n")
+                endif()
+            elseif(DEFINED arg_NO_PARALLEL_COMMAND)
                 message(STATUS "Restarting build without parallelism")
+                list(APPEND all_logs "${log_out}" "${log_err}")
                 execute_process(
                     COMMAND ${arg_NO_PARALLEL_COMMAND}
                     WORKING_DIRECTORY "${arg_WORKING_DIRECTORY}"
@@ -78,6 +418,7 @@ function(vcpkg_execute_build_process)
                 )
             else()
                 message(STATUS "Restarting build")
+                list(APPEND all_logs "${log_out}" "${log_err}")
                 execute_process(
                     COMMAND ${arg_COMMAND}
                     WORKING_DIRECTORY "${arg_WORKING_DIRECTORY}"
@@ -117,6 +458,36 @@ function(vcpkg_execute_build_process)
         endif()
     endif()
 
+    if(arg_LOGNAME MATCHES "^install")
+        set(trace_category install)
+    else()
+        set(trace_category build)
+    endif()
+    set(peak_rss_mib "")
+    if(governor_summary MATCHES "peak_rss_mib=([0-9]+)")
+        set(peak_rss_mib "${CMAKE_MATCH_1}")
+    endif()
+    z_vcpkg_trace_end("${trace}" NAME "${arg_LOGNAME}" CATEGORY "${trace_category}" PEAK_RSS_MIB "${peak_rss_mib}"
+        ARGS jobs "${jobs}" exit_code "${error_code}")
+    z_vcpkg_trace_ninja_log("${trace}" "${arg_WORKING_DIRECTORY}/.ninja_log" "${ninja_log_length}")
+
+    # Remember the concurrency the governor had to fall back to
+    if(error_code EQUAL "0" AND governor_summary MATCHES "max_stopped=([1-9][0-9]*)")
+        math(EXPR safe_jobs "${jobs} - ${CMAKE_MATCH_1}")
+        if(safe_jobs LESS "1")
+            set(safe_jobs 1)
+        endif()
+        message(STATUS "Build was throttled due to memory pressure, using ${safe_jobs} jobs in the future")
+        file(WRITE "${concurrency_file}" "${safe_jobs}\n")
+    elseif(error_code EQUAL "0" AND limited_by_earlier_builds AND NOT backed_off)
+        math(EXPR next_jobs "${jobs} * 2")
+        if(next_jobs GREATER_EQUAL VCPKG_CONCURRENCY)
+            file(REMOVE "${concurrency_file}")
+        else()
+            file(WRITE "${concurrency_file}" "${next_jobs}\n")
+        endif()
+    endif()
+
     if(NOT error_code EQUAL "0")
         set(stringified_logs "")
         foreach(log IN LISTS all_logs)
@@ -139,3 +510,9 @@ function(vcpkg_execute_build_process)
         )
     endif()
 endfunction()
+
+# Governor mode, invoked by z_vcpkg_execute_build_process_run next to the build
+if(CMAKE_SCRIPT_MODE_FILE STREQUAL CMAKE_CURRENT_LIST_FILE AND DEFINED Z_VCPKG_BUILD_GOVERNOR_PID_FILE)
+    z_vcpkg_build_governor_watch("${Z_VCPKG_BUILD_GOVERNOR_PID_FILE}" "${Z_VCPKG_BUILD_GOVERNOR_SUMMARY_FILE}"
+        "${Z_VCPKG_BUILD_GOVERNOR_MAX_LINKS}" "${Z_VCPKG_BUILD_GOVERNOR_OBSERVE_ONLY}")
+endif()
@@ -7,6 +7,107 @@ function(z_vcpkg_extract_source_archive_deprecated_mode archive working_director
     endif()
 endfunction()
 
+# Pristine, already-patched source trees are kept in a store shared by all ports and
+# keyed by the archive and patch hashes. Enabled by setting X_VCPKG_SOURCE_CACHE_DIR.
+# Entries of the store and the buildtrees checked out of it are always real copies or reflinks:
+# portfiles and --editable builds modify their sources in place, which must never reach the store.
+function(z_vcpkg_extract_source_archive_copy_tree from to)
+    if(DEFINED X_VCPKG_SOURCE_CACHE_LINK_MODE)
+        set(mode "${X_VCPKG_SOURCE_CACHE_LINK_MODE}")
+    else()
+        set(mode "auto")
+    endif()
+    if(NOT mode MATCHES "^(auto|reflink|copy)$")
+        message(FATAL_ERROR "X_VCPKG_SOURCE_CACHE_LINK_MODE (${mode}) must be one of auto, reflink or copy")
+    endif()
+
+    set(cp_command "")
+    if(mode MATCHES "^(auto|reflink)$" AND CMAKE_HOST_SYSTEM_NAME STREQUAL "Linux")
+        set(cp_command cp -a --reflink=always)
+    elseif(mode MATCHES "^(auto|reflink)$" AND CMAKE_HOST_SYSTEM_NAME STREQUAL "Darwin")
+        set(cp_command cp -cpR)
+    endif()
+
+    cmake_path(GET to PARENT_PATH parent_directory)
+    file(MAKE_DIRECTORY "${parent_directory}")
+    if(NOT cp_command STREQUAL "")
+        execute_process(
+            COMMAND ${cp_command} "${from}" "${to}"
+            RESULT_VARIABLE error_code
+            OUTPUT_QUIET
+            ERROR_QUIET
+        )
+        if(error_code EQUAL "0")
+            return()
+        endif()
+        debug_message("'${cp_command}' is not supported for ${to}, falling back to a plain copy")
+        file(REMOVE_RECURSE "${to}")
+    endif()
+
+    file(MAKE_DIRECTORY "${to}")
+    file(COPY "${from}/" DESTINATION "${to}")
+endfunction()
+
+function(z_vcpkg_extract_source_archive_directory_size out_var directory)
+    set(size 0)
+    find_program(du_command du NO_CACHE)
+    if(du_command AND NOT CMAKE_HOST_WIN32)
+        execute_process(
+            COMMAND "${du_command}" -sk "${directory}"
+            OUTPUT_VARIABLE du_output
+            RESULT_VARIABLE error_code
+            ERROR_QUIET
+        )
+        if(error_code EQUAL "0" AND du_output MATCHES "^([0-9]+)")
+            math(EXPR size "${CMAKE_MATCH_1} / 1024")
+            set("${out_var}" "${size}" PARENT_SCOPE)
+            return()
+        endif()
+    endif()
+
+    file(GLOB_RECURSE files LIST_DIRECTORIES false "${directory}/*")
+    set(size_bytes 0)
+    foreach(file IN LISTS files)
+        file(SIZE "${file}" file_size)
+        math(EXPR size_bytes "${size_bytes} + ${file_size}")
+    endforeach()
+    math(EXPR size "${size_bytes} / 1048576")
+    set("${out_var}" "${size}" PARENT_SCOPE)
+endfunction()
+
+# Removes the least recently used entries until the store fits X_VCPKG_SOURCE_CACHE_MAX_SIZE (in MiB).
+function(z_vcpkg_extract_source_archive_evict cache_dir)
+    if(DEFINED X_VCPKG_SOURCE_CACHE_MAX_SIZE)
+        set(max_size "${X_VCPKG_SOURCE_CACHE_MAX_SIZE}")
+    else()
+        set(max_size 20480)
+    endif()
+
+    file(GLOB entries LIST_DIRECTORIES true "${cache_dir}/*")
+    set(sortable_entries "")
+    # Entries which are being populated by another process are named <key>.<random>.tmp
+    list(FILTER entries EXCLUDE REGEX "\\.tmp\$")
+    foreach(entry IN LISTS entries)
+        if(EXISTS "${entry}/size.txt" AND EXISTS "${entry}/last-used")
+            file(TIMESTAMP "${entry}/last-used" last_used "%Y%m%d%H%M%S" UTC)
+            list(APPEND sortable_entries "${last_used}|${entry}")
+        endif()
+    endforeach()
+    list(SORT sortable_entries ORDER DESCENDING)
+
+    set(total_size 0)
+    foreach(sortable_entry IN LISTS sortable_entries)
+        string(REGEX REPLACE "^[^|]*\\|" "" entry "${sortable_entry}")
+        file(READ "${entry}/size.txt" entry_size)
+        string(STRIP "${entry_size}" entry_size)
+        math(EXPR total_size "${total_size} + ${entry_size}")
+        if(total_size GREATER max_size)
+            debug_message("Evicting cached source tree ${entry}")
+            file(REMOVE_RECURSE "${entry}")
+        endif()
+    endforeach()
+endfunction()
+
 function(vcpkg_extract_source_archive)
     if(ARGC LESS_EQUAL "2")
         z_vcpkg_deprecation_message( "Deprecated form of vcpkg_extract_source_archive used:
@@ -82,7 +183,7 @@ function(vcpkg_extract_source_archive)
     endif()
 
     # Hash the archive hash along with the patches. Take the first 10 chars of the hash
-    file(SHA512 "${arg_ARCHIVE}" patchset_hash)
+    z_vcpkg_file_sha512(patchset_hash "${arg_ARCHIVE}")
     foreach(patch IN LISTS arg_PATCHES)
         cmake_path(ABSOLUTE_PATH patch
             BASE_DIRECTORY "${CURRENT_PORT_DIR}"
@@ -91,11 +192,18 @@ function(vcpkg_extract_source_archive)
         if(NOT EXISTS "${absolute_patch}")
             message(FATAL_ERROR "Could not find patch: '${patch}'")
         endif()
-        file(SHA512 "${absolute_patch}" current_hash)
+        z_vcpkg_file_sha512(current_hash "${absolute_patch}")
         string(APPEND patchset_hash "${current_hash}")
     endforeach()
 
     string(SHA512 patchset_hash "${patchset_hash}")
+    set(source_cache_entry "")
+    if(DEFINED X_VCPKG_SOURCE_CACHE_DIR)
+        # The cached tree also depends on how the archive is unwrapped and whether patches may fail
+        string(SHA512 source_cache_key "${patchset_hash};${arg_NO_REMOVE_ONE_LEVEL};${arg_SKIP_PATCH_CHECK}")
+        string(SUBSTRING "${source_cache_key}" 0 32 source_cache_key)
+        set(source_cache_entry "${X_VCPKG_SOURCE_CACHE_DIR}/${source_cache_key}")
+    endif()
     string(SUBSTRING "${patchset_hash}" 0 10 patchset_hash)
     cmake_path(APPEND working_directory "${arg_SOURCE_BASE}-${patchset_hash}"
         OUTPUT_VARIABLE source_path
@@ -113,16 +221,30 @@ function(vcpkg_extract_source_archive)
         endif()
     endif()
 
+    if(NOT source_cache_entry STREQUAL "" AND EXISTS "${source_cache_entry}/size.txt")
+        message(STATUS "Using cached source tree for ${arg_ARCHIVE}")
+        z_vcpkg_trace_begin(trace)
+        z_vcpkg_extract_source_archive_copy_tree("${source_cache_entry}/src" "${source_path}")
+        file(TOUCH "${source_cache_entry}/last-used")
+        z_vcpkg_trace_end("${trace}" NAME "extract ${arg_SOURCE_BASE}" CATEGORY extract ARGS cached ON)
+
+        set("${out_source_path}" "${source_path}" PARENT_SCOPE)
+        message(STATUS "Using source at ${source_path}")
+        return()
+    endif()
+
     message(STATUS "Extracting source ${arg_ARCHIVE}")
     cmake_path(APPEND_STRING source_path ".tmp" OUTPUT_VARIABLE temp_dir)
     file(REMOVE_RECURSE "${temp_dir}")
     file(MAKE_DIRECTORY "${temp_dir}")
+    z_vcpkg_trace_begin(trace)
     vcpkg_execute_required_process(
         ALLOW_IN_DOWNLOAD_MODE
         COMMAND "${CMAKE_COMMAND}" -E tar xjf "${arg_ARCHIVE}"
         WORKING_DIRECTORY "${temp_dir}"
         LOGNAME extract
     )
+    z_vcpkg_trace_end("${trace}" NAME "extract ${arg_SOURCE_BASE}" CATEGORY extract ARGS cached OFF)
 
     if(arg_NO_REMOVE_ONE_LEVEL)
         cmake_path(SET temp_source_path "${temp_dir}")
@@ -150,6 +272,23 @@ function(vcpkg_extract_source_archive)
         ${quiet_param}
     )
 
+    if(NOT source_cache_entry STREQUAL "")
+        # Populate a temporary entry and rename it so that concurrent builds never see partial trees
+        string(RANDOM LENGTH 8 temp_suffix)
+        set(temp_entry "${source_cache_entry}.${temp_suffix}.tmp")
+        file(REMOVE_RECURSE "${temp_entry}")
+        z_vcpkg_extract_source_archive_copy_tree("${temp_source_path}" "${temp_entry}/src")
+        z_vcpkg_extract_source_archive_directory_size(entry_size "${temp_entry}/src")
+        file(WRITE "${temp_entry}/size.txt" "${entry_size}\n")
+        file(TOUCH "${temp_entry}/last-used")
+        file(REMOVE_RECURSE "${source_cache_entry}")
+        file(RENAME "${temp_entry}" "${source_cache_entry}" RESULT rename_result)
+        if(NOT rename_result EQUAL "0")
+            file(REMOVE_RECURSE "${temp_entry}")
+        endif()
+        z_vcpkg_extract_source_archive_evict("${X_VCPKG_SOURCE_CACHE_DIR}")
+    endif()
+
     file(RENAME "${temp_source_path}" "${source_path}")
     file(REMOVE_RECURSE "${temp_dir}")
 
@@ -1,7 +1,7 @@
 function(z_vcpkg_find_acquire_program_version_check out_var)
     cmake_parse_arguments(PARSE_ARGV 1 arg
         "EXACT_VERSION_MATCH"
-        "MIN_VERSION;PROGRAM_NAME"
+        "MIN_VERSION;PROGRAM_NAME;OUT_VERSION"
         "COMMAND"
     )
     vcpkg_execute_in_download_mode(
@@ -10,6 +10,9 @@ function(z_vcpkg_find_acquire_program_version_check out_var)
         OUTPUT_VARIABLE program_version_output
     )
     string(STRIP "${program_version_output}" program_version_output)
+    if(DEFINED arg_OUT_VERSION)
+        set("${arg_OUT_VERSION}" "${program_version_output}" PARENT_SCOPE)
+    endif()
     #TODO: REGEX MATCH case for more complex cases!
     set(version_compare VERSION_GREATER_EQUAL)
     set(version_compare_msg "at least")
@@ -26,15 +29,94 @@ function(z_vcpkg_find_acquire_program_version_check out_var)
     endif()
 endfunction()
 
+# Registry of resolved tools in downloads/tools/tool-registry, shared by all port builds.
+# An entry is keyed by the program, the required version, the host and the program information
+# file, and is used only while every file it names has the recorded size and modification time.
+# Tools found outside of downloads/tools also record the version they reported, so that it is
+# reported again when the entry is reused. X_VCPKG_NO_TOOL_REGISTRY disables the registry.
+set(Z_VCPKG_FIND_ACQUIRE_PROGRAM_REGISTRY_FORMAT 1)
+
+function(z_vcpkg_find_acquire_program_registry_path out_var program key_data)
+    set(entry "")
+    if(NOT X_VCPKG_NO_TOOL_REGISTRY AND DEFINED DOWNLOADS)
+        cmake_host_system_information(RESULT host QUERY HOSTNAME OS_NAME OS_PLATFORM)
+        string(SHA512 key "${Z_VCPKG_FIND_ACQUIRE_PROGRAM_REGISTRY_FORMAT};${program};${key_data};${host}")
+        string(SUBSTRING "${key}" 0 32 key)
+        set(entry "${DOWNLOADS}/tools/tool-registry/${program}-${key}.txt")
+    endif()
+    set("${out_var}" "${entry}" PARENT_SCOPE)
+endfunction()
+
+# Size and modification time of each file in `value`, which may be an interpreter followed by a script
+function(z_vcpkg_find_acquire_program_registry_fingerprint out_var value)
+    set(fingerprint "")
+    foreach(item IN LISTS value)
+        if(IS_ABSOLUTE "${item}" AND EXISTS "${item}" AND NOT IS_DIRECTORY "${item}")
+            file(SIZE "${item}" size)
+            file(TIMESTAMP "${item}" mtime "%s%f" UTC)
+            string(APPEND fingerprint "${item}|${size}|${mtime}\n")
+        elseif(IS_ABSOLUTE "${item}")
+            # A file which disappeared never matches
+            string(APPEND fingerprint "${item}|missing\n")
+        endif()
+    endforeach()
+    set("${out_var}" "${fingerprint}" PARENT_SCOPE)
+endfunction()
+
+# The value stored in `entry` if it is still valid, otherwise "".
+# OUT_VERSION receives the recorded version of a tool found outside of downloads/tools.
+function(z_vcpkg_find_acquire_program_registry_lookup out_var entry)
+    cmake_parse_arguments(PARSE_ARGV 2 arg "" "OUT_VERSION" "")
+    set("${out_var}" "" PARENT_SCOPE)
+    if(DEFINED arg_OUT_VERSION)
+        set("${arg_OUT_VERSION}" "" PARENT_SCOPE)
+    endif()
+    if(entry STREQUAL "" OR NOT EXISTS "${entry}")
+        return()
+    endif()
+    file(READ "${entry}" contents)
+    if(NOT contents MATCHES "^value=([^\n]*)\nversion=([^\n]*)\nfingerprint=(.*)\$")
+        return()
+    endif()
+    set(value "${CMAKE_MATCH_1}")
+    set(version "${CMAKE_MATCH_2}")
+    set(recorded_fingerprint "${CMAKE_MATCH_3}")
+    z_vcpkg_find_acquire_program_registry_fingerprint(fingerprint "${value}")
+    if(fingerprint STREQUAL "" OR NOT fingerprint STREQUAL recorded_fingerprint)
+        return()
+    endif()
+    set("${out_var}" "${value}" PARENT_SCOPE)
+    if(DEFINED arg_OUT_VERSION)
+        set("${arg_OUT_VERSION}" "${version}" PARENT_SCOPE)
+    endif()
+endfunction()
+
+# Records `value` in `entry`; `version` is the version reported by a tool found outside of downloads/tools
+function(z_vcpkg_find_acquire_program_registry_store entry value version)
+    if(entry STREQUAL "")
+        return()
+    endif()
+    z_vcpkg_find_acquire_program_registry_fingerprint(fingerprint "${value}")
+    if(fingerprint STREQUAL "")
+        # Nothing to validate, e.g. a program name without a path
+        return()
+    endif()
+    string(REPLACE "\n" " " version "${version}")
+    string(RANDOM LENGTH 8 temp_suffix)
+    file(WRITE "${entry}.${temp_suffix}.tmp" "value=${value}\nversion=${version}\nfingerprint=${fingerprint}")
+    file(RENAME "${entry}.${temp_suffix}.tmp" "${entry}")
+endfunction()
+
 function(z_vcpkg_find_acquire_program_find_external program)
     cmake_parse_arguments(PARSE_ARGV 1 arg
         "EXACT_VERSION_MATCH"
-        "INTERPRETER;MIN_VERSION;PROGRAM_NAME"
+        "INTERPRETER;MIN_VERSION;PROGRAM_NAME;OUT_VERSION"
         "NAMES;VERSION_COMMAND"
     )
     if(arg_EXACT_VERSION_MATCH)
         set(arg_EXACT_VERSION_MATCH EXACT_VERSION_MATCH)
     endif()
+    set(program_version "")
 
     if("${arg_INTERPRETER}" STREQUAL "")
         find_program("${program}" NAMES ${arg_NAMES})
@@ -57,6 +139,7 @@ function(z_vcpkg_find_acquire_program_find_external program)
             COMMAND ${${program}} ${arg_VERSION_COMMAND}
             MIN_VERSION "${arg_MIN_VERSION}"
             PROGRAM_NAME "${arg_PROGRAM_NAME}"
+            OUT_VERSION program_version
         )
     endif()
 
@@ -64,6 +147,9 @@ function(z_vcpkg_find_acquire_program_find_external program)
         unset("${program}" PARENT_SCOPE)
         unset("${program}" CACHE)
     endif()
+    if(DEFINED arg_OUT_VERSION)
+        set("${arg_OUT_VERSION}" "${program_version}" PARENT_SCOPE)
+    endif()
 endfunction()
 
 function(z_vcpkg_find_acquire_program_find_internal program)
@@ -140,6 +226,24 @@ function(vcpkg_find_acquire_program program)
         set(search_names "${program_name}")
     endif()
 
+    # Another port may have resolved the tool already
+    file(SHA1 "${program_information}" information_hash)
+    z_vcpkg_find_acquire_program_registry_path(registry_entry "${program}"
+        "${program_version};${extra_search_args};${information_hash}")
+    z_vcpkg_find_acquire_program_registry_lookup(registry_value "${registry_entry}" OUT_VERSION registry_version)
+    if(NOT registry_value STREQUAL "")
+        if(NOT registry_version STREQUAL "")
+            message(STATUS "Found external ${program_name}('${registry_version}').")
+        endif()
+        if(NOT "${interpreter}" STREQUAL "")
+            vcpkg_find_acquire_program("${interpreter}")
+        endif()
+        set("${program}" "${registry_value}" CACHE INTERNAL "")
+        set("${program}" "${registry_value}" PARENT_SCOPE)
+        return()
+    endif()
+
+    set(external_version "")
     z_vcpkg_find_acquire_program_find_internal("${program}"
         INTERPRETER "${interpreter}"
         PATHS ${paths_to_search}
@@ -153,6 +257,7 @@ function(vcpkg_find_acquire_program program)
             INTERPRETER "${interpreter}"
             NAMES ${search_names}
             VERSION_COMMAND ${version_command}
+            OUT_VERSION external_version
         )
     endif()
     if(NOT ${program})
@@ -230,7 +335,9 @@ function(vcpkg_find_acquire_program program)
         if(NOT ${program})
             message(FATAL_ERROR "Unable to find ${program}")
         endif()
+        set(external_version "")
     endif()
 
+    z_vcpkg_find_acquire_program_registry_store("${registry_entry}" "${${program}}" "${external_version}")
     set("${program}" "${${program}}" PARENT_SCOPE)
 endfunction()
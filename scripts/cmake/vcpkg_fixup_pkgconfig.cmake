@@ -168,6 +168,7 @@ function(vcpkg_fixup_pkgconfig)
         endforeach()
     endif()
 
+    z_vcpkg_trace_begin(trace)
     foreach(config IN ITEMS RELEASE DEBUG)
         debug_message("${config} Files: ${arg_${config}_FILES}")
         if("${VCPKG_BUILD_TYPE}" STREQUAL "release" AND "${config}" STREQUAL "DEBUG")
@@ -198,6 +199,7 @@ function(vcpkg_fixup_pkgconfig)
         endif()
     endforeach()
     debug_message("Fixing pkgconfig --- finished")
+    z_vcpkg_trace_end("${trace}" NAME "fixup pkgconfig" CATEGORY fixup)
 
     set(Z_VCPKG_FIXUP_PKGCONFIG_CALLED TRUE CACHE INTERNAL "See below" FORCE)
     # Variable to check if this function has been called!
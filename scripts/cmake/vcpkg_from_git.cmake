@@ -33,6 +33,7 @@ function(vcpkg_from_git)
     vcpkg_list(SET skip_patch_check_param)
     set(git_working_directory "${DOWNLOADS}/git-tmp")
     set(do_download OFF)
+    set(store_key "")
 
     if(VCPKG_USE_HEAD_VERSION AND DEFINED arg_HEAD_REF)
         vcpkg_list(SET working_directory_param "WORKING_DIRECTORY" "${CURRENT_BUILDTREES_DIR}/src/head")
@@ -60,11 +61,20 @@ function(vcpkg_from_git)
             set(ref_to_fetch "${arg_REF}")
         endif()
         string(REPLACE "/" "_-" sanitized_ref "${arg_REF}")
+        # REF is a commit, so the archive of another port which uses the same commit has the same contents
+        set(store_key "${arg_REF}")
+        if(arg_LFS)
+            string(APPEND store_key "-lfs")
+        endif()
     endif()
 
     set(temp_archive "${DOWNLOADS}/temp/${PORT}-${sanitized_ref}.tar.gz")
     set(archive "${DOWNLOADS}/${PORT}-${sanitized_ref}.tar.gz")
 
+    if(NOT store_key STREQUAL "")
+        z_vcpkg_download_store_lookup(found_in_store "${archive}" git "${store_key}")
+    endif()
+
     if(NOT EXISTS "${archive}")
         if(_VCPKG_NO_DOWNLOADS)
             message(FATAL_ERROR "Downloads are disabled, but '${archive}' does not exist.")
@@ -174,6 +184,9 @@ SHA is in the history. For example, you may be able to fix this error by changin
     else()
         message(STATUS "Using cached ${archive}")
     endif()
+    if(NOT store_key STREQUAL "")
+        z_vcpkg_download_store_add("${archive}" git "${store_key}")
+    endif()
 
     vcpkg_extract_source_archive_ex(
         OUT_SOURCE_PATH SOURCE_PATH
@@ -13,6 +13,7 @@ function(z_vcpkg_apply_patches)
     endif()
 
     set(ENV{GIT_CONFIG_NOSYSTEM} 1)
+    z_vcpkg_trace_begin(trace)
     set(patchnum 0)
     foreach(patch IN LISTS arg_PATCHES)
         get_filename_component(absolute_patch "${patch}" ABSOLUTE BASE_DIR "${CURRENT_PORT_DIR}")
@@ -37,6 +38,9 @@ function(z_vcpkg_apply_patches)
 
         math(EXPR patchnum "${patchnum} + 1")
     endforeach()
+    if(NOT patchnum EQUAL "0")
+        z_vcpkg_trace_end("${trace}" NAME "patch" CATEGORY patch ARGS patches "${patchnum}")
+    endif()
     if(DEFINED git_config_nosystem_backup)
         set(ENV{GIT_CONFIG_NOSYSTEM} "${git_config_nosystem_backup}")
     else()
@@ -0,0 +1,200 @@
+# Compiler cache for all build systems, enabled by X_VCPKG_COMPILER_CACHE: ccache, sccache or the path to one of them.
+# Objects are stored in X_VCPKG_COMPILER_CACHE_DIR, by default in downloads/tools/compiler-cache.
+# With X_VCPKG_COMPILER_CACHE_PREFIX_MAP, the location of the vcpkg root is mapped to "." in the debug
+# information, so that objects can be shared between vcpkg roots.
+# The hit statistics of each port are written to buildtrees/<port>/compiler-cache-<triplet>.json.
+
+# The deepest directory containing all of the given directories, or "" if that is a root directory
+function(z_vcpkg_compiler_cache_common_directory out_var)
+    set(common "")
+    foreach(dir IN LISTS ARGN)
+        string(REGEX REPLACE "(.)/+\$" "\\1" dir "${dir}")
+        if(common STREQUAL "")
+            set(common "${dir}")
+            continue()
+        endif()
+        while(NOT common STREQUAL "")
+            cmake_path(IS_PREFIX common "${dir}" NORMALIZE is_prefix)
+            if(is_prefix)
+                break()
+            endif()
+            cmake_path(GET common PARENT_PATH parent)
+            if(parent STREQUAL common) # different drives
+                set(parent "")
+            endif()
+            set(common "${parent}")
+        endwhile()
+        if(common STREQUAL "")
+            break()
+        endif()
+    endforeach()
+    cmake_path(HAS_RELATIVE_PART common has_relative_part)
+    if(NOT has_relative_part)
+        set(common "")
+    endif()
+    set("${out_var}" "${common}" PARENT_SCOPE)
+endfunction()
+
+# Counts the compilations recorded in a ccache stats log, see `stats_log` in the ccache manual
+function(z_vcpkg_compiler_cache_ccache_stats out_hits out_misses out_uncacheable stats_log)
+    set(hits 0)
+    set(misses 0)
+    set(uncacheable 0)
+    set(results "")
+    if(EXISTS "${stats_log}")
+        file(STRINGS "${stats_log}" lines)
+        # Every compilation starts with a `# <source file>` line, followed by its counters
+        list(APPEND lines "#")
+        set(result "")
+        foreach(line IN LISTS lines)
+            if(line MATCHES "^#")
+                list(APPEND results "${result}")
+                set(result "none")
+            elseif(line MATCHES "^(direct|preprocessed)_cache_hit\$")
+                set(result "hit")
+            elseif(line STREQUAL "cache_miss" AND NOT result STREQUAL "hit")
+                set(result "miss")
+            endif()
+        endforeach()
+    endif()
+    foreach(result IN LISTS results)
+        if(result STREQUAL "hit")
+            math(EXPR hits "${hits} + 1")
+        elseif(result STREQUAL "miss")
+            math(EXPR misses "${misses} + 1")
+        elseif(result STREQUAL "none")
+            math(EXPR uncacheable "${uncacheable} + 1")
+        endif()
+    endforeach()
+    set("${out_hits}" "${hits}" PARENT_SCOPE)
+    set("${out_misses}" "${misses}" PARENT_SCOPE)
+    set("${out_uncacheable}" "${uncacheable}" PARENT_SCOPE)
+endfunction()
+
+# The counters of the sccache server as "<hits>;<misses>;<uncacheable>"
+function(z_vcpkg_compiler_cache_sccache_stats out_var)
+    set(stats "0;0;0")
+    execute_process(
+        COMMAND "${Z_VCPKG_COMPILER_LAUNCHER}" --show-stats --stats-format=json
+        OUTPUT_VARIABLE json
+        ERROR_QUIET
+        RESULT_VARIABLE error_code
+    )
+    if(error_code EQUAL "0")
+        set(stats "")
+        foreach(counter IN ITEMS cache_hits cache_misses)
+            set(sum 0)
+            string(JSON counts ERROR_VARIABLE json_error GET "${json}" stats "${counter}" counts)
+            if(NOT json_error)
+                string(JSON length LENGTH "${counts}")
+                if(length GREATER "0")
+                    math(EXPR last "${length} - 1")
+                    foreach(index RANGE "${last}")
+                        string(JSON language MEMBER "${counts}" "${index}")
+                        string(JSON count GET "${counts}" "${language}")
+                        math(EXPR sum "${sum} + ${count}")
+                    endforeach()
+                endif()
+            endif()
+            list(APPEND stats "${sum}")
+        endforeach()
+        string(JSON uncacheable ERROR_VARIABLE json_error GET "${json}" stats non_cacheable_compilations)
+        if(json_error)
+            set(uncacheable 0)
+        endif()
+        list(APPEND stats "${uncacheable}")
+    endif()
+    set("${out_var}" "${stats}" PARENT_SCOPE)
+endfunction()
+
+function(z_vcpkg_compiler_cache_setup)
+    set(Z_VCPKG_COMPILER_LAUNCHER "" PARENT_SCOPE)
+    if("${X_VCPKG_COMPILER_CACHE}" STREQUAL "")
+        return()
+    endif()
+    find_program(Z_VCPKG_COMPILER_CACHE_PROGRAM NAMES "${X_VCPKG_COMPILER_CACHE}")
+    if(NOT Z_VCPKG_COMPILER_CACHE_PROGRAM)
+        message(WARNING "Could not find the compiler cache ${X_VCPKG_COMPILER_CACHE} (X_VCPKG_COMPILER_CACHE), building without it.")
+        return()
+    endif()
+    set(launcher "${Z_VCPKG_COMPILER_CACHE_PROGRAM}")
+    cmake_path(GET launcher STEM flavor)
+    string(TOLOWER "${flavor}" flavor)
+    if(DEFINED X_VCPKG_COMPILER_CACHE_DIR)
+        set(cache_dir "${X_VCPKG_COMPILER_CACHE_DIR}")
+    else()
+        set(cache_dir "${DOWNLOADS}/tools/compiler-cache")
+    endif()
+
+    # Paths below base_dir are rewritten by ccache. Only with the debug prefix map, which changes the
+    # debug information of every port, do cache hits also not depend on the build directory.
+    cmake_path(GET CURRENT_BUILDTREES_DIR PARENT_PATH buildtrees_dir)
+    z_vcpkg_compiler_cache_common_directory(base_dir "${buildtrees_dir}" "${CURRENT_INSTALLED_DIR}" "${CURRENT_PACKAGES_DIR}")
+    if(base_dir STREQUAL "")
+        set(base_dir "${CURRENT_BUILDTREES_DIR}")
+    endif()
+    set(prefix_map OFF)
+    if(X_VCPKG_COMPILER_CACHE_PREFIX_MAP AND NOT (VCPKG_TARGET_IS_WINDOWS AND NOT VCPKG_TARGET_IS_MINGW) AND NOT base_dir MATCHES " ")
+        set(prefix_map ON)
+        string(APPEND VCPKG_C_FLAGS " -fdebug-prefix-map=${base_dir}=.")
+        string(APPEND VCPKG_CXX_FLAGS " -fdebug-prefix-map=${base_dir}=.")
+        set(VCPKG_C_FLAGS "${VCPKG_C_FLAGS}" PARENT_SCOPE)
+        set(VCPKG_CXX_FLAGS "${VCPKG_CXX_FLAGS}" PARENT_SCOPE)
+    endif()
+
+    set(stats_log "${CURRENT_BUILDTREES_DIR}/compiler-cache-${TARGET_TRIPLET}.stats.log")
+    file(REMOVE "${stats_log}")
+    if(flavor STREQUAL "ccache")
+        set(ENV{CCACHE_DIR} "${cache_dir}")
+        set(ENV{CCACHE_BASEDIR} "${base_dir}")
+        if(prefix_map)
+            set(ENV{CCACHE_NOHASHDIR} "1")
+        endif()
+        set(ENV{CCACHE_STATSLOG} "${stats_log}")
+    elseif(flavor STREQUAL "sccache")
+        set(ENV{SCCACHE_DIR} "${cache_dir}")
+    endif()
+
+    # CMake 3.17 and newer use these as the default of CMAKE_<LANG>_COMPILER_LAUNCHER
+    foreach(lang IN ITEMS C CXX)
+        if(NOT DEFINED ENV{CMAKE_${lang}_COMPILER_LAUNCHER})
+            set(ENV{CMAKE_${lang}_COMPILER_LAUNCHER} "${launcher}")
+        endif()
+    endforeach()
+
+    set(Z_VCPKG_COMPILER_LAUNCHER "${launcher}" PARENT_SCOPE)
+    set(Z_VCPKG_COMPILER_CACHE_FLAVOR "${flavor}" PARENT_SCOPE)
+    if(flavor STREQUAL "sccache")
+        set(Z_VCPKG_COMPILER_LAUNCHER "${launcher}")
+        z_vcpkg_compiler_cache_sccache_stats(stats)
+        set(Z_VCPKG_COMPILER_CACHE_INITIAL_STATS "${stats}" PARENT_SCOPE)
+    endif()
+    message(STATUS "Using compiler cache ${launcher}")
+endfunction()
+
+function(z_vcpkg_compiler_cache_report)
+    if("${Z_VCPKG_COMPILER_LAUNCHER}" STREQUAL "")
+        return()
+    endif()
+    if(Z_VCPKG_COMPILER_CACHE_FLAVOR STREQUAL "ccache")
+        z_vcpkg_compiler_cache_ccache_stats(hits misses uncacheable "${CURRENT_BUILDTREES_DIR}/compiler-cache-${TARGET_TRIPLET}.stats.log")
+    elseif(Z_VCPKG_COMPILER_CACHE_FLAVOR STREQUAL "sccache")
+        # The sccache server is shared, so concurrent builds are counted as well
+        z_vcpkg_compiler_cache_sccache_stats(stats)
+        foreach(initial current IN ZIP_LISTS Z_VCPKG_COMPILER_CACHE_INITIAL_STATS stats)
+            math(EXPR difference "${current} - ${initial}")
+            list(APPEND differences "${difference}")
+        endforeach()
+        list(GET differences 0 hits)
+        list(GET differences 1 misses)
+        list(GET differences 2 uncacheable)
+    else()
+        return()
+    endif()
+
+    message(STATUS "Compiler cache: ${hits} hits, ${misses} misses, ${uncacheable} not cacheable")
+    z_vcpkg_trace_json_string(port "${PORT}")
+    z_vcpkg_trace_json_string(triplet "${TARGET_TRIPLET}")
+    file(WRITE "${CURRENT_BUILDTREES_DIR}/compiler-cache-${TARGET_TRIPLET}.json"
+        "{\"port\": ${port}, \"triplet\": ${triplet}, \"hits\": ${hits}, \"misses\": ${misses}, \"uncacheable\": ${uncacheable}}\n")
+endfunction()
@@ -0,0 +1,176 @@
+# Content-addressed store of downloads in downloads/tools/download-store.
+# Blobs are named by their SHA512 (sha512/<hash>) or, for archives created from a git commit,
+# by the commit (git/<commit>.tar.gz). The files in downloads/ are hard links to the blobs,
+# so a source which several ports or forks download under different names is fetched and stored once.
+# Every blob has a <blob>.used stamp and a <blob>.names list; blobs which have not been used for
+# X_VCPKG_DOWNLOAD_STORE_MAX_AGE days (default 90) are removed together with their names.
+# X_VCPKG_NO_DOWNLOAD_STORE disables the store.
+
+# Path of the blob for `key`, or "" if the store is disabled or the key cannot address a blob
+function(z_vcpkg_download_store_blob_path out_var kind key)
+    set(blob "")
+    string(TOLOWER "${key}" key)
+    if(NOT X_VCPKG_NO_DOWNLOAD_STORE AND DEFINED DOWNLOADS)
+        if(kind STREQUAL "sha512" AND key MATCHES "^[0-9a-f]+\$" AND NOT key MATCHES "^0+\$")
+            string(LENGTH "${key}" key_length)
+            if(key_length EQUAL "128")
+                set(blob "${DOWNLOADS}/tools/download-store/sha512/${key}")
+            endif()
+        elseif(kind STREQUAL "git" AND key MATCHES "^[0-9a-f]+(-lfs)?\$")
+            set(blob "${DOWNLOADS}/tools/download-store/git/${key}.tar.gz")
+        elseif(NOT kind MATCHES "^(sha512|git)\$")
+            message(FATAL_ERROR "Unknown download store kind: ${kind}")
+        endif()
+    endif()
+    set("${out_var}" "${blob}" PARENT_SCOPE)
+endfunction()
+
+# Replaces `link` by a hard link to `target`, or by a copy where hard links are not supported.
+# With NO_COPY, `link` is left alone where hard links are not supported.
+function(z_vcpkg_download_store_link out_ok target link)
+    cmake_parse_arguments(PARSE_ARGV 3 arg "NO_COPY" "" "")
+    set(copy_on_error COPY_ON_ERROR)
+    if(arg_NO_COPY)
+        set(copy_on_error "")
+    endif()
+    get_filename_component(link_dir "${link}" DIRECTORY)
+    file(MAKE_DIRECTORY "${link_dir}")
+    string(RANDOM LENGTH 8 temp_suffix)
+    file(CREATE_LINK "${target}" "${link}.${temp_suffix}.tmp" RESULT result ${copy_on_error})
+    if(result EQUAL "0")
+        file(RENAME "${link}.${temp_suffix}.tmp" "${link}")
+        set("${out_ok}" ON PARENT_SCOPE)
+    else()
+        file(REMOVE "${link}.${temp_suffix}.tmp")
+        set("${out_ok}" OFF PARENT_SCOPE)
+    endif()
+endfunction()
+
+# Sets out_var to ON if `file` has the contents of `blob`, whether it is a link to the blob or a copy.
+# The hashes are memoized, so this is cheap for files which do not change.
+function(z_vcpkg_download_store_same_contents out_var file blob)
+    set(same OFF)
+    file(SIZE "${file}" file_size)
+    file(SIZE "${blob}" blob_size)
+    if(file_size EQUAL blob_size)
+        z_vcpkg_file_sha512(blob_sha512 "${blob}")
+        z_vcpkg_file_sha512(file_sha512 "${file}" EXPECTED "${blob_sha512}")
+        if(file_sha512 STREQUAL blob_sha512)
+            set(same ON)
+        endif()
+    endif()
+    set("${out_var}" "${same}" PARENT_SCOPE)
+endfunction()
+
+# Marks `blob` as used now by `file`
+function(z_vcpkg_download_store_use blob file)
+    file(TOUCH "${blob}.used")
+    cmake_path(RELATIVE_PATH file BASE_DIRECTORY "${DOWNLOADS}" OUTPUT_VARIABLE name)
+    set(names "")
+    if(EXISTS "${blob}.names")
+        file(STRINGS "${blob}.names" names)
+    endif()
+    if(NOT name IN_LIST names)
+        file(APPEND "${blob}.names" "${name}\n")
+    endif()
+endfunction()
+
+# Creates `file` from the store if it holds a blob for `key`; sets out_found to ON in that case.
+# Nothing is done if `file` exists already.
+function(z_vcpkg_download_store_lookup out_found file kind key)
+    set("${out_found}" OFF PARENT_SCOPE)
+    z_vcpkg_download_store_blob_path(blob "${kind}" "${key}")
+    if(blob STREQUAL "" OR EXISTS "${file}" OR NOT EXISTS "${blob}")
+        return()
+    endif()
+    z_vcpkg_download_store_link(ok "${blob}" "${file}")
+    if(NOT ok)
+        return()
+    endif()
+    z_vcpkg_download_store_use("${blob}" "${file}")
+    if(kind STREQUAL "sha512")
+        z_vcpkg_file_sha512_remember("${file}" "${key}")
+    endif()
+    set("${out_found}" ON PARENT_SCOPE)
+endfunction()
+
+# Adds the verified `file` to the store as the blob for `key`. If the store already holds
+# the blob and `file` is a separate copy of it, `file` is replaced by a link to the blob.
+function(z_vcpkg_download_store_add file kind key)
+    z_vcpkg_download_store_blob_path(blob "${kind}" "${key}")
+    if(blob STREQUAL "" OR NOT EXISTS "${file}")
+        return()
+    endif()
+    if(NOT EXISTS "${blob}")
+        z_vcpkg_download_store_link(ok "${file}" "${blob}")
+        if(NOT ok)
+            return()
+        endif()
+    else()
+        z_vcpkg_file_sha512_fingerprint(file_fingerprint "${file}")
+        z_vcpkg_file_sha512_fingerprint(blob_fingerprint "${blob}")
+        if(NOT file_fingerprint STREQUAL blob_fingerprint)
+            # A copy with the same contents is only replaced by a link, so that a copy made
+            # where hard links are not supported is not copied again on every use.
+            z_vcpkg_download_store_same_contents(same "${file}" "${blob}")
+            if(same)
+                z_vcpkg_download_store_link(ok "${blob}" "${file}" NO_COPY)
+            else()
+                z_vcpkg_download_store_link(ok "${blob}" "${file}")
+            endif()
+            if(ok AND kind STREQUAL "sha512")
+                z_vcpkg_file_sha512_remember("${file}" "${key}")
+            endif()
+        endif()
+    endif()
+    z_vcpkg_download_store_use("${blob}" "${file}")
+endfunction()
+
+# Removes blobs which have not been used for X_VCPKG_DOWNLOAD_STORE_MAX_AGE days, and the
+# names which still link to them. Runs at most once a day.
+function(z_vcpkg_download_store_collect)
+    set(store_dir "${DOWNLOADS}/tools/download-store")
+    if(X_VCPKG_NO_DOWNLOAD_STORE OR NOT DEFINED DOWNLOADS OR NOT EXISTS "${store_dir}")
+        return()
+    endif()
+    set(max_age 90)
+    if(X_VCPKG_DOWNLOAD_STORE_MAX_AGE MATCHES "^[0-9]+\$")
+        set(max_age "${X_VCPKG_DOWNLOAD_STORE_MAX_AGE}")
+    endif()
+    string(TIMESTAMP now "%s" UTC)
+    set(collect_stamp "${store_dir}/last-collect")
+    if(EXISTS "${collect_stamp}")
+        file(TIMESTAMP "${collect_stamp}" last_collect "%s" UTC)
+        math(EXPR since_last_collect "${now} - ${last_collect}")
+        if(since_last_collect LESS "86400")
+            return()
+        endif()
+    endif()
+    file(TOUCH "${collect_stamp}")
+
+    math(EXPR max_age_seconds "${max_age} * 86400")
+    file(GLOB used_stamps "${store_dir}/sha512/*.used" "${store_dir}/git/*.used")
+    foreach(used_stamp IN LISTS used_stamps)
+        file(TIMESTAMP "${used_stamp}" last_use "%s" UTC)
+        math(EXPR age "${now} - ${last_use}")
+        if(age LESS_EQUAL max_age_seconds)
+            continue()
+        endif()
+        string(REGEX REPLACE "\\.used\$" "" blob "${used_stamp}")
+        if(EXISTS "${blob}" AND EXISTS "${blob}.names")
+            # A name which was replaced by other contents since is kept
+            file(STRINGS "${blob}.names" names)
+            foreach(name IN LISTS names)
+                set(file "${DOWNLOADS}/${name}")
+                if(EXISTS "${file}")
+                    z_vcpkg_download_store_same_contents(same "${file}" "${blob}")
+                    if(same)
+                        file(REMOVE "${file}")
+                    endif()
+                endif()
+            endforeach()
+        endif()
+        message(STATUS "Removing unused download ${blob}")
+        file(REMOVE "${blob}" "${blob}.names" "${used_stamp}")
+    endforeach()
+endfunction()
@@ -0,0 +1,83 @@
+# SHA512 of files in downloads/, memoized in downloads/tools/sha512-memo.
+# An entry is only used while the file's size, modification time and inode are unchanged;
+# X_VCPKG_NO_SHA512_MEMO disables the store.
+
+function(z_vcpkg_file_sha512_memo_path out_var file)
+    set(memo_path "")
+    if(NOT X_VCPKG_NO_SHA512_MEMO AND DEFINED DOWNLOADS)
+        cmake_path(ABSOLUTE_PATH file NORMALIZE OUTPUT_VARIABLE absolute_file)
+        cmake_path(ABSOLUTE_PATH DOWNLOADS NORMALIZE OUTPUT_VARIABLE downloads_dir)
+        cmake_path(IS_PREFIX downloads_dir "${absolute_file}" NORMALIZE is_download)
+        if(is_download)
+            cmake_path(RELATIVE_PATH absolute_file BASE_DIRECTORY "${downloads_dir}" OUTPUT_VARIABLE relative_file)
+        endif()
+        # Files in these directories are still being written; the blobs of the download store never change
+        if(is_download AND (NOT relative_file MATCHES "^(temp|partial|tools)/" OR relative_file MATCHES "^tools/download-store/"))
+            string(SHA512 key "${relative_file}")
+            string(SUBSTRING "${key}" 0 32 key)
+            set(memo_path "${downloads_dir}/tools/sha512-memo/${key}.txt")
+        endif()
+    endif()
+    set("${out_var}" "${memo_path}" PARENT_SCOPE)
+endfunction()
+
+function(z_vcpkg_file_sha512_fingerprint out_var file)
+    file(SIZE "${file}" size)
+    file(TIMESTAMP "${file}" mtime "%s%f" UTC)
+    set(inode "")
+    if(CMAKE_HOST_APPLE OR CMAKE_HOST_BSD)
+        set(stat_args -f %i)
+    elseif(CMAKE_HOST_UNIX)
+        set(stat_args -c %i)
+    endif()
+    if(DEFINED stat_args)
+        execute_process(
+            COMMAND stat ${stat_args} "${file}"
+            OUTPUT_VARIABLE inode
+            OUTPUT_STRIP_TRAILING_WHITESPACE
+            ERROR_QUIET
+        )
+    endif()
+    set("${out_var}" "${size}|${mtime}|${inode}" PARENT_SCOPE)
+endfunction()
+
+# Records `sha512` as the hash of `file` when the hash is already known, e.g. after a download
+function(z_vcpkg_file_sha512_remember file sha512)
+    z_vcpkg_file_sha512_memo_path(memo_path "${file}")
+    if(memo_path STREQUAL "" OR NOT EXISTS "${file}")
+        return()
+    endif()
+    z_vcpkg_file_sha512_fingerprint(fingerprint "${file}")
+    string(TOLOWER "${sha512}" sha512)
+    string(RANDOM LENGTH 8 temp_suffix)
+    file(WRITE "${memo_path}.${temp_suffix}.tmp" "${fingerprint}\n${sha512}\n")
+    file(RENAME "${memo_path}.${temp_suffix}.tmp" "${memo_path}")
+endfunction()
+
+# file(SHA512) which reuses the memoized hash of unchanged files in downloads/.
+# With EXPECTED, the memo is only trusted if it matches: a mismatch is always confirmed
+# by hashing the file again, so a stale memo can never fail a good file.
+function(z_vcpkg_file_sha512 out_var file)
+    cmake_parse_arguments(PARSE_ARGV 2 arg "" "EXPECTED" "")
+    z_vcpkg_file_sha512_memo_path(memo_path "${file}")
+    if(NOT memo_path STREQUAL "" AND EXISTS "${memo_path}")
+        file(STRINGS "${memo_path}" memo LIMIT_COUNT 2)
+        z_vcpkg_file_sha512_fingerprint(fingerprint "${file}")
+        list(LENGTH memo memo_length)
+        if(memo_length EQUAL "2")
+            list(GET memo 0 memo_fingerprint)
+            list(GET memo 1 memo_sha512)
+            string(TOLOWER "${arg_EXPECTED}" expected)
+            if(memo_fingerprint STREQUAL fingerprint AND (NOT DEFINED arg_EXPECTED OR memo_sha512 STREQUAL expected))
+                set("${out_var}" "${memo_sha512}" PARENT_SCOPE)
+                return()
+            endif()
+        endif()
+    endif()
+
+    file(SHA512 "${file}" sha512)
+    if(NOT memo_path STREQUAL "")
+        z_vcpkg_file_sha512_remember("${file}" "${sha512}")
+    endif()
+    set("${out_var}" "${sha512}" PARENT_SCOPE)
+endfunction()
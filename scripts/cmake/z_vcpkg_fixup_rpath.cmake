@@ -1,3 +1,7 @@
+if(CMAKE_SCRIPT_MODE_FILE STREQUAL CMAKE_CURRENT_LIST_FILE)
+    cmake_minimum_required(VERSION 3.21) # policies are recorded when the functions below are defined
+endif()
+
 function(z_vcpkg_calculate_corrected_rpath)
     cmake_parse_arguments(PARSE_ARGV 0 "arg"
       ""
@@ -58,6 +62,104 @@ function(z_vcpkg_calculate_corrected_rpath)
     set("${arg_OUT_NEW_RPATH_VAR}" "${new_rpath}" PARENT_SCOPE)
 endfunction()
 
+# Classifies a file by its ELF header, reading only the first 18 bytes.
+# Sets out_var to EXEC, DYN, REL, CORE or OTHER for ELF files and to an empty string otherwise.
+function(z_vcpkg_get_elf_file_type out_var file)
+    file(READ "${file}" header OFFSET 0 LIMIT 18 HEX)
+    if(NOT header MATCHES "^7f454c46..(0[12])....................(....)$")
+        set("${out_var}" "" PARENT_SCOPE)
+        return()
+    endif()
+    set(e_type "${CMAKE_MATCH_2}")
+    if(CMAKE_MATCH_1 STREQUAL "01") # little endian
+        string(SUBSTRING "${e_type}" 2 2 high_byte)
+        string(SUBSTRING "${e_type}" 0 2 low_byte)
+        set(e_type "${high_byte}${low_byte}")
+    endif()
+    if(e_type STREQUAL "0001")
+        set(type "REL")
+    elseif(e_type STREQUAL "0002")
+        set(type "EXEC")
+    elseif(e_type STREQUAL "0003")
+        set(type "DYN")
+    elseif(e_type STREQUAL "0004")
+        set(type "CORE")
+    else()
+        set(type "OTHER")
+    endif()
+    set("${out_var}" "${type}" PARENT_SCOPE)
+endfunction()
+
+# Sets out_var to `value` as a JSON string, including the quotes
+function(z_vcpkg_fixup_rpath_json_string out_var value)
+    string(REPLACE "\\" "\\\\" value "${value}")
+    string(REPLACE "\"" "\\\"" value "${value}")
+    string(REPLACE "\n" "\\n" value "${value}")
+    string(REPLACE "\r" "\\r" value "${value}")
+    string(REPLACE "\t" "\\t" value "${value}")
+    set("${out_var}" "\"${value}\"" PARENT_SCOPE)
+endfunction()
+
+function(z_vcpkg_fixup_rpath_report_entry out_var file action)
+    z_vcpkg_fixup_rpath_json_string(file "${file}")
+    z_vcpkg_fixup_rpath_json_string(action "${action}")
+    set(entry "{\"file\": ${file}, \"action\": ${action}")
+    set(key_value_pairs "${ARGN}")
+    while(NOT key_value_pairs STREQUAL "")
+        list(POP_FRONT key_value_pairs key value)
+        z_vcpkg_fixup_rpath_json_string(value "${value}")
+        string(APPEND entry ", \"${key}\": ${value}")
+    endwhile()
+    set("${out_var}" "${entry}}" PARENT_SCOPE)
+endfunction()
+
+# Adjusts the RPATH of the given ELF files and appends one JSON object per file to report_file.
+function(z_vcpkg_fixup_rpath_files report_file)
+    set(report "")
+    foreach(elf_file IN LISTS ARGN)
+        file(RELATIVE_PATH relative_elf_file "${CURRENT_PACKAGES_DIR}" "${elf_file}")
+        execute_process(
+            COMMAND "${PATCHELF}" --print-rpath "${elf_file}"
+            OUTPUT_VARIABLE readelf_output
+            ERROR_VARIABLE read_rpath_error
+        )
+        string(REPLACE "\n" "" readelf_output "${readelf_output}")
+        if(NOT "${read_rpath_error}" STREQUAL "")
+            z_vcpkg_fixup_rpath_report_entry(entry "${relative_elf_file}" "failed" error "${read_rpath_error}")
+            string(APPEND report "${entry}\n")
+            continue()
+        endif()
+
+        get_filename_component(elf_file_dir "${elf_file}" DIRECTORY)
+
+        z_vcpkg_calculate_corrected_rpath(
+          ELF_FILE_DIR "${elf_file_dir}"
+          ORG_RPATH "${readelf_output}"
+          OUT_NEW_RPATH_VAR new_rpath
+        )
+
+        if("${new_rpath}" STREQUAL "${readelf_output}")
+            z_vcpkg_fixup_rpath_report_entry(entry "${relative_elf_file}" "unchanged" rpath "${readelf_output}")
+            string(APPEND report "${entry}\n")
+            continue()
+        endif()
+
+        execute_process(
+            COMMAND "${PATCHELF}" --set-rpath "${new_rpath}" "${elf_file}"
+            OUTPUT_QUIET
+            ERROR_VARIABLE set_rpath_error
+        )
+
+        if(NOT "${set_rpath_error}" STREQUAL "")
+            z_vcpkg_fixup_rpath_report_entry(entry "${relative_elf_file}" "failed" error "${set_rpath_error}")
+        else()
+            z_vcpkg_fixup_rpath_report_entry(entry "${relative_elf_file}" "adjusted" old_rpath "${readelf_output}" new_rpath "${new_rpath}")
+        endif()
+        string(APPEND report "${entry}\n")
+    endforeach()
+    file(APPEND "${report_file}" "${report}")
+endfunction()
+
 function(z_vcpkg_fixup_rpath_in_dir)
     # We need to iterate trough everything because we
     # can't predict where an elf file will be located
@@ -74,6 +176,14 @@ function(z_vcpkg_fixup_rpath_in_dir)
         vcpkg_find_acquire_program(PATCHELF)
     endif()
 
+    set(work_dir "${CURRENT_BUILDTREES_DIR}/fixup-rpath-${TARGET_TRIPLET}")
+    set(report_file "${CURRENT_BUILDTREES_DIR}/fixup-rpath-${TARGET_TRIPLET}.json")
+    file(REMOVE_RECURSE "${work_dir}")
+    file(REMOVE "${report_file}")
+
+    # Only the ELF header is read to decide which files need patchelf
+    set(report "")
+    set(elf_files_to_fix "")
     foreach(folder IN LISTS root_entries)
         if(NOT IS_DIRECTORY "${folder}")
             continue()
@@ -84,48 +194,114 @@ function(z_vcpkg_fixup_rpath_in_dir)
             continue()
         endif()
 
-        file(GLOB_RECURSE elf_files LIST_DIRECTORIES FALSE "${folder}/*")
-        list(FILTER elf_files EXCLUDE REGEX "\\\.(a|cpp|cc|cxx|c|hpp|h|hh|hxx|inc|json|toml|yaml|man|m4|ac|am|in|log|txt|pyi?|pyc|pyx|pxd|pc|cmake|f77|f90|f03|fi|f|cu|mod|ini|whl|cat|csv|rst|md|npy|npz|template|build)$")
-        list(FILTER elf_files EXCLUDE REGEX "/(copyright|LICENSE|METADATA)$")
-
-        foreach(elf_file IN LISTS elf_files)
-            if(IS_SYMLINK "${elf_file}")
-                continue()
+        file(GLOB_RECURSE files LIST_DIRECTORIES FALSE "${folder}/*")
+        foreach(file IN LISTS files)
+            file(RELATIVE_PATH relative_file "${CURRENT_PACKAGES_DIR}" "${file}")
+            if(IS_SYMLINK "${file}")
+                z_vcpkg_fixup_rpath_report_entry(entry "${relative_file}" "skipped" reason "symlink")
+            elseif(file MATCHES "\\\.(a|cpp|cc|cxx|c|hpp|h|hh|hxx|inc|json|toml|yaml|man|m4|ac|am|in|log|txt|pyi?|pyc|pyx|pxd|pc|cmake|f77|f90|f03|fi|f|cu|mod|ini|whl|cat|csv|rst|md|npy|npz|template|build)$"
+                   OR file MATCHES "/(copyright|LICENSE|METADATA)$")
+                z_vcpkg_fixup_rpath_report_entry(entry "${relative_file}" "skipped" reason "extension")
+            else()
+                z_vcpkg_get_elf_file_type(elf_type "${file}")
+                if(elf_type STREQUAL "")
+                    z_vcpkg_fixup_rpath_report_entry(entry "${relative_file}" "skipped" reason "not an ELF file")
+                elseif(NOT elf_type MATCHES "^(EXEC|DYN)$")
+                    z_vcpkg_fixup_rpath_report_entry(entry "${relative_file}" "skipped" reason "ELF type ${elf_type}")
+                else()
+                    list(APPEND elf_files_to_fix "${file}")
+                    continue()
+                endif()
             endif()
+            string(APPEND report "${entry}\n")
+        endforeach()
+    endforeach()
 
-            vcpkg_find_acquire_program(PATCHELF) # Note that this relies on vcpkg_find_acquire_program short
-                                                 # circuiting after the first run
-            # If this fails, the file is not an elf
-            execute_process(
-                COMMAND "${PATCHELF}" --print-rpath "${elf_file}"
-                OUTPUT_VARIABLE readelf_output
-                ERROR_VARIABLE read_rpath_error
-            )
-            string(REPLACE "\n" "" readelf_output "${readelf_output}")
-            if(NOT "${read_rpath_error}" STREQUAL "")
-                continue()
-            endif()
+    list(LENGTH elf_files_to_fix number_of_elf_files)
+    if(number_of_elf_files GREATER "0")
+        vcpkg_find_acquire_program(PATCHELF)
+
+        set(number_of_batches "${VCPKG_CONCURRENCY}")
+        if(NOT number_of_batches GREATER "1" OR number_of_elf_files LESS number_of_batches)
+            set(number_of_batches "${number_of_elf_files}")
+        endif()
+        if(number_of_batches GREATER "1" AND NOT VCPKG_HOST_IS_WINDOWS)
+            vcpkg_find_acquire_program(NINJA)
+        endif()
 
-            get_filename_component(elf_file_dir "${elf_file}" DIRECTORY)
+        file(MAKE_DIRECTORY "${work_dir}")
+        if(number_of_batches LESS_EQUAL "1" OR NOT NINJA)
+            z_vcpkg_fixup_rpath_files("${work_dir}/report-0.json" ${elf_files_to_fix})
+        else()
+            # Split the files round-robin into one batch per job and let ninja drive a pool of workers
+            math(EXPR last_batch "${number_of_batches} - 1")
+            foreach(batch RANGE "${last_batch}")
+                set(batch_${batch} "")
+            endforeach()
+            set(batch 0)
+            foreach(elf_file IN LISTS elf_files_to_fix)
+                list(APPEND batch_${batch} "${elf_file}")
+                math(EXPR batch "(${batch} + 1) % ${number_of_batches}")
+            endforeach()
 
-            z_vcpkg_calculate_corrected_rpath(
-              ELF_FILE_DIR "${elf_file_dir}"
-              ORG_RPATH "${readelf_output}"
-              OUT_NEW_RPATH_VAR new_rpath
-            )
+            set(ninja_contents "rule CreateProcess\n  command = \$process\n\n")
+            foreach(batch RANGE "${last_batch}")
+                list(JOIN batch_${batch} "\n" batch_contents)
+                file(WRITE "${work_dir}/batch-${batch}.txt" "${batch_contents}\n")
+                set(process "\"${CMAKE_COMMAND}\"")
+                foreach(arg IN ITEMS
+                    "-DPATCHELF=${PATCHELF}"
+                    "-DCURRENT_PACKAGES_DIR=${CURRENT_PACKAGES_DIR}"
+                    "-DCURRENT_INSTALLED_DIR=${CURRENT_INSTALLED_DIR}"
+                    "-DX_VCPKG_RPATH_KEEP_SYSTEM_PATHS=${X_VCPKG_RPATH_KEEP_SYSTEM_PATHS}"
+                    "-DZ_VCPKG_FIXUP_RPATH_BATCH=${work_dir}/batch-${batch}.txt"
+                    "-DZ_VCPKG_FIXUP_RPATH_REPORT=${work_dir}/report-${batch}.json"
+                    -P "${SCRIPTS}/cmake/z_vcpkg_fixup_rpath.cmake"
+                )
+                    string(APPEND process " \"${arg}\"")
+                endforeach()
+                string(REPLACE "\$" "\$\$" process "${process}")
+                string(APPEND ninja_contents "build batch-${batch}: CreateProcess\n  process = ${process}\n\n")
+            endforeach()
+            file(WRITE "${work_dir}/build.ninja" "${ninja_contents}")
 
-            execute_process(
-                COMMAND "${PATCHELF}" --set-rpath "${new_rpath}" "${elf_file}"
-                OUTPUT_QUIET
-                ERROR_VARIABLE set_rpath_error
+            vcpkg_execute_required_process(
+                COMMAND "${NINJA}" -v "-j${number_of_batches}"
+                WORKING_DIRECTORY "${work_dir}"
+                LOGNAME "fixup-rpath-${TARGET_TRIPLET}"
             )
+        endif()
 
-            if(NOT "${set_rpath_error}" STREQUAL "")
-                message(WARNING "Couldn't adjust RPATH of '${elf_file}': ${set_rpath_error}")
-                continue()
-            endif()
-
-            message(STATUS "Adjusted RPATH of '${elf_file}' (From '${readelf_output}' -> To '${new_rpath}')")
+        file(GLOB batch_reports "${work_dir}/report-*.json")
+        foreach(batch_report IN LISTS batch_reports)
+            file(STRINGS "${batch_report}" batch_entries)
+            foreach(batch_entry IN LISTS batch_entries)
+                string(JSON file ERROR_VARIABLE json_error GET "${batch_entry}" file)
+                string(JSON action ERROR_VARIABLE json_error GET "${batch_entry}" action)
+                if(json_error)
+                    # Not a line of its own, e.g. because the report entry was split at a ';'
+                    continue()
+                elseif(action STREQUAL "adjusted")
+                    string(JSON old_rpath GET "${batch_entry}" old_rpath)
+                    string(JSON new_rpath GET "${batch_entry}" new_rpath)
+                    message(STATUS "Adjusted RPATH of '${CURRENT_PACKAGES_DIR}/${file}' (From '${old_rpath}' -> To '${new_rpath}')")
+                elseif(action STREQUAL "failed")
+                    message(WARNING "Couldn't adjust RPATH of '${CURRENT_PACKAGES_DIR}/${file}', see ${report_file}")
+                endif()
+            endforeach()
+            file(READ "${batch_report}" batch_contents)
+            string(APPEND report "${batch_contents}")
         endforeach()
-    endforeach()
+        file(REMOVE_RECURSE "${work_dir}")
+    endif()
+
+    string(STRIP "${report}" report)
+    string(REPLACE "\n" ",\n  " report "${report}")
+    file(WRITE "${report_file}" "[\n  ${report}\n]\n")
 endfunction()
+
+# Worker mode, invoked by z_vcpkg_fixup_rpath_in_dir for one batch of ELF files
+if(CMAKE_SCRIPT_MODE_FILE STREQUAL CMAKE_CURRENT_LIST_FILE AND DEFINED Z_VCPKG_FIXUP_RPATH_BATCH)
+    file(STRINGS "${Z_VCPKG_FIXUP_RPATH_BATCH}" z_vcpkg_fixup_rpath_elf_files)
+    z_vcpkg_fixup_rpath_files("${Z_VCPKG_FIXUP_RPATH_REPORT}" ${z_vcpkg_fixup_rpath_elf_files})
+endif()
@@ -1,3 +1,110 @@
+function(z_vcpkg_get_cmake_vars_file_stamp out_var file)
+    if(NOT EXISTS "${file}" OR IS_DIRECTORY "${file}")
+        set("${out_var}" "${file}|missing" PARENT_SCOPE)
+        return()
+    endif()
+    get_filename_component(real_file "${file}" REALPATH)
+    file(SIZE "${real_file}" size)
+    file(TIMESTAMP "${real_file}" mtime "%s" UTC)
+    set("${out_var}" "${real_file}|${size}|${mtime}" PARENT_SCOPE)
+endfunction()
+
+# The key covers everything which flows into the configure of scripts/get_cmake_vars:
+# the scripts themselves, the triplet and toolchain files, the variables forwarded by
+# vcpkg_configure_cmake and the environment which the compiler detection observes.
+function(z_vcpkg_get_cmake_vars_cache_key out_var)
+    set(key_contents "version=1\ncmake=${CMAKE_VERSION}\n")
+
+    set(chainload_toolchain_file "${VCPKG_CHAINLOAD_TOOLCHAIN_FILE}")
+    if(NOT chainload_toolchain_file)
+        z_vcpkg_select_default_vcpkg_chainload_toolchain()
+        set(chainload_toolchain_file "${VCPKG_CHAINLOAD_TOOLCHAIN_FILE}")
+    endif()
+
+    foreach(file IN ITEMS
+        "${SCRIPTS}/get_cmake_vars/CMakeLists.txt"
+        "${SCRIPTS}/buildsystems/vcpkg.cmake"
+        "${SCRIPTS}/cmake/vcpkg_configure_cmake.cmake"
+        "${CMAKE_TRIPLET_FILE}"
+        "${chainload_toolchain_file}"
+    )
+        if("${file}" STREQUAL "" OR NOT EXISTS "${file}")
+            continue()
+        endif()
+        file(SHA512 "${file}" file_hash)
+        string(APPEND key_contents "file:${file}=${file_hash}\n")
+    endforeach()
+
+    foreach(var IN ITEMS
+        TARGET_TRIPLET VCPKG_BUILD_TYPE _VCPKG_INSTALLED_DIR
+        VCPKG_TARGET_ARCHITECTURE VCPKG_CMAKE_SYSTEM_NAME VCPKG_CMAKE_SYSTEM_VERSION
+        VCPKG_PLATFORM_TOOLSET VCPKG_PLATFORM_TOOLSET_VERSION VCPKG_XBOX_CONSOLE_TARGET
+        VCPKG_CRT_LINKAGE VCPKG_LIBRARY_LINKAGE
+        VCPKG_C_FLAGS VCPKG_C_FLAGS_DEBUG VCPKG_C_FLAGS_RELEASE
+        VCPKG_CXX_FLAGS VCPKG_CXX_FLAGS_DEBUG VCPKG_CXX_FLAGS_RELEASE
+        VCPKG_LINKER_FLAGS VCPKG_LINKER_FLAGS_DEBUG VCPKG_LINKER_FLAGS_RELEASE
+        VCPKG_CMAKE_CONFIGURE_OPTIONS VCPKG_CMAKE_CONFIGURE_OPTIONS_DEBUG VCPKG_CMAKE_CONFIGURE_OPTIONS_RELEASE
+        VCPKG_INSTALL_NAME_DIR VCPKG_OSX_DEPLOYMENT_TARGET VCPKG_OSX_SYSROOT VCPKG_OSX_ARCHITECTURES
+    )
+        string(APPEND key_contents "var:${var}=${${var}}\n")
+    endforeach()
+    string(APPEND key_contents "var:VCPKG_CHAINLOAD_TOOLCHAIN_FILE=${chainload_toolchain_file}\n")
+
+    foreach(env IN ITEMS
+        CC CXX CFLAGS CXXFLAGS CPPFLAGS LDFLAGS AR RANLIB
+        PATH INCLUDE LIB LIBPATH C_INCLUDE_PATH CPLUS_INCLUDE_PATH LIBRARY_PATH LD_LIBRARY_PATH
+        VCToolsVersion VCToolsInstallDir WindowsSDKVersion VSCMD_ARG_TGT_ARCH
+        SDKROOT DEVELOPER_DIR ANDROID_NDK_HOME
+    )
+        string(APPEND key_contents "env:${env}=$ENV{${env}}\n")
+    endforeach()
+
+    string(SHA512 key "${key_contents}")
+    string(SUBSTRING "${key}" 0 16 key)
+    set("${out_var}" "${key}" PARENT_SCOPE)
+endfunction()
+
+# Compiler binaries are not covered by the key since they are only known after detection.
+# Their stamps are recorded next to the cached result and checked again on every reuse.
+function(z_vcpkg_get_cmake_vars_compiler_stamps out_var)
+    set(stamps "")
+    foreach(vars_file IN LISTS ARGN)
+        if(NOT EXISTS "${vars_file}")
+            continue()
+        endif()
+        include("${vars_file}")
+        foreach(compiler IN ITEMS VCPKG_DETECTED_CMAKE_C_COMPILER VCPKG_DETECTED_CMAKE_CXX_COMPILER)
+            if(NOT "${${compiler}}" STREQUAL "")
+                z_vcpkg_get_cmake_vars_file_stamp(stamp "${${compiler}}")
+                string(APPEND stamps "${stamp}\n")
+            endif()
+        endforeach()
+    endforeach()
+    set("${out_var}" "${stamps}" PARENT_SCOPE)
+endfunction()
+
+function(z_vcpkg_get_cmake_vars_prune_cache cache_dir)
+    set(max_entries 8)
+    file(GLOB entries LIST_DIRECTORIES true "${cache_dir}/*")
+    set(sortable_entries "")
+    foreach(entry IN LISTS entries)
+        if(EXISTS "${entry}/last-used")
+            file(TIMESTAMP "${entry}/last-used" last_used "%Y%m%d%H%M%S" UTC)
+            list(APPEND sortable_entries "${last_used}|${entry}")
+        endif()
+    endforeach()
+    list(LENGTH sortable_entries number_of_entries)
+    if(number_of_entries LESS_EQUAL max_entries)
+        return()
+    endif()
+    list(SORT sortable_entries ORDER DESCENDING)
+    list(SUBLIST sortable_entries "${max_entries}" -1 stale_entries)
+    foreach(stale_entry IN LISTS stale_entries)
+        string(REGEX REPLACE "^[^|]*\\|" "" stale_entry "${stale_entry}")
+        file(REMOVE_RECURSE "${stale_entry}")
+    endforeach()
+endfunction()
+
 function(z_vcpkg_get_cmake_vars out_file)
     cmake_parse_arguments(PARSE_ARGV 1 arg "" "" "")
 
@@ -15,22 +122,85 @@ function(z_vcpkg_get_cmake_vars out_file)
     if(NOT DEFINED CACHE{${cache_var}})
         set(${cache_var}  "${cmake_vars_file}"
             CACHE PATH "The file to include to access the CMake variables from a generated project.")
-        vcpkg_configure_cmake(
-            SOURCE_PATH "${SCRIPTS}/get_cmake_vars"
-            OPTIONS_DEBUG "-DVCPKG_OUTPUT_FILE:PATH=${CURRENT_BUILDTREES_DIR}/cmake-vars-${TARGET_TRIPLET}-dbg.cmake.log"
-            OPTIONS_RELEASE "-DVCPKG_OUTPUT_FILE:PATH=${CURRENT_BUILDTREES_DIR}/cmake-vars-${TARGET_TRIPLET}-rel.cmake.log"
-            PREFER_NINJA
-            LOGNAME get-cmake-vars-${TARGET_TRIPLET}
-            Z_GET_CMAKE_VARS_USAGE # ignore vcpkg_cmake_configure, be quiet, don't set variables...
-        )
 
-        set(include_string "")
+        set(generated_files "")
         if(NOT DEFINED VCPKG_BUILD_TYPE OR VCPKG_BUILD_TYPE STREQUAL "release")
-            string(APPEND include_string "include(\"\${CMAKE_CURRENT_LIST_DIR}/cmake-vars-${TARGET_TRIPLET}-rel.cmake.log\")\n")
+            list(APPEND generated_files "cmake-vars-${TARGET_TRIPLET}-rel.cmake.log")
         endif()
         if(NOT DEFINED VCPKG_BUILD_TYPE OR VCPKG_BUILD_TYPE STREQUAL "debug")
-            string(APPEND include_string "include(\"\${CMAKE_CURRENT_LIST_DIR}/cmake-vars-${TARGET_TRIPLET}-dbg.cmake.log\")\n")
+            list(APPEND generated_files "cmake-vars-${TARGET_TRIPLET}-dbg.cmake.log")
+        endif()
+
+        # Results are shared by all ports of an install, see z_vcpkg_get_cmake_vars_cache_key.
+        set(cache_entry "")
+        if(NOT X_VCPKG_NO_CMAKE_VARS_CACHE)
+            if(DEFINED X_VCPKG_CMAKE_VARS_CACHE_DIR)
+                set(cache_dir "${X_VCPKG_CMAKE_VARS_CACHE_DIR}/${TARGET_TRIPLET}")
+            else()
+                set(cache_dir "${DOWNLOADS}/tools/cmake-vars/${TARGET_TRIPLET}")
+            endif()
+            z_vcpkg_get_cmake_vars_cache_key(cache_key)
+            set(cache_entry "${cache_dir}/${cache_key}")
         endif()
+
+        set(cache_hit OFF)
+        if(NOT cache_entry STREQUAL "" AND EXISTS "${cache_entry}/compilers.txt")
+            set(cache_hit ON)
+            set(cached_files "")
+            foreach(generated_file IN LISTS generated_files)
+                if(NOT EXISTS "${cache_entry}/${generated_file}")
+                    set(cache_hit OFF)
+                endif()
+                list(APPEND cached_files "${cache_entry}/${generated_file}")
+            endforeach()
+            if(cache_hit)
+                file(READ "${cache_entry}/compilers.txt" recorded_stamps)
+                z_vcpkg_get_cmake_vars_compiler_stamps(current_stamps ${cached_files})
+                if(NOT recorded_stamps STREQUAL current_stamps)
+                    message(STATUS "Compiler changed since CMake variables were cached; detecting again")
+                    set(cache_hit OFF)
+                endif()
+            endif()
+        endif()
+
+        if(cache_hit)
+            debug_message("Using cached CMake variables from ${cache_entry}")
+            file(COPY ${cached_files} DESTINATION "${CURRENT_BUILDTREES_DIR}")
+            file(TOUCH "${cache_entry}/last-used")
+        else()
+            vcpkg_configure_cmake(
+                SOURCE_PATH "${SCRIPTS}/get_cmake_vars"
+                OPTIONS_DEBUG "-DVCPKG_OUTPUT_FILE:PATH=${CURRENT_BUILDTREES_DIR}/cmake-vars-${TARGET_TRIPLET}-dbg.cmake.log"
+                OPTIONS_RELEASE "-DVCPKG_OUTPUT_FILE:PATH=${CURRENT_BUILDTREES_DIR}/cmake-vars-${TARGET_TRIPLET}-rel.cmake.log"
+                PREFER_NINJA
+                LOGNAME get-cmake-vars-${TARGET_TRIPLET}
+                Z_GET_CMAKE_VARS_USAGE # ignore vcpkg_cmake_configure, be quiet, don't set variables...
+            )
+
+            if(NOT cache_entry STREQUAL "")
+                # Populate a temporary directory and rename it so that concurrent builds never see partial entries
+                string(RANDOM LENGTH 8 temp_suffix)
+                set(temp_entry "${cache_entry}.${temp_suffix}.tmp")
+                list(TRANSFORM generated_files PREPEND "${CURRENT_BUILDTREES_DIR}/" OUTPUT_VARIABLE built_files)
+                file(REMOVE_RECURSE "${temp_entry}")
+                file(MAKE_DIRECTORY "${temp_entry}")
+                file(COPY ${built_files} DESTINATION "${temp_entry}")
+                z_vcpkg_get_cmake_vars_compiler_stamps(current_stamps ${built_files})
+                file(WRITE "${temp_entry}/compilers.txt" "${current_stamps}")
+                file(TOUCH "${temp_entry}/last-used")
+                file(REMOVE_RECURSE "${cache_entry}")
+                file(RENAME "${temp_entry}" "${cache_entry}" RESULT rename_result)
+                if(NOT rename_result EQUAL "0")
+                    file(REMOVE_RECURSE "${temp_entry}")
+                endif()
+                z_vcpkg_get_cmake_vars_prune_cache("${cache_dir}")
+            endif()
+        endif()
+
+        set(include_string "")
+        foreach(generated_file IN LISTS generated_files)
+            string(APPEND include_string "include(\"\${CMAKE_CURRENT_LIST_DIR}/${generated_file}\")\n")
+        endforeach()
         file(WRITE "${cmake_vars_file}" "${include_string}")
     endif()
 
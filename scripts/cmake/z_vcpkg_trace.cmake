@@ -0,0 +1,170 @@
+# Per-phase tracing of port builds, enabled by X_PORT_TRACE.
+# Events are collected in buildtrees/<port>/trace-<triplet>.events.log and written as a
+# Chrome trace (chrome://tracing, ui.perfetto.dev) to buildtrees/<port>/trace-<triplet>.json
+# by z_vcpkg_trace_write. scripts/mergePortTraces.py merges the traces of several ports.
+
+function(z_vcpkg_trace_now_us out_var)
+    string(TIMESTAMP now "%s%f" UTC)
+    if(NOT now MATCHES "^[0-9]+$") # %f requires CMake 3.23
+        string(TIMESTAMP now "%s" UTC)
+        string(APPEND now "000000")
+    endif()
+    set("${out_var}" "${now}" PARENT_SCOPE)
+endfunction()
+
+# CPU time of this process and of all processes it has waited for, in milliseconds.
+function(z_vcpkg_trace_cpu_ms out_var)
+    set(cpu_ms "")
+    if(EXISTS "/proc/self/stat")
+        file(READ "/proc/self/stat" stat)
+        if(stat MATCHES "\\) (.*)$")
+            string(REPLACE " " ";" fields "${CMAKE_MATCH_1}")
+            # utime, stime, cutime and cstime are fields 14 to 17, counted in 1/100 s
+            list(SUBLIST fields 11 4 times)
+            list(JOIN times " + " times)
+            math(EXPR cpu_ms "(${times}) * 10")
+        endif()
+    endif()
+    set("${out_var}" "${cpu_ms}" PARENT_SCOPE)
+endfunction()
+
+function(z_vcpkg_trace_json_string out_var value)
+    string(REPLACE "\\" "\\\\" value "${value}")
+    string(REPLACE "\"" "\\\"" value "${value}")
+    string(REPLACE "\n" "\\n" value "${value}")
+    string(REPLACE "\t" "\\t" value "${value}")
+    set("${out_var}" "\"${value}\"" PARENT_SCOPE)
+endfunction()
+
+function(z_vcpkg_trace_begin out_var)
+    if(NOT X_PORT_TRACE)
+        set("${out_var}" "" PARENT_SCOPE)
+        return()
+    endif()
+    z_vcpkg_trace_now_us(now_us)
+    z_vcpkg_trace_cpu_ms(cpu_ms)
+    set("${out_var}" "${now_us};${cpu_ms}" PARENT_SCOPE)
+endfunction()
+
+# z_vcpkg_trace_end(<token> NAME <name> CATEGORY <category> [PEAK_RSS_MIB <mib>] [ARGS <key> <value>...])
+function(z_vcpkg_trace_end token)
+    cmake_parse_arguments(PARSE_ARGV 1 arg "" "NAME;CATEGORY;PEAK_RSS_MIB" "ARGS")
+    if(NOT X_PORT_TRACE OR "${token}" STREQUAL "")
+        return()
+    endif()
+
+    z_vcpkg_trace_now_us(now_us)
+    z_vcpkg_trace_cpu_ms(cpu_ms)
+    list(GET token 0 start_us)
+    math(EXPR duration_us "${now_us} - ${start_us}")
+
+    z_vcpkg_trace_json_string(name "${arg_NAME}")
+    z_vcpkg_trace_json_string(category "${arg_CATEGORY}")
+    set(args "")
+    list(LENGTH token token_length)
+    if(token_length EQUAL "2" AND NOT "${cpu_ms}" STREQUAL "")
+        list(GET token 1 start_cpu_ms)
+        math(EXPR cpu_ms "${cpu_ms} - ${start_cpu_ms}")
+        string(APPEND args ", \"cpu_ms\": ${cpu_ms}")
+    endif()
+    if(NOT "${arg_PEAK_RSS_MIB}" STREQUAL "")
+        string(APPEND args ", \"peak_rss_mib\": ${arg_PEAK_RSS_MIB}")
+    endif()
+    while(NOT "${arg_ARGS}" STREQUAL "")
+        list(POP_FRONT arg_ARGS key value)
+        z_vcpkg_trace_json_string(value "${value}")
+        string(APPEND args ", \"${key}\": ${value}")
+    endwhile()
+    string(REGEX REPLACE "^, " "" args "${args}")
+
+    file(APPEND "${CURRENT_BUILDTREES_DIR}/trace-${TARGET_TRIPLET}.events.log"
+        "{\"name\": ${name}, \"cat\": ${category}, \"ph\": \"X\", \"ts\": ${start_us}, \"dur\": ${duration_us}, \"pid\": 1, \"tid\": 1, \"args\": {${args}}}\n")
+endfunction()
+
+# Number of lines in a .ninja_log, used to find the entries added by one ninja invocation
+function(z_vcpkg_trace_ninja_log_length out_var ninja_log)
+    set(length 0)
+    if(X_PORT_TRACE AND EXISTS "${ninja_log}")
+        file(STRINGS "${ninja_log}" lines)
+        list(LENGTH lines length)
+    endif()
+    set("${out_var}" "${length}" PARENT_SCOPE)
+endfunction()
+
+# Adds one event per edge which ninja recorded after the first `skip_lines` lines of ninja_log.
+# Edges are spread over threads 2 and up such that events on one thread never overlap.
+function(z_vcpkg_trace_ninja_log token ninja_log skip_lines)
+    if(NOT X_PORT_TRACE OR "${token}" STREQUAL "" OR NOT EXISTS "${ninja_log}")
+        return()
+    endif()
+    list(GET token 0 base_us)
+    file(STRINGS "${ninja_log}" lines)
+    list(LENGTH lines length)
+    if(length LESS_EQUAL skip_lines)
+        return()
+    endif()
+    list(SUBLIST lines "${skip_lines}" -1 lines)
+
+    set(edges "")
+    foreach(line IN LISTS lines)
+        if(line MATCHES "^([0-9]+)\t([0-9]+)\t[0-9]+\t([^\t]+)\t")
+            # Zero-pad the start time to make the list sortable
+            string(LENGTH "${CMAKE_MATCH_1}" start_length)
+            math(EXPR padding "12 - ${start_length}")
+            string(REPEAT "0" "${padding}" zeros)
+            list(APPEND edges "${zeros}${CMAKE_MATCH_1}|${CMAKE_MATCH_2}|${CMAKE_MATCH_3}")
+        endif()
+    endforeach()
+    list(SORT edges)
+
+    set(lane_ends "")
+    set(events "")
+    foreach(edge IN LISTS edges)
+        string(REPLACE "|" ";" edge "${edge}")
+        list(GET edge 0 start_ms)
+        list(GET edge 1 end_ms)
+        list(GET edge 2 target)
+        math(EXPR start_ms "${start_ms}") # drop the padding
+
+        set(lane -1)
+        set(index 0)
+        foreach(lane_end IN LISTS lane_ends)
+            if(lane_end LESS_EQUAL start_ms)
+                set(lane "${index}")
+                break()
+            endif()
+            math(EXPR index "${index} + 1")
+        endforeach()
+        if(lane EQUAL "-1")
+            list(LENGTH lane_ends lane)
+            list(APPEND lane_ends "${end_ms}")
+        else()
+            list(REMOVE_AT lane_ends "${lane}")
+            list(INSERT lane_ends "${lane}" "${end_ms}")
+        endif()
+
+        math(EXPR ts "${base_us} + ${start_ms} * 1000")
+        math(EXPR duration_us "(${end_ms} - ${start_ms}) * 1000")
+        math(EXPR tid "${lane} + 2")
+        z_vcpkg_trace_json_string(name "${target}")
+        string(APPEND events "{\"name\": ${name}, \"cat\": \"ninja\", \"ph\": \"X\", \"ts\": ${ts}, \"dur\": ${duration_us}, \"pid\": 1, \"tid\": ${tid}, \"args\": {}}\n")
+    endforeach()
+    file(APPEND "${CURRENT_BUILDTREES_DIR}/trace-${TARGET_TRIPLET}.events.log" "${events}")
+endfunction()
+
+function(z_vcpkg_trace_write)
+    set(events_file "${CURRENT_BUILDTREES_DIR}/trace-${TARGET_TRIPLET}.events.log")
+    if(NOT X_PORT_TRACE OR NOT EXISTS "${events_file}")
+        return()
+    endif()
+    file(READ "${events_file}" events)
+    string(STRIP "${events}" events)
+    string(REPLACE "\n" ",\n  " events "${events}")
+    z_vcpkg_trace_json_string(process_name "${PORT}:${TARGET_TRIPLET}")
+    file(WRITE "${CURRENT_BUILDTREES_DIR}/trace-${TARGET_TRIPLET}.json" "{\"traceEvents\": [
+  {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": ${process_name}}},
+  ${events}
+], \"displayTimeUnit\": \"ms\"}
+")
+    file(REMOVE "${events_file}")
+endfunction()
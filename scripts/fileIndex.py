@@ -0,0 +1,396 @@
+import os
+import sys
+import mmap
+import time
+import struct
+import argparse
+
+
+SCRIPT_DIRECTORY = os.path.dirname(os.path.abspath(__file__))
+INDEX_PATH = os.path.join(SCRIPT_DIRECTORY, 'list_files', 'VCPKGFileIndex.bin')
+DATABASE_PATH = os.path.join(SCRIPT_DIRECTORY, 'list_files', 'VCPKGDatabase.txt')
+HEADERS_PREFIX = '/include/'
+
+# Layout, all integers little endian:
+#   header:  magic, format, package/entry/block counts, offsets of the tables below
+#   package: name and .list file name (string pool offset and length), first forward entry and count,
+#            mtime_ns and size of the .list file
+#   blocks:  offset of every block of BLOCK_SIZE entries in the entry data
+#   entries: shared prefix length, suffix length, package, suffix bytes; the first entry of every block is complete
+#   forward: entry numbers of each package's files
+#   suffix:  entry numbers sorted by the reversed path
+# Entries are (path, package) sorted by path, paths are relative to the triplet directory and start with '/'.
+MAGIC = b'VCPKGFIX'
+FORMAT = 1
+BLOCK_SIZE = 16
+HEADER = struct.Struct('<8sIIIIIIIIII')
+PACKAGE = struct.Struct('<IIIIIIQQ')
+ENTRY = struct.Struct('<HHI')
+NUMBER = struct.Struct('<I')
+
+
+def get_fingerprint(path):
+    stat = os.stat(path)
+    return (stat.st_mtime_ns, stat.st_size)
+
+
+def get_list_files(path):
+    return sorted(item for item in os.listdir(path) if item.endswith('.list') and item[0] != '.')
+
+
+def get_package_name(list_file):
+    # <port>_<version>_<triplet>.list
+    components = list_file[:-len('.list')].split('_')
+    return f'{components[0]}:{components[-1]}'
+
+
+def read_list_file(list_file_path):
+    paths = []
+    with open(list_file_path, 'r', encoding='utf-8', errors='surrogateescape') as list_file:
+        for line in list_file:
+            line = line.strip()
+            if not line or line[-1] == '/':
+                continue
+            paths.append(line[line.find('/'):])
+    return paths
+
+
+class FileIndex:
+    """Read-only view of the file index written by `fileIndex.py build`."""
+
+    def __init__(self, path=INDEX_PATH):
+        with open(path, 'rb') as index_file:
+            self.data = mmap.mmap(index_file.fileno(), 0, access=mmap.ACCESS_READ)
+        (magic, index_format, self.package_count, self.entry_count, self.block_count,
+         self.packages_offset, self.blocks_offset, self.entries_offset,
+         self.forward_offset, self.suffix_offset, self.strings_offset) = HEADER.unpack_from(self.data, 0)
+        if magic != MAGIC or index_format != FORMAT:
+            self.data.close()
+            raise ValueError(f'{path} is not a file index of format {FORMAT}')
+
+    def close(self):
+        self.data.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def _string(self, offset, length):
+        start = self.strings_offset + offset
+        return self.data[start:start + length].decode('utf-8')
+
+    def _package(self, i):
+        return PACKAGE.unpack_from(self.data, self.packages_offset + i * PACKAGE.size)
+
+    def _number(self, table_offset, i):
+        return NUMBER.unpack_from(self.data, table_offset + i * NUMBER.size)[0]
+
+    def package_name(self, i):
+        name_offset, name_length, _, _, _, _, _, _ = self._package(i)
+        return self._string(name_offset, name_length)
+
+    def package_list_file(self, i):
+        _, _, list_offset, list_length, _, _, _, _ = self._package(i)
+        return self._string(list_offset, list_length)
+
+    def package_fingerprint(self, i):
+        _, _, _, _, _, _, mtime_ns, size = self._package(i)
+        return (mtime_ns, size)
+
+    def find_package(self, package_name):
+        low, high = 0, self.package_count
+        while low < high:
+            middle = (low + high) // 2
+            name = self.package_name(middle)
+            if name < package_name:
+                low = middle + 1
+            elif name > package_name:
+                high = middle
+            else:
+                return middle
+        return None
+
+    def _block_entries(self, block):
+        """(entry number, path, package) of the entries of a block."""
+        offset = self.entries_offset + self._number(self.blocks_offset, block)
+        first = block * BLOCK_SIZE
+        path = b''
+        for i in range(first, min(first + BLOCK_SIZE, self.entry_count)):
+            shared, suffix_length, package = ENTRY.unpack_from(self.data, offset)
+            offset += ENTRY.size
+            path = path[:shared] + self.data[offset:offset + suffix_length]
+            offset += suffix_length
+            yield i, path, package
+
+    def _entries_from(self, block):
+        for b in range(block, self.block_count):
+            yield from self._block_entries(b)
+
+    def _path_at(self, i):
+        for entry, path, package in self._block_entries(i // BLOCK_SIZE):
+            if entry == i:
+                return path, package
+        raise IndexError(i)
+
+    def _lower_bound_entries(self, key):
+        """The entries from the first path which is not less than `key`."""
+        low, high = 0, self.block_count
+        while low < high:
+            middle = (low + high) // 2
+            _, first_path, _ = next(self._block_entries(middle))
+            if first_path <= key:
+                low = middle + 1
+            else:
+                high = middle
+        for entry in self._entries_from(max(low - 1, 0)):
+            if entry[1] >= key:
+                yield entry
+
+    def find_path(self, path):
+        """The packages which install `path`."""
+        key = path.encode('utf-8', errors='surrogateescape')
+        packages = []
+        for _, entry_path, package in self._lower_bound_entries(key):
+            if entry_path != key:
+                break
+            packages.append(self.package_name(package))
+        return packages
+
+    def find_prefix(self, prefix):
+        """(path, package) of the paths starting with `prefix`."""
+        key = prefix.encode('utf-8', errors='surrogateescape')
+        results = []
+        for _, entry_path, package in self._lower_bound_entries(key):
+            if not entry_path.startswith(key):
+                break
+            results.append((entry_path.decode('utf-8', errors='surrogateescape'), self.package_name(package)))
+        return results
+
+    def find_suffix(self, suffix):
+        """(path, package) of the paths ending with `suffix`."""
+        key = suffix.encode('utf-8', errors='surrogateescape')[::-1]
+        low, high = 0, self.entry_count
+        while low < high:
+            middle = (low + high) // 2
+            path, _ = self._path_at(self._number(self.suffix_offset, middle))
+            if path[::-1] < key:
+                low = middle + 1
+            else:
+                high = middle
+        results = []
+        for i in range(low, self.entry_count):
+            path, package = self._path_at(self._number(self.suffix_offset, i))
+            if not path.endswith(key[::-1]):
+                break
+            results.append((path.decode('utf-8', errors='surrogateescape'), self.package_name(package)))
+        return results
+
+    def package_files(self, package_name):
+        """The paths installed by a package, or None for unknown packages."""
+        i = self.find_package(package_name)
+        if i is None:
+            return None
+        return self.package_files_at(i)
+
+    def package_files_at(self, i):
+        _, _, _, _, forward_first, forward_count, _, _ = self._package(i)
+        paths = []
+        for forward in range(forward_first, forward_first + forward_count):
+            path, _ = self._path_at(self._number(self.forward_offset, forward))
+            paths.append(path.decode('utf-8', errors='surrogateescape'))
+        return paths
+
+    def all_package_files(self):
+        """{package index: [path, ...]} decoded in a single pass over the entries."""
+        package_files = {}
+        for _, path, package in self._entries_from(0):
+            package_files.setdefault(package, []).append(path.decode('utf-8', errors='surrogateescape'))
+        return package_files
+
+
+def write_index(packages, path=INDEX_PATH):
+    """Writes an index of `packages`: {package: (list file name, fingerprint, [path, ...])}."""
+    strings = bytearray()
+
+    def add_string(value):
+        encoded = value.encode('utf-8')
+        offset = len(strings)
+        strings.extend(encoded)
+        return offset, len(encoded)
+
+    package_names = sorted(packages)
+    entries = []
+    for package, package_name in enumerate(package_names):
+        for file_path in set(packages[package_name][2]):
+            entries.append((file_path.encode('utf-8', errors='surrogateescape'), package))
+    entries.sort()
+
+    block_table = bytearray()
+    entry_data = bytearray()
+    forward = [[] for _ in package_names]
+    previous_path = b''
+    for i, (file_path, package) in enumerate(entries):
+        if i % BLOCK_SIZE == 0:
+            block_table.extend(NUMBER.pack(len(entry_data)))
+            shared = 0
+        else:
+            shared = len(os.path.commonprefix([previous_path, file_path]))
+        entry_data.extend(ENTRY.pack(shared, len(file_path) - shared, package))
+        entry_data.extend(file_path[shared:])
+        forward[package].append(i)
+        previous_path = file_path
+
+    package_table = bytearray()
+    forward_table = bytearray()
+    forward_count = 0
+    for package, package_name in enumerate(package_names):
+        list_file, (mtime_ns, size), _ = packages[package_name]
+        name_offset, name_length = add_string(package_name)
+        list_offset, list_length = add_string(list_file)
+        package_table.extend(PACKAGE.pack(name_offset, name_length, list_offset, list_length,
+                                          forward_count, len(forward[package]), mtime_ns, size))
+        for i in forward[package]:
+            forward_table.extend(NUMBER.pack(i))
+        forward_count += len(forward[package])
+
+    suffix_table = bytearray()
+    for i in sorted(range(len(entries)), key=lambda i: entries[i][0][::-1]):
+        suffix_table.extend(NUMBER.pack(i))
+
+    packages_offset = HEADER.size
+    blocks_offset = packages_offset + len(package_table)
+    entries_offset = blocks_offset + len(block_table)
+    forward_offset = entries_offset + len(entry_data)
+    suffix_offset = forward_offset + len(forward_table)
+    strings_offset = suffix_offset + len(suffix_table)
+    os.makedirs(os.path.dirname(os.path.abspath(path)), exist_ok=True)
+    temp_path = f'{path}.{os.getpid()}.tmp'
+    with open(temp_path, 'wb') as index_file:
+        index_file.write(HEADER.pack(MAGIC, FORMAT, len(package_names), len(entries), len(block_table) // NUMBER.size,
+                                     packages_offset, blocks_offset, entries_offset,
+                                     forward_offset, suffix_offset, strings_offset))
+        for table in (package_table, block_table, entry_data, forward_table, suffix_table, strings):
+            index_file.write(table)
+    os.replace(temp_path, path)
+
+
+def build_index(info_path, index_path=INDEX_PATH, full=False):
+    """Indexes the .list files in `info_path`, only reading the ones changed since the previous index."""
+    previous_index = None
+    if not full and os.path.exists(index_path):
+        try:
+            previous_index = FileIndex(index_path)
+        except (ValueError, OSError) as e:
+            print(f'Warning: Ignoring {index_path}: {e}', file=sys.stderr)
+
+    packages = {}
+    changed_count = 0
+    try:
+        previous_files = None
+        for list_file in get_list_files(info_path):
+            package_name = get_package_name(list_file)
+            fingerprint = get_fingerprint(os.path.join(info_path, list_file))
+            if previous_index is not None:
+                i = previous_index.find_package(package_name)
+                if (i is not None and previous_index.package_list_file(i) == list_file
+                        and previous_index.package_fingerprint(i) == fingerprint):
+                    if previous_files is None:
+                        previous_files = previous_index.all_package_files()
+                    packages[package_name] = (list_file, fingerprint, previous_files.get(i, []))
+                    continue
+            changed_count += 1
+            packages[package_name] = (list_file, fingerprint, read_list_file(os.path.join(info_path, list_file)))
+    finally:
+        if previous_index is not None:
+            previous_index.close()
+
+    write_index(packages, index_path)
+    return changed_count, len(packages)
+
+
+def scan_database(database_path, path):
+    """The packages of `path` in VCPKGDatabase.txt, as queried before the index existed."""
+    packages = []
+    with open(database_path, 'r', encoding='utf-8', errors='surrogateescape') as database:
+        for line in database:
+            package_name, _, file_path = line.rstrip('\n').rpartition(':')
+            if file_path == path:
+                packages.append(package_name)
+    return packages
+
+
+def benchmark(index_path, path, iterations):
+    with FileIndex(index_path) as index:
+        start_time = time.perf_counter()
+        for _ in range(iterations):
+            packages = index.find_path(path)
+        index_time = (time.perf_counter() - start_time) / iterations
+
+    start_time = time.perf_counter()
+    for _ in range(iterations):
+        scanned_packages = scan_database(DATABASE_PATH, path)
+    scan_time = (time.perf_counter() - start_time) / iterations
+
+    if sorted(packages) != sorted(scanned_packages):
+        print(f'Error: the index returned {packages}, the text scan {scanned_packages}', file=sys.stderr)
+    print(f'Index lookup: {index_time * 1e6:12.1f} us')
+    print(f'Text scan:    {scan_time * 1e6:12.1f} us')
+
+
+def print_results(results):
+    for file_path, package_name in results:
+        print(f'{package_name}:{file_path}')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Builds and queries the index of the files installed by each package.')
+    parser.add_argument('--index', default=INDEX_PATH, help='path of the index')
+    subparsers = parser.add_subparsers(dest='command', required=True)
+    build_parser = subparsers.add_parser('build', help='index the .list files of an installed/vcpkg/info directory')
+    build_parser.add_argument('info_path')
+    build_parser.add_argument('--full', action='store_true', help='read all .list files instead of reusing the index')
+    subparsers.add_parser('path', help='packages which install a path, e.g. /include/zlib.h').add_argument('path')
+    subparsers.add_parser('header', help='packages which install a header, e.g. Poco/Foundation.h').add_argument('header')
+    subparsers.add_parser('prefix', help='paths starting with a prefix').add_argument('prefix')
+    subparsers.add_parser('suffix', help='paths ending with a suffix, e.g. opencv2/core.hpp').add_argument('suffix')
+    subparsers.add_parser('package', help='files installed by a package, e.g. zlib:x64-linux').add_argument('package')
+    benchmark_parser = subparsers.add_parser('benchmark', help='compare path lookups with a scan of VCPKGDatabase.txt')
+    benchmark_parser.add_argument('path')
+    benchmark_parser.add_argument('--iterations', type=int, default=10)
+    args = parser.parse_args()
+
+    if args.command == 'build':
+        start_time = time.time()
+        changed_count, package_count = build_index(args.info_path, args.index, args.full)
+        elapsed_time = time.time() - start_time
+        print(f'Read {changed_count} of {package_count} .list files, elapsed time: {elapsed_time:.2f} seconds')
+        return
+
+    if not os.path.exists(args.index):
+        print(f'{args.index} does not exist.\nRun: `python fileIndex.py build <installed>/vcpkg/info/`', file=sys.stderr)
+        sys.exit(1)
+
+    if args.command == 'benchmark':
+        benchmark(args.index, args.path, args.iterations)
+        return
+
+    with FileIndex(args.index) as index:
+        if args.command in ('path', 'header'):
+            path = HEADERS_PREFIX + args.header.lstrip('/') if args.command == 'header' else args.path
+            results = [(path, package_name) for package_name in index.find_path(path)]
+        elif args.command == 'prefix':
+            results = index.find_prefix(args.prefix)
+        elif args.command == 'suffix':
+            results = index.find_suffix(args.suffix)
+        else:
+            files = index.package_files(args.package)
+            results = [(file_path, args.package) for file_path in files or []]
+    if not results:
+        sys.exit(1)
+    print_results(results)
+
+
+if __name__ == "__main__":
+    main()
@@ -2,6 +2,8 @@ import os
 import os.path
 import sys
 
+from fileIndex import build_index
+
 
 keyword = "/include/"
 
@@ -35,6 +37,8 @@ def main(path):
         gen_all_file_strings(path, getFiles(path), headers, output)
         headers.close()
         output.close()
+        # Indexed form of the same lists, queried with `fileIndex.py`
+        build_index(path)
     except e:
         print("Failed to generate file lists")
 
@@ -2,8 +2,9 @@ import os
 import sys
 import json
 import time
+import argparse
 
-from pathlib import Path
+from versionsIndex import VersionsIndex, get_fingerprint, write_index, INDEX_PATH
 
 
 SCRIPT_DIRECTORY = os.path.dirname(os.path.abspath(__file__))
@@ -29,7 +30,62 @@ def get_version_port_version(version):
     return 0
 
 
-def generate_baseline():
+def load_previous_index(index_path):
+    if not os.path.exists(index_path):
+        return None
+    try:
+        return VersionsIndex(index_path)
+    except (ValueError, OSError) as e:
+        print(f'Warning: Ignoring {index_path}: {e}', file=sys.stderr)
+        return None
+
+
+def load_versions_files(previous_index):
+    """{port: (fingerprint, versions)} of every versions file, only parsing the files changed since the previous index."""
+    port_versions = {}
+    changed_count = 0
+    for prefix_directory in sorted(os.listdir(VERSIONS_DB_DIRECTORY)):
+        prefix_path = os.path.join(VERSIONS_DB_DIRECTORY, prefix_directory)
+        if not prefix_directory.endswith('-') or not os.path.isdir(prefix_path):
+            continue
+        for file_name in os.listdir(prefix_path):
+            if not file_name.endswith('.json'):
+                continue
+            port_name = file_name[:-len('.json')]
+            port_file_path = os.path.join(prefix_path, file_name)
+            fingerprint = get_fingerprint(port_file_path)
+            if previous_index is not None:
+                i = previous_index.find_port(port_name)
+                if i is not None and previous_index.fingerprint(i) == fingerprint:
+                    port_versions[port_name] = (fingerprint, previous_index.versions_at(i))
+                    continue
+            changed_count += 1
+            with open(port_file_path, 'r') as db_file:
+                try:
+                    port_versions[port_name] = (fingerprint, json.load(db_file)['versions'])
+                except (json.JSONDecodeError, KeyError) as e:
+                    print(f'Error: Decoding {port_file_path}\n{e}\n', file=sys.stderr)
+    return port_versions, changed_count
+
+
+def write_baseline(baseline_path, baseline_entries):
+    # Same layout as json.dump(indent=2), written entry by entry next to the target and renamed
+    temp_path = f'{baseline_path}.{os.getpid()}.tmp'
+    with open(temp_path, 'w', newline='\n') as baseline_file:
+        baseline_file.write('{\n  "default": {')
+        separator = '\n'
+        for port_name, (baseline, port_version) in baseline_entries:
+            baseline_file.write(
+                f'{separator}    {json.dumps(port_name)}: {{\n'
+                f'      "baseline": {json.dumps(baseline)},\n'
+                f'      "port-version": {port_version}\n'
+                f'    }}')
+            separator = ',\n'
+        baseline_file.write('\n  }\n}\n' if baseline_entries else '}\n}\n')
+    os.replace(temp_path, baseline_path)
+
+
+def generate_baseline(full):
     start_time = time.time()
 
     # Assume each directory in ${VCPKG_ROOT}/ports is a different port
@@ -37,45 +93,43 @@ def generate_baseline():
         PORTS_DIRECTORY) if os.path.isdir(os.path.join(PORTS_DIRECTORY, item))]
     port_names.sort()
 
-    baseline_entries = {}
-    total_count = len(port_names)
-    for i, port_name in enumerate(port_names, 1):
-        port_file_path = os.path.join(
-            VERSIONS_DB_DIRECTORY, f'{port_name[0]}-', f'{port_name}.json')
+    previous_index = None if full else load_previous_index(INDEX_PATH)
+    try:
+        port_versions, changed_count = load_versions_files(previous_index)
+    finally:
+        if previous_index is not None:
+            previous_index.close()
 
-        if not os.path.exists(port_file_path):
+    baseline_entries = []
+    for port_name in port_names:
+        if port_name not in port_versions:
             print(
                 f'Error: No version file for {port_name}.\n', file=sys.stderr)
             continue
-        sys.stderr.write(
-            f'\rProcessed {i}/{total_count} ({i/total_count:.2%})')
-        with open(port_file_path, 'r') as db_file:
-            try:
-                versions_object = json.load(db_file)
-                if versions_object['versions']:
-                    last_version = versions_object['versions'][0]
-                    baseline_entries[port_name] = {
-                        'baseline': get_version_tag(last_version),
-                        'port-version': get_version_port_version(last_version)
-                    }
-            except json.JSONDecodeError as e:
-                print(f'Error: Decoding {port_file_path}\n{e}\n')
-    baseline_object = {}
-    baseline_object['default'] = baseline_entries
+        _, versions = port_versions[port_name]
+        if versions:
+            last_version = versions[0]
+            baseline_entries.append((port_name, (get_version_tag(last_version),
+                                                 get_version_port_version(last_version))))
 
     os.makedirs(VERSIONS_DB_DIRECTORY, exist_ok=True)
-    baseline_path = os.path.join(VERSIONS_DB_DIRECTORY, 'baseline.json')
-    with open(baseline_path, 'w') as baseline_file:
-        json.dump(baseline_object, baseline_file)
+    write_baseline(os.path.join(VERSIONS_DB_DIRECTORY, 'baseline.json'), baseline_entries)
+    write_index(port_versions, INDEX_PATH)
 
     elapsed_time = time.time() - start_time
-    print(f'\nElapsed time: {elapsed_time:.2f} seconds')
+    print(f'Read {changed_count} of {len(port_versions)} versions files, elapsed time: {elapsed_time:.2f} seconds')
 
 
 def main():
+    parser = argparse.ArgumentParser(
+        description='Updates baseline.json and versions.idx from the versions files changed since the last run.')
+    parser.add_argument('--full', action='store_true',
+                        help='read all versions files instead of reusing versions.idx')
+    args = parser.parse_args()
+
     if not os.path.exists(VERSIONS_DB_DIRECTORY):
         print(f'Version DB files must exist before generating a baseline.\nRun: `python generatePortVersionsDB`\n')
-    generate_baseline()
+    generate_baseline(args.full)
 
 
 if __name__ == "__main__":
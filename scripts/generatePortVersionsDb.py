@@ -1,86 +1,255 @@
 import os
+import re
 import sys
 import subprocess
 import json
 import time
-import shutil
-
-import multiprocessing
+import argparse
 
 from pathlib import Path
 
 
-MAX_PROCESSES = multiprocessing.cpu_count()
 SCRIPT_DIRECTORY = os.path.dirname(os.path.abspath(__file__))
 PORTS_DIRECTORY = os.path.join(SCRIPT_DIRECTORY, '../ports')
 VERSIONS_DB_DIRECTORY = os.path.join(SCRIPT_DIRECTORY, '../versions')
+VERSION_KEYS = ['version', 'version-semver', 'version-date', 'version-string']
+REVISION_MARKER_PATTERN = re.compile(r'^[0-9a-f]{40}$')
+NULL_TREE = '0' * 40
+
+
+def git(*args, check=True):
+    env = os.environ.copy()
+    env['GIT_OPTIONAL_LOCKS'] = '0'
+    output = subprocess.run(['git', '-C', SCRIPT_DIRECTORY, *args],
+                            capture_output=True, encoding='utf-8', env=env)
+    if check and output.returncode != 0:
+        print(f'git {" ".join(args)} failed:', output.stderr.strip(), file=sys.stderr)
+        sys.exit(1)
+    return output
 
 
 def get_current_git_ref():
-    output = subprocess.run(['git', '-C', SCRIPT_DIRECTORY, 'rev-parse', '--verify', 'HEAD'],
-                            capture_output=True,
-                            encoding='utf-8')
+    output = git('rev-parse', '--verify', 'HEAD', check=False)
     if output.returncode == 0:
         return output.stdout.strip()
     print(f"Failed to get git ref:", output.stderr.strip(), file=sys.stderr)
     return None
 
 
-def generate_versions_file(port_name):
-    containing_dir = os.path.join(VERSIONS_DB_DIRECTORY, f'{port_name[0]}-')
-    os.makedirs(containing_dir, exist_ok=True)
+def get_recorded_revision(revision):
+    """The newest revision marker in versions/ which is an ancestor of `revision`."""
+    recorded = None
+    for item in os.listdir(VERSIONS_DB_DIRECTORY):
+        if not REVISION_MARKER_PATTERN.match(item):
+            continue
+        if git('merge-base', '--is-ancestor', item, revision, check=False).returncode != 0:
+            continue
+        if recorded is None or git('merge-base', '--is-ancestor', recorded, item, check=False).returncode == 0:
+            recorded = item
+    return recorded
+
+
+def walk_port_trees(revision_range, port_names=None):
+    """Every tree of every port in a single `git log`, as {port: [tree, ...]} newest first."""
+    # Merge commits are compared to their first parent, so that trees which only exist after a merge
+    # (e.g. a resolved conflict) are found as well.
+    output = git('log', '--format=commit %H', '--raw', '-t', '--no-abbrev', '--no-renames',
+                 '--diff-merges=first-parent', revision_range, '--', ':(top)ports/')
+    port_trees = {}
+    for line in output.stdout.splitlines():
+        # :040000 040000 <old tree> <new tree> M\tports/<port>
+        if not line.startswith(':'):
+            continue
+        status, path = line.split('\t', 1)
+        parts = path.split('/')
+        if len(parts) != 2 or parts[0] != 'ports':
+            continue
+        modes_and_trees = status.split()
+        if modes_and_trees[1] != '040000' or modes_and_trees[3] == NULL_TREE:
+            continue
+        port_name = parts[1]
+        if port_names is not None and port_name not in port_names:
+            continue
+        trees = port_trees.setdefault(port_name, [])
+        if modes_and_trees[3] not in trees:
+            trees.append(modes_and_trees[3])
+    return port_trees
+
 
-    output_file_path = os.path.join(containing_dir, f'{port_name}.json')
-    if not os.path.exists(output_file_path):
+class ManifestReader:
+    """Reads the version of port trees through one `git cat-file --batch` process."""
+
+    def __init__(self):
         env = os.environ.copy()
         env['GIT_OPTIONAL_LOCKS'] = '0'
-        output = subprocess.run(
-            [os.path.join(SCRIPT_DIRECTORY, '../vcpkg'),
-             'x-history', port_name, '--x-json', f'--output={output_file_path}'],
-            capture_output=True, encoding='utf-8', env=env)
-        if output.returncode != 0:
-            print(f'x-history {port_name} failed: ',
-                  output.stdout.strip(), file=sys.stderr)
+        self.process = subprocess.Popen(['git', '-C', SCRIPT_DIRECTORY, 'cat-file', '--batch'],
+                                        stdin=subprocess.PIPE, stdout=subprocess.PIPE, env=env)
+
+    def close(self):
+        self.process.stdin.close()
+        self.process.wait()
+
+    def read_blob(self, name):
+        self.process.stdin.write(f'{name}\n'.encode('utf-8'))
+        self.process.stdin.flush()
+        header = self.process.stdout.readline().decode('utf-8').split()
+        if len(header) != 3 or header[1] != 'blob':
+            return None
+        content = self.process.stdout.read(int(header[2]))
+        self.process.stdout.read(1)
+        return content.decode('utf-8-sig', errors='replace')
+
+    def read_version(self, tree):
+        manifest = self.read_blob(f'{tree}:vcpkg.json')
+        if manifest is not None:
+            try:
+                manifest = json.loads(manifest)
+            except json.JSONDecodeError:
+                return None
+            for key in VERSION_KEYS:
+                if key in manifest:
+                    return {'git-tree': tree, key: manifest[key], 'port-version': manifest.get('port-version', 0)}
+            return None
+
+        control = self.read_blob(f'{tree}:CONTROL')
+        if control is None:
+            return None
+        version = None
+        port_version = 0
+        for line in control.splitlines():
+            if line.startswith('Version:') and version is None:
+                version = line[len('Version:'):].strip()
+            elif line.startswith('Port-Version:'):
+                port_version = int(line[len('Port-Version:'):].strip() or 0)
+            elif not line.strip() and version is not None:
+                break
+        if version is None:
+            return None
+        return {'git-tree': tree, 'version-string': version, 'port-version': port_version}
+
 
+def version_key(entry):
+    version = next(entry[key] for key in VERSION_KEYS if key in entry)
+    return (version, entry['port-version'])
 
-def generate_versions_db(revision):
+
+def read_versions(reader, trees):
+    """The versions of the given trees, keeping the newest tree of each version."""
+    versions = []
+    seen = set()
+    for tree in trees:
+        entry = reader.read_version(tree)
+        if entry is None or version_key(entry) in seen:
+            continue
+        seen.add(version_key(entry))
+        versions.append(entry)
+    return versions
+
+
+def get_versions_file_path(port_name):
+    return os.path.join(VERSIONS_DB_DIRECTORY, f'{port_name[0]}-', f'{port_name}.json')
+
+
+def write_versions_file(port_name, versions, merge):
+    output_file_path = get_versions_file_path(port_name)
+    os.makedirs(os.path.dirname(output_file_path), exist_ok=True)
+    newline = '\n'
+    if os.path.exists(output_file_path):
+        with open(output_file_path, 'r', encoding='utf-8', newline='') as versions_file:
+            existing = versions_file.read()
+        if '\r\n' in existing:
+            newline = '\r\n'
+        if merge:
+            new_keys = set(version_key(entry) for entry in versions)
+            try:
+                old_versions = json.loads(existing)['versions']
+            except (json.JSONDecodeError, KeyError) as e:
+                print(f'Error: Decoding {output_file_path}\n{e}\n', file=sys.stderr)
+                old_versions = []
+            versions = versions + [entry for entry in old_versions if version_key(entry) not in new_keys]
+
+    # Write next to the target and rename, such that readers never see a partial file
+    content = json.dumps({'versions': versions}, indent=2) + '\n'
+    temp_file_path = f'{output_file_path}.{os.getpid()}.tmp'
+    with open(temp_file_path, 'w', encoding='utf-8', newline=newline) as versions_file:
+        versions_file.write(content)
+    os.replace(temp_file_path, output_file_path)
+
+
+def generate_versions_db(revision, full):
     start_time = time.time()
 
     # Assume each directory in ${VCPKG_ROOT}/ports is a different port
     port_names = [item for item in os.listdir(
         PORTS_DIRECTORY) if os.path.isdir(os.path.join(PORTS_DIRECTORY, item))]
-    total_count = len(port_names)
-
-    concurrency = MAX_PROCESSES / 2
-    print(f'Running {concurrency:.0f} parallel processes')
-    process_pool = multiprocessing.Pool(MAX_PROCESSES)
-    for i, _ in enumerate(process_pool.imap_unordered(generate_versions_file, port_names), 1):
-        sys.stderr.write(
-            f'\rProcessed: {i}/{total_count} ({(i / total_count):.2%})')
-    process_pool.close()
-    process_pool.join()
-
-    # Generate timestamp
+
+    os.makedirs(VERSIONS_DB_DIRECTORY, exist_ok=True)
+    recorded_revision = None if full else get_recorded_revision(revision)
+    if full:
+        print(f'Walking the full history of ports/')
+        rebuilt_trees = walk_port_trees(revision)
+        merged_trees = {}
+    elif recorded_revision is None:
+        # The existing files may hold versions which are not reachable here (e.g. in a shallow clone)
+        print(f'No revision marker found, merging the full history of ports/ into the versions files')
+        rebuilt_trees = {}
+        merged_trees = walk_port_trees(revision)
+    else:
+        print(f'Walking ports/ since {recorded_revision}')
+        merged_trees = walk_port_trees(f'{recorded_revision}..{revision}')
+        # Ports without a versions file are not covered by the revision marker
+        missing_ports = set(port_name for port_name in port_names
+                            if not os.path.exists(get_versions_file_path(port_name)))
+        rebuilt_trees = walk_port_trees(revision, missing_ports) if missing_ports else {}
+        for port_name in rebuilt_trees:
+            merged_trees.pop(port_name, None)
+
+    total_count = len(rebuilt_trees) + len(merged_trees)
+    reader = ManifestReader()
+    try:
+        i = 0
+        for port_trees, merge in ((rebuilt_trees, False), (merged_trees, True)):
+            for port_name, trees in sorted(port_trees.items()):
+                versions = read_versions(reader, trees)
+                if versions:
+                    write_versions_file(port_name, versions, merge)
+                i += 1
+                sys.stderr.write(
+                    f'\rProcessed: {i}/{total_count} ({(i / total_count):.2%})')
+    finally:
+        reader.close()
+
+    # Generate timestamp, replacing the previous one
+    for item in os.listdir(VERSIONS_DB_DIRECTORY):
+        if REVISION_MARKER_PATTERN.match(item) and item != revision:
+            os.remove(os.path.join(VERSIONS_DB_DIRECTORY, item))
     rev_file = os.path.join(VERSIONS_DB_DIRECTORY, revision)
     Path(rev_file).touch()
 
     elapsed_time = time.time() - start_time
     print(
-        f'\nElapsed time: {elapsed_time:.2f} seconds')
+        f'\nUpdated {total_count} ports, elapsed time: {elapsed_time:.2f} seconds')
 
 
 def main():
+    parser = argparse.ArgumentParser(
+        description='Updates the versions files of the ports touched since the last recorded revision.')
+    parser.add_argument('--full', action='store_true',
+                        help='regenerate the versions files of all ports from the full history, '
+                             'dropping versions which are not reachable from HEAD')
+    args = parser.parse_args()
+
     revision = get_current_git_ref()
     if not revision:
         print('Couldn\'t fetch current Git revision', file=sys.stderr)
         sys.exit(1)
 
     rev_file = os.path.join(VERSIONS_DB_DIRECTORY, revision)
-    if os.path.exists(rev_file):
+    if os.path.exists(rev_file) and not args.full:
         print(f'Database files already exist for commit {revision}')
         sys.exit(0)
 
-    generate_versions_db(revision)
+    generate_versions_db(revision, args.full)
 
 
 if __name__ == "__main__":
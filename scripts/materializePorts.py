@@ -0,0 +1,324 @@
+import io
+import os
+import re
+import sys
+import json
+import time
+import shutil
+import tarfile
+import argparse
+import subprocess
+
+from generatePortVersionsDb import ManifestReader
+from portGraph import CORE, parse_manifest, evaluate_platform_expression, get_triplet_identifiers
+from versionsIndex import VersionsIndex, get_version_scheme, INDEX_PATH
+
+
+SCRIPT_DIRECTORY = os.path.dirname(os.path.abspath(__file__))
+ROOT_DIRECTORY = os.path.normpath(os.path.join(SCRIPT_DIRECTORY, '..'))
+VERSIONS_DB_DIRECTORY = os.path.join(ROOT_DIRECTORY, 'versions')
+MANIFEST_PATH = os.path.join(ROOT_DIRECTORY, 'vcpkg.json')
+STATE_NAME = '.materialized-ports.json'
+
+
+def git(*args, check=True, stdout=subprocess.PIPE):
+    env = os.environ.copy()
+    env['GIT_OPTIONAL_LOCKS'] = '0'
+    output = subprocess.run(['git', '-C', ROOT_DIRECTORY, *args], stdout=stdout, stderr=subprocess.PIPE, env=env)
+    if check and output.returncode != 0:
+        print(f'git {" ".join(args)} failed:', output.stderr.decode('utf-8', errors='replace').strip(), file=sys.stderr)
+        sys.exit(1)
+    return output
+
+
+def compare_versions(left, right):
+    """Relaxed ordering of version strings: numeric parts compare as numbers, everything else as text."""
+    def key(version):
+        return [(0, int(part), '') if part.isdigit() else (1, 0, part) for part in re.split(r'[.\-+_]', version)]
+    left_key, right_key = key(left), key(right)
+    return (left_key > right_key) - (left_key < right_key)
+
+
+class VersionDatabase:
+    """git-trees of port versions, from versions.idx when it is up to date, else from the versions files.
+    Files outside of a sparse checkout are read from HEAD."""
+
+    def __init__(self, reader):
+        self.reader = reader
+        self.index = None
+        if os.path.exists(INDEX_PATH):
+            try:
+                self.index = VersionsIndex(INDEX_PATH)
+            except ValueError:
+                pass
+
+    def versions(self, port_name):
+        path = os.path.join(VERSIONS_DB_DIRECTORY, f'{port_name[0]}-', f'{port_name}.json')
+        if self.index is not None:
+            i = self.index.find_port(port_name)
+            if i is not None and os.path.exists(path):
+                stat = os.stat(path)
+                if self.index.fingerprint(i) == (stat.st_mtime_ns, stat.st_size):
+                    return self.index.versions_at(i)
+        if not os.path.exists(path):
+            content = self.reader.read_blob(f'HEAD:versions/{port_name[0]}-/{port_name}.json')
+            return json.loads(content)['versions'] if content is not None else []
+        with open(path, 'r', encoding='utf-8') as versions_file:
+            return json.load(versions_file)['versions']
+
+    def find(self, port_name, version, port_version=None):
+        """The entry of `version`, by default with the highest port-version."""
+        matches = [entry for entry in self.versions(port_name) if get_version_scheme(entry)[1] == version
+                   and (port_version is None or entry['port-version'] == port_version)]
+        return max(matches, key=lambda entry: entry['port-version'], default=None)
+
+
+def load_baseline(builtin_baseline):
+    """The baseline of the builtin-baseline commit, or of the working tree if that commit is not available."""
+    if builtin_baseline:
+        output = git('show', f'{builtin_baseline}:versions/baseline.json', check=False)
+        if output.returncode == 0:
+            return json.loads(output.stdout.decode('utf-8'))['default']
+        print(f'Warning: builtin-baseline {builtin_baseline} is not in this clone, '
+              f'using versions/baseline.json', file=sys.stderr)
+    with open(os.path.join(VERSIONS_DB_DIRECTORY, 'baseline.json'), 'r', encoding='utf-8') as baseline_file:
+        return json.load(baseline_file)['default']
+
+
+class Resolver:
+    """Resolves the ports, versions and features a manifest installs, like vcpkg's versioned resolution:
+    overrides win, otherwise the highest of the baseline and every `version>=` constraint."""
+
+    def __init__(self, manifest, triplets):
+        self.manifest = manifest
+        self.baseline = load_baseline(manifest.get('builtin-baseline'))
+        self.overrides = {override['name']: override for override in manifest.get('overrides', [])}
+        self.reader = ManifestReader()
+        self.database = VersionDatabase(self.reader)
+        # Without triplets, every platform-dependent dependency is kept
+        self.identifiers = [get_triplet_identifiers(triplet, triplet) for triplet in triplets]
+        self.minimums = {}
+        self.features = {}
+        self.nodes = {}
+        self.selected = {}
+
+    def close(self):
+        self.reader.close()
+
+    def holds(self, expression):
+        if not expression or not self.identifiers:
+            return True
+        return any(evaluate_platform_expression(expression, identifiers) for identifiers in self.identifiers)
+
+    def select(self, port_name):
+        """(version, port-version, git-tree or None) of a port"""
+        override = self.overrides.get(port_name)
+        if override is not None:
+            _, version = get_version_scheme(override)
+            entry = self.database.find(port_name, version, override.get('port-version', 0))
+        else:
+            baseline = self.baseline.get(port_name)
+            version = baseline['baseline'] if baseline else None
+            port_version = baseline.get('port-version', 0) if baseline else None
+            minimum = self.minimums.get(port_name)
+            if minimum is not None and (version is None or compare_versions(minimum, version) > 0):
+                version, port_version = minimum, None
+            entry = self.database.find(port_name, version, port_version) if version is not None else None
+        if entry is None:
+            return (version, None, None)
+        return (version, entry['port-version'], entry['git-tree'])
+
+    def load_node(self, port_name, git_tree):
+        manifest = None
+        if git_tree is not None:
+            manifest = self.reader.read_blob(f'{git_tree}:vcpkg.json')
+        if manifest is None:
+            # The tree of this version is not in the clone: fall back to the port at HEAD
+            manifest = self.reader.read_blob(f'HEAD:ports/{port_name}/vcpkg.json')
+            if manifest is None:
+                return None
+        return parse_manifest(json.loads(manifest))
+
+    def request(self, port_name, features, default_features, minimum, pending):
+        if minimum is not None and (port_name not in self.minimums
+                                    or compare_versions(minimum, self.minimums[port_name]) > 0):
+            self.minimums[port_name] = minimum
+            pending.add(port_name)
+        requested = set([CORE] + features)
+        if default_features:
+            requested.add('default')
+        current = self.features.setdefault(port_name, set())
+        if not requested <= current:
+            current.update(requested)
+            pending.add(port_name)
+
+    def resolve(self):
+        pending = set()
+        for dependency in self.manifest.get('dependencies', []):
+            if isinstance(dependency, str):
+                dependency = {'name': dependency}
+            if self.holds(dependency.get('platform', '')):
+                self.request(dependency['name'],
+                             [f if isinstance(f, str) else f['name'] for f in dependency.get('features', [])],
+                             dependency.get('default-features', True), dependency.get('version>='), pending)
+
+        # Iterate to a fixpoint: a raised minimum version may select a tree with other dependencies
+        while pending:
+            port_name = pending.pop()
+            selection = self.select(port_name)
+            if self.selected.get(port_name) != selection:
+                self.selected[port_name] = selection
+                self.nodes[port_name] = self.load_node(port_name, selection[2])
+            node = self.nodes[port_name]
+            if node is None:
+                continue
+            features = set(self.features[port_name])
+            if 'default' in features:
+                features.discard('default')
+                features.update(name for name, platform in node['default-features'] if self.holds(platform))
+            for feature in features:
+                if feature not in node['features']:
+                    continue
+                for name, dependency_features, default_features, platform, _, minimum in \
+                        node['features'][feature]['dependencies']:
+                    if not self.holds(platform) or name == port_name and not dependency_features:
+                        continue
+                    self.request(name, [f for f, f_platform in dependency_features if self.holds(f_platform)],
+                                 default_features, minimum, pending)
+        return {port_name: selection for port_name, selection in self.selected.items()
+                if self.nodes.get(port_name) is not None}
+
+
+# Materialization
+
+def load_state(state_path):
+    if not os.path.exists(state_path):
+        return {}
+    with open(state_path, 'r', encoding='utf-8') as state_file:
+        return json.load(state_file)
+
+
+def save_state(state_path, state):
+    temp_path = f'{state_path}.{os.getpid()}.tmp'
+    with open(temp_path, 'w', encoding='utf-8') as state_file:
+        json.dump(state, state_file, indent=2, sort_keys=True)
+    os.replace(temp_path, state_path)
+
+
+def extract_tree(tree, destination):
+    """Writes a git tree to `destination` through `git archive`."""
+    temp_destination = f'{destination}.{os.getpid()}.tmp'
+    shutil.rmtree(temp_destination, ignore_errors=True)
+    os.makedirs(temp_destination)
+    archive = git('archive', '--format=tar', tree)
+    with tarfile.open(fileobj=io.BytesIO(archive.stdout)) as tar:
+        tar.extractall(temp_destination)
+    shutil.rmtree(destination, ignore_errors=True)
+    os.replace(temp_destination, destination)
+
+
+def materialize_overlay(selected, overlay_directory):
+    """Each port at its selected version in overlay_directory/<port>, for --overlay-ports.
+    Ports whose tree is unchanged since the last run are left alone."""
+    os.makedirs(overlay_directory, exist_ok=True)
+    state_path = os.path.join(overlay_directory, STATE_NAME)
+    state = load_state(state_path)
+    trees = [git_tree for _, _, git_tree in selected.values() if git_tree is not None]
+    check = subprocess.run(['git', '-C', ROOT_DIRECTORY, 'cat-file', '--batch-check'],
+                           input=''.join(f'{tree}\n' for tree in trees), encoding='utf-8', capture_output=True)
+    available_trees = set(fields[0] for fields in map(str.split, check.stdout.splitlines()) if fields[1:2] == ['tree'])
+    updated_count = 0
+    for port_name, (version, port_version, git_tree) in sorted(selected.items()):
+        tree = git_tree
+        if tree not in available_trees:
+            print(f'Warning: {port_name} {version} is not in this clone, using the checked out port',
+                  file=sys.stderr)
+            tree = git('rev-parse', f'HEAD:ports/{port_name}').stdout.decode().strip()
+        destination = os.path.join(overlay_directory, port_name)
+        if state.get(port_name) == tree and os.path.isdir(destination):
+            continue
+        extract_tree(tree, destination)
+        state[port_name] = tree
+        updated_count += 1
+    for port_name in sorted(set(state) - set(selected)):
+        shutil.rmtree(os.path.join(overlay_directory, port_name), ignore_errors=True)
+        del state[port_name]
+        updated_count += 1
+    save_state(state_path, state)
+    return updated_count
+
+
+def get_sparse_patterns(selected):
+    patterns = ['/*', '!/ports/*/', '!/versions/*/']
+    for port_name in sorted(selected):
+        patterns.append(f'/ports/{port_name}/')
+        patterns.append(f'/versions/{port_name[0]}-/{port_name}.json')
+    return patterns
+
+
+def materialize_sparse(selected):
+    """Restricts the working tree to the closure with a non-cone sparse checkout. git only touches
+    the paths that enter or leave the patterns, so later runs are incremental."""
+    patterns = get_sparse_patterns(selected)
+    sparse_file = git('rev-parse', '--git-path', 'info/sparse-checkout').stdout.decode().strip()
+    sparse_file = os.path.join(ROOT_DIRECTORY, sparse_file)
+    if os.path.exists(sparse_file):
+        with open(sparse_file, 'r', encoding='utf-8') as current_file:
+            if current_file.read().split() == patterns and \
+                    git('config', 'core.sparseCheckout', check=False).stdout.strip() == b'true':
+                return 0
+    output = subprocess.run(['git', '-C', ROOT_DIRECTORY, 'sparse-checkout', 'set', '--no-cone', '--stdin'],
+                            input='\n'.join(patterns) + '\n', encoding='utf-8', capture_output=True)
+    if output.returncode != 0:
+        print('git sparse-checkout failed:', output.stderr.strip(), file=sys.stderr)
+        sys.exit(1)
+    return len(selected)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Materializes only the ports (and versions entries) needed by a manifest.')
+    parser.add_argument('--manifest', default=MANIFEST_PATH)
+    parser.add_argument('--triplet', action='append', default=[],
+                        help='keep the dependencies of these triplets only, by default of all platforms')
+    mode = parser.add_mutually_exclusive_group(required=True)
+    mode.add_argument('--overlay', metavar='DIRECTORY', help='write the ports at their selected versions here')
+    mode.add_argument('--sparse', action='store_true', help='sparse-checkout the ports tree of this clone')
+    mode.add_argument('--list', action='store_true', help='print the closure')
+    mode.add_argument('--disable-sparse', action='store_true', help='restore the full working tree')
+    args = parser.parse_args()
+
+    if args.disable_sparse:
+        git('sparse-checkout', 'disable', stdout=None)
+        return
+
+    start_time = time.time()
+    with open(args.manifest, 'r', encoding='utf-8') as manifest_file:
+        manifest = json.load(manifest_file)
+    try:
+        resolver = Resolver(manifest, args.triplet)
+    except ValueError as e:
+        print(f'Error: {e}', file=sys.stderr)
+        sys.exit(1)
+    try:
+        selected = resolver.resolve()
+    finally:
+        resolver.close()
+
+    if args.list:
+        for port_name, (version, port_version, git_tree) in sorted(selected.items()):
+            port_version = '?' if port_version is None else port_version
+            print(f'{port_name} {version}#{port_version} {git_tree or "(not in versions database)"}')
+        print(f'{len(selected)} ports', file=sys.stderr)
+        return
+
+    if args.overlay:
+        updated_count = materialize_overlay(selected, args.overlay)
+    else:
+        updated_count = materialize_sparse(selected)
+    print(f'{len(selected)} ports in the closure, {updated_count} updated, '
+          f'elapsed time: {time.time() - start_time:.2f} seconds')
+
+
+if __name__ == "__main__":
+    main()
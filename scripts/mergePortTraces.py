@@ -0,0 +1,106 @@
+import os
+import sys
+import json
+import glob
+import argparse
+
+
+SCRIPT_DIRECTORY = os.path.dirname(os.path.abspath(__file__))
+BUILDTREES_DIRECTORY = os.path.join(SCRIPT_DIRECTORY, '../buildtrees')
+PHASE_CATEGORIES = ['download', 'extract', 'patch', 'configure', 'build', 'install', 'fixup']
+
+
+def load_traces(buildtrees_directory):
+    traces = []
+    pattern = os.path.join(buildtrees_directory, '*', 'trace-*.json')
+    for trace_path in sorted(glob.glob(pattern)):
+        with open(trace_path, 'r', encoding='utf-8') as trace_file:
+            try:
+                trace = json.load(trace_file)
+            except json.JSONDecodeError as e:
+                print(f'Error: Decoding {trace_path}\n{e}\n', file=sys.stderr)
+                continue
+        port_name = os.path.basename(os.path.dirname(trace_path))
+        triplet = os.path.basename(trace_path)[len('trace-'):-len('.json')]
+        traces.append((f'{port_name}:{triplet}', trace['traceEvents']))
+    return traces
+
+
+def merge_traces(traces):
+    merged_events = []
+    for pid, (name, events) in enumerate(traces, 1):
+        for event in events:
+            event = dict(event)
+            event['pid'] = pid
+            if event.get('ph') == 'M' and event.get('name') == 'process_name':
+                event['args'] = {'name': name}
+            merged_events.append(event)
+    return {'traceEvents': merged_events, 'displayTimeUnit': 'ms'}
+
+
+def summarize(traces, top_count):
+    phase_totals = {category: 0 for category in PHASE_CATEGORIES}
+    ports = []
+    edges = []
+    for name, events in traces:
+        for event in events:
+            if event.get('ph') != 'X':
+                continue
+            category = event.get('cat')
+            duration_ms = event.get('dur', 0) / 1000
+            if category == 'port':
+                ports.append({'port': name, 'duration_ms': duration_ms,
+                              'cpu_ms': event.get('args', {}).get('cpu_ms')})
+            elif category == 'ninja':
+                edges.append({'port': name, 'target': event['name'], 'duration_ms': duration_ms})
+            elif category in phase_totals:
+                phase_totals[category] += duration_ms
+
+    ports.sort(key=lambda port: port['duration_ms'], reverse=True)
+    edges.sort(key=lambda edge: edge['duration_ms'], reverse=True)
+    return {
+        'phases': phase_totals,
+        'slowest_ports': ports[:top_count],
+        'slowest_targets': edges[:top_count],
+    }
+
+
+def print_summary(summary):
+    print(f'{"Phase":<12}{"Total (s)":>12}')
+    for category, total_ms in summary['phases'].items():
+        print(f'{category:<12}{total_ms / 1000:>12.2f}')
+    print(f'\n{"Port":<48}{"Wall (s)":>12}{"CPU (s)":>12}')
+    for port in summary['slowest_ports']:
+        cpu = port['cpu_ms'] / 1000 if port['cpu_ms'] is not None else float('nan')
+        print(f'{port["port"]:<48}{port["duration_ms"] / 1000:>12.2f}{cpu:>12.2f}')
+    print(f'\n{"Target":<72}{"Wall (s)":>12}')
+    for edge in summary['slowest_targets']:
+        print(f'{edge["port"] + " " + edge["target"]:<72}{edge["duration_ms"] / 1000:>12.2f}')
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Merges the traces written by ports built with X_PORT_TRACE into one Chrome trace.')
+    parser.add_argument('--buildtrees', default=BUILDTREES_DIRECTORY)
+    parser.add_argument('--output', default='port-traces.json')
+    parser.add_argument('--summary', help='Writes the per-phase summary as JSON to this file.')
+    parser.add_argument('--top', type=int, default=10)
+    args = parser.parse_args()
+
+    traces = load_traces(args.buildtrees)
+    if not traces:
+        print(f'No traces found in {args.buildtrees}', file=sys.stderr)
+        sys.exit(1)
+
+    with open(args.output, 'w', encoding='utf-8') as output_file:
+        json.dump(merge_traces(traces), output_file)
+
+    summary = summarize(traces, args.top)
+    if args.summary:
+        with open(args.summary, 'w', encoding='utf-8') as summary_file:
+            json.dump(summary, summary_file, indent=2)
+    print_summary(summary)
+
+
+if __name__ == "__main__":
+    main()
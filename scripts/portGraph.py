@@ -0,0 +1,418 @@
+import os
+import re
+import sys
+import json
+import time
+import hashlib
+import argparse
+import subprocess
+
+
+SCRIPT_DIRECTORY = os.path.dirname(os.path.abspath(__file__))
+PORTS_DIRECTORY = os.path.join(SCRIPT_DIRECTORY, '../ports')
+TRIPLETS_DIRECTORY = os.path.join(SCRIPT_DIRECTORY, '../triplets')
+BUILDTREES_DIRECTORY = os.path.join(SCRIPT_DIRECTORY, '../buildtrees')
+GRAPH_PATH = os.path.join(BUILDTREES_DIRECTORY, 'port-graph.json')
+GRAPH_FORMAT = 2
+CORE = 'core'
+
+
+# Platform expressions, as in the "supports" and "platform" fields of vcpkg.json
+
+def tokenize_platform_expression(expression):
+    tokens = re.findall(r'[a-z0-9_-]+|[!&|,()]', expression.lower())
+    if ''.join(tokens) != re.sub(r'\s+', '', expression.lower()):
+        raise ValueError(f'Invalid platform expression: {expression}')
+    return tokens
+
+
+def evaluate_platform_expression(expression, identifiers):
+    """True if `expression` holds for a triplet with the given identifiers. ',' is the legacy spelling of '|'."""
+    if not expression:
+        return True
+    tokens = tokenize_platform_expression(expression)
+    position = 0
+
+    def peek():
+        return tokens[position] if position < len(tokens) else None
+
+    def take():
+        nonlocal position
+        position += 1
+        return tokens[position - 1]
+
+    def parse_primary():
+        token = take()
+        if token == '!':
+            return not parse_primary()
+        if token == '(':
+            value = parse_or()
+            if take() != ')':
+                raise ValueError(f'Unbalanced parentheses: {expression}')
+            return value
+        return token in identifiers
+
+    def parse_and():
+        value = parse_primary()
+        while peek() == '&':
+            take()
+            value = parse_primary() and value
+        return value
+
+    def parse_or():
+        value = parse_and()
+        while peek() in ('|', ','):
+            take()
+            value = parse_and() or value
+        return value
+
+    try:
+        value = parse_or()
+    except IndexError:
+        raise ValueError(f'Invalid platform expression: {expression}')
+    if position != len(tokens):
+        raise ValueError(f'Invalid platform expression: {expression}')
+    return value
+
+
+def get_triplet_identifiers(triplet, host_triplet):
+    triplet_path = None
+    for directory in (TRIPLETS_DIRECTORY, os.path.join(TRIPLETS_DIRECTORY, 'community')):
+        if os.path.exists(os.path.join(directory, f'{triplet}.cmake')):
+            triplet_path = os.path.join(directory, f'{triplet}.cmake')
+            break
+    if triplet_path is None:
+        raise ValueError(f'Unknown triplet: {triplet}')
+
+    variables = {}
+    with open(triplet_path, 'r') as triplet_file:
+        for name, value in re.findall(r'set\s*\(\s*(VCPKG_\w+)\s+"?([^")\s]*)"?\s*\)', triplet_file.read()):
+            variables.setdefault(name, value)
+
+    architecture = variables.get('VCPKG_TARGET_ARCHITECTURE', '')
+    system_name = variables.get('VCPKG_CMAKE_SYSTEM_NAME', '')
+    identifiers = {architecture}
+    if architecture == 'arm':
+        identifiers.add('arm32')
+    if architecture.startswith('arm'):
+        identifiers.add('arm')
+    if system_name in ('', 'WindowsStore', 'MinGW'):
+        identifiers.add('windows')
+    identifiers.add({
+        'WindowsStore': 'uwp',
+        'MinGW': 'mingw',
+        'Linux': 'linux',
+        'Darwin': 'osx',
+        'iOS': 'ios',
+        'Android': 'android',
+        'Emscripten': 'emscripten',
+        'FreeBSD': 'freebsd',
+        'OpenBSD': 'openbsd',
+        'QNX': 'qnx',
+    }.get(system_name, ''))
+    if variables.get('VCPKG_LIBRARY_LINKAGE') == 'static':
+        identifiers.add('static')
+    if variables.get('VCPKG_CRT_LINKAGE') == 'static':
+        identifiers.add('staticcrt')
+    if variables.get('VCPKG_XBOX_CONSOLE_TARGET'):
+        identifiers.add('xbox')
+    if triplet == host_triplet:
+        identifiers.add('native')
+    identifiers.discard('')
+    return identifiers
+
+
+# Manifests
+
+def parse_dependency(dependency):
+    """(name, features, default-features, platform, host, version>=) of a dependency in vcpkg.json"""
+    if isinstance(dependency, str):
+        return [dependency, [], True, '', False, None]
+    features = []
+    for feature in dependency.get('features', []):
+        if isinstance(feature, str):
+            features.append([feature, ''])
+        else:
+            features.append([feature['name'], feature.get('platform', '')])
+    return [dependency['name'], features, dependency.get('default-features', True),
+            dependency.get('platform', ''), dependency.get('host', False), dependency.get('version>=')]
+
+
+def parse_manifest(manifest):
+    """The graph node of a port: its features with their dependencies, default features and supports."""
+    features = {CORE: {'dependencies': [parse_dependency(d) for d in manifest.get('dependencies', [])],
+                       'supports': manifest.get('supports', '')}}
+    manifest_features = manifest.get('features', {})
+    if isinstance(manifest_features, list):
+        manifest_features = {feature['name']: feature for feature in manifest_features}
+    for name, feature in manifest_features.items():
+        features[name] = {'dependencies': [parse_dependency(d) for d in feature.get('dependencies', [])],
+                          'supports': feature.get('supports', '')}
+    default_features = []
+    for feature in manifest.get('default-features', []):
+        if isinstance(feature, str):
+            default_features.append([feature, ''])
+        else:
+            default_features.append([feature['name'], feature.get('platform', '')])
+    return {'features': features, 'default-features': default_features}
+
+
+def get_fingerprint(path):
+    stat = os.stat(path)
+    return [stat.st_mtime_ns, stat.st_size]
+
+
+def refresh_graph(graph, ports_directories):
+    """Re-parses the manifests whose fingerprint and hash changed. Returns the number of parsed manifests.
+
+    A port is taken from the first of ports_directories which contains it.
+    """
+    previous_ports = graph.get('ports', {})
+    ports = {}
+    parsed_count = 0
+    for ports_directory in ports_directories:
+        for port_name in sorted(os.listdir(ports_directory)):
+            manifest_path = os.path.join(ports_directory, port_name, 'vcpkg.json')
+            if port_name in ports or not os.path.exists(manifest_path):
+                continue
+            fingerprint = get_fingerprint(manifest_path)
+            previous = previous_ports.get(port_name)
+            if previous is not None and previous['fingerprint'] == fingerprint:
+                ports[port_name] = previous
+                continue
+            with open(manifest_path, 'rb') as manifest_file:
+                content = manifest_file.read()
+            sha256 = hashlib.sha256(content).hexdigest()
+            if previous is not None and previous['sha256'] == sha256:
+                ports[port_name] = dict(previous, fingerprint=fingerprint)
+                continue
+            parsed_count += 1
+            try:
+                node = parse_manifest(json.loads(content.decode('utf-8-sig')))
+            except (json.JSONDecodeError, KeyError, TypeError) as e:
+                print(f'Error: Decoding {manifest_path}\n{e}\n', file=sys.stderr)
+                continue
+            ports[port_name] = dict(node, fingerprint=fingerprint, sha256=sha256)
+
+    # Reverse adjacency: dependency -> [[dependent, feature, dependency index]]
+    reverse = {}
+    for port_name, node in ports.items():
+        for feature_name, feature in node['features'].items():
+            for i, dependency in enumerate(feature['dependencies']):
+                if dependency[0] != port_name:
+                    reverse.setdefault(dependency[0], []).append([port_name, feature_name, i])
+    # Resolved features only depend on the manifests
+    resolved = graph.get('resolved', {}) if parsed_count == 0 and ports.keys() == previous_ports.keys() else {}
+    graph.clear()
+    graph.update({'format': GRAPH_FORMAT, 'ports': ports, 'reverse': reverse, 'resolved': resolved})
+    return parsed_count
+
+
+def load_graph(graph_path):
+    if not os.path.exists(graph_path):
+        return {}
+    with open(graph_path, 'r') as graph_file:
+        try:
+            graph = json.load(graph_file)
+        except json.JSONDecodeError as e:
+            print(f'Warning: Ignoring {graph_path}: {e}', file=sys.stderr)
+            return {}
+    return graph if graph.get('format') == GRAPH_FORMAT else {}
+
+
+def save_graph(graph, graph_path):
+    os.makedirs(os.path.dirname(os.path.abspath(graph_path)), exist_ok=True)
+    temp_path = f'{graph_path}.{os.getpid()}.tmp'
+    with open(temp_path, 'w') as graph_file:
+        json.dump(graph, graph_file, separators=(',', ':'))
+    os.replace(temp_path, graph_path)
+
+
+# Queries
+
+class TripletGraph:
+    """The graph of a triplet: the features installed for each port and the resulting dependency edges."""
+
+    def __init__(self, graph, triplet, host_triplet, requested_features, all_features, roots=None):
+        self.graph = graph
+        self.ports = graph['ports']
+        self.identifiers = get_triplet_identifiers(triplet, host_triplet)
+        self.host_identifiers = get_triplet_identifiers(host_triplet, host_triplet)
+        self.evaluated = {}
+        key = json.dumps([triplet, host_triplet, sorted(requested_features.items()), all_features,
+                          sorted(roots) if roots is not None else None])
+        resolved = graph['resolved'].get(key)
+        self.resolved = resolved is None
+        if resolved is None:
+            active_features = self._resolve_features(requested_features, all_features, roots)
+            graph['resolved'][key] = {name: sorted(features) for name, features in active_features.items()}
+            self.active_features = active_features
+        else:
+            self.active_features = {name: set(features) for name, features in resolved.items()}
+
+    def holds(self, expression, host=False):
+        if not expression:
+            return True
+        key = (expression, host)
+        if key not in self.evaluated:
+            self.evaluated[key] = evaluate_platform_expression(
+                expression, self.host_identifiers if host else self.identifiers)
+        return self.evaluated[key]
+
+    def is_supported(self, port_name):
+        node = self.ports.get(port_name)
+        return node is not None and self.holds(node['features'][CORE]['supports'])
+
+    def _default_features(self, port_name, host):
+        return [name for name, platform in self.ports[port_name]['default-features'] if self.holds(platform, host)]
+
+    def _resolve_features(self, requested_features, all_features, roots):
+        """Every supported port (or only `roots` and their dependencies) with core and default features,
+        plus what is requested by users and dependencies."""
+        active = {}
+        pending = []
+
+        def request(port_name, features, host):
+            if port_name not in self.ports or not self.is_supported(port_name):
+                return
+            features = [feature for feature in features
+                        if feature in self.ports[port_name]['features'] and self.holds(
+                            self.ports[port_name]['features'][feature]['supports'], host)]
+            current = active.setdefault(port_name, set())
+            new_features = set(features) - current
+            if new_features:
+                current.update(new_features)
+                pending.extend((port_name, feature, host) for feature in new_features)
+
+        for port_name, node in self.ports.items():
+            if roots is not None and port_name not in roots:
+                continue
+            if all_features:
+                features = list(node['features'])
+            else:
+                features = [CORE] + self._default_features(port_name, False)
+            request(port_name, features + requested_features.get(port_name, []), False)
+
+        while pending:
+            port_name, feature, host = pending.pop()
+            for name, features, default_features, platform, dependency_host, _ in \
+                    self.ports[port_name]['features'][feature]['dependencies']:
+                if not self.holds(platform, host):
+                    continue
+                requested = [CORE] + [f for f, f_platform in features if self.holds(f_platform, host)]
+                if default_features and name in self.ports:
+                    requested += self._default_features(name, host or dependency_host)
+                request(name, requested, host or dependency_host)
+        return active
+
+    def dependents(self, port_name):
+        """The ports with an installed feature which depends on `port_name` on this triplet."""
+        result = set()
+        for dependent, feature, i in self.graph['reverse'].get(port_name, []):
+            if feature not in self.active_features.get(dependent, ()):
+                continue
+            _, _, _, platform, _, _ = self.ports[dependent]['features'][feature]['dependencies'][i]
+            if self.holds(platform):
+                result.add(dependent)
+        return result
+
+    def dependencies(self, port_name):
+        result = set()
+        for feature in self.active_features.get(port_name, ()):
+            for name, _, _, platform, _, _ in self.ports[port_name]['features'][feature]['dependencies']:
+                if name != port_name and name in self.active_features and self.holds(platform):
+                    result.add(name)
+        return result
+
+    def affected(self, changed_ports):
+        """The changed ports and everything which transitively depends on them."""
+        affected = set(port_name for port_name in changed_ports if port_name in self.ports)
+        pending = list(affected)
+        while pending:
+            for dependent in self.dependents(pending.pop()):
+                if dependent not in affected:
+                    affected.add(dependent)
+                    pending.append(dependent)
+        return affected
+
+
+def parse_port_features(specs):
+    """{port: [feature, ...]} of `port[feature,...]` specs"""
+    requested = {}
+    for spec in specs:
+        match = re.match(r'^([a-z0-9-]+)\[([^\]]*)\]$', spec)
+        if not match:
+            raise ValueError(f'Invalid feature spec: {spec}')
+        requested.setdefault(match.group(1), []).extend(f.strip() for f in match.group(2).split(',') if f.strip())
+    return requested
+
+
+def get_changed_ports(revision):
+    output = subprocess.run(['git', '-C', SCRIPT_DIRECTORY, 'diff', '--name-only', revision, '--', ':(top)ports/'],
+                            capture_output=True, encoding='utf-8')
+    if output.returncode != 0:
+        print(f'git diff failed:', output.stderr.strip(), file=sys.stderr)
+        sys.exit(1)
+    return sorted(set(line.split('/')[1] for line in output.stdout.splitlines() if line.count('/') >= 2))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Dependency graph of the port manifests, refreshed incrementally.')
+    parser.add_argument('--graph', default=GRAPH_PATH, help='path of the graph snapshot')
+    parser.add_argument('--overlay-ports', action='append', default=[], help='additional ports directory, which takes precedence over the builtin ports')
+    subparsers = parser.add_subparsers(dest='command', required=True)
+    subparsers.add_parser('refresh', help='re-parse the changed manifests')
+    for command, help_text in (('affected', 'ports which must be rebuilt when the given ports change'),
+                               ('dependents', 'ports which directly depend on the given ports'),
+                               ('dependencies', 'direct dependencies of the given ports')):
+        query_parser = subparsers.add_parser(command, help=help_text)
+        query_parser.add_argument('ports', nargs='*')
+        query_parser.add_argument('--triplet', required=True)
+        query_parser.add_argument('--host-triplet', help='by default the triplet')
+        query_parser.add_argument('--features', nargs='*', default=[], metavar='PORT[FEATURES]',
+                                  help='features installed in addition to the default features, e.g. poco[sqlite3]')
+        query_parser.add_argument('--all-features', action='store_true', help='install all features of all ports')
+        query_parser.add_argument('--changed-from', metavar='REVISION',
+                                  help='add the ports changed since a git revision')
+    args = parser.parse_args()
+
+    start_time = time.time()
+    graph = load_graph(args.graph)
+    previous_port_names = set(graph.get('ports', {}))
+    # Like vcpkg, overlays take precedence over the builtin ports, in the order given
+    parsed_count = refresh_graph(graph, args.overlay_ports + [PORTS_DIRECTORY])
+    if parsed_count or previous_port_names != set(graph['ports']) or not os.path.exists(args.graph):
+        save_graph(graph, args.graph)
+    if args.command == 'refresh':
+        print(f'Parsed {parsed_count} of {len(graph["ports"])} manifests, '
+              f'elapsed time: {time.time() - start_time:.2f} seconds')
+        return
+
+    ports = list(args.ports)
+    if args.changed_from:
+        ports += get_changed_ports(args.changed_from)
+    try:
+        triplet_graph = TripletGraph(graph, args.triplet, args.host_triplet or args.triplet,
+                                     parse_port_features(args.features), args.all_features)
+    except ValueError as e:
+        print(f'Error: {e}', file=sys.stderr)
+        sys.exit(1)
+    if triplet_graph.resolved:
+        save_graph(graph, args.graph)
+    for port_name in ports:
+        if port_name not in graph['ports']:
+            print(f'Warning: Unknown port {port_name}', file=sys.stderr)
+
+    if args.command == 'affected':
+        result = triplet_graph.affected(ports)
+    else:
+        result = set()
+        for port_name in ports:
+            result |= getattr(triplet_graph, args.command)(port_name)
+    for port_name in sorted(result):
+        print(port_name)
+    print(f'{len(result)} ports, elapsed time: {(time.time() - start_time) * 1000:.0f} ms', file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
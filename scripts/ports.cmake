@@ -88,11 +88,15 @@ include("${SCRIPTS}/cmake/vcpkg_replace_string.cmake")
 include("${SCRIPTS}/cmake/vcpkg_test_cmake.cmake")
 
 include("${SCRIPTS}/cmake/z_vcpkg_apply_patches.cmake")
+include("${SCRIPTS}/cmake/z_vcpkg_compiler_cache.cmake")
+include("${SCRIPTS}/cmake/z_vcpkg_download_store.cmake")
+include("${SCRIPTS}/cmake/z_vcpkg_file_sha512.cmake")
 include("${SCRIPTS}/cmake/z_vcpkg_forward_output_variable.cmake")
 include("${SCRIPTS}/cmake/z_vcpkg_function_arguments.cmake")
 include("${SCRIPTS}/cmake/z_vcpkg_get_cmake_vars.cmake")
 include("${SCRIPTS}/cmake/z_vcpkg_prettify_command_line.cmake")
 include("${SCRIPTS}/cmake/z_vcpkg_setup_pkgconfig_path.cmake")
+include("${SCRIPTS}/cmake/z_vcpkg_trace.cmake")
 
 include("${SCRIPTS}/cmake/z_vcpkg_fixup_rpath.cmake")
 include("${SCRIPTS}/cmake/z_vcpkg_fixup_rpath_macho.cmake")
@@ -193,6 +197,11 @@ target system or to the host system. Use a prefixed variable instead.
     set(Z_VCPKG_ERROR_LOG_COLLECTION_FILE "${CURRENT_BUILDTREES_DIR}/error-logs-${TARGET_TRIPLET}.txt")
     file(REMOVE "${Z_VCPKG_ERROR_LOG_COLLECTION_FILE}")
 
+    if(X_PORT_TRACE)
+        file(REMOVE "${CURRENT_BUILDTREES_DIR}/trace-${TARGET_TRIPLET}.events.log")
+    endif()
+    z_vcpkg_compiler_cache_setup()
+    z_vcpkg_trace_begin(z_port_trace)
     include("${CURRENT_PORT_DIR}/portfile.cmake")
 
     foreach(z_post_portfile_include IN LISTS Z_VCPKG_POST_PORTFILE_INCLUDES)
@@ -202,13 +211,18 @@ target system or to the host system. Use a prefixed variable instead.
 
     if(DEFINED PORT)
         # Always fixup RPATH on linux and osx unless explicitly disabled.
+        z_vcpkg_trace_begin(z_fixup_trace)
         if(VCPKG_FIXUP_ELF_RPATH OR (VCPKG_TARGET_IS_LINUX AND NOT DEFINED VCPKG_FIXUP_ELF_RPATH))
             z_vcpkg_fixup_rpath_in_dir()
         endif()
         if(VCPKG_FIXUP_MACHO_RPATH OR (VCPKG_TARGET_IS_OSX AND NOT DEFINED VCPKG_FIXUP_MACHO_RPATH))
             z_vcpkg_fixup_macho_rpath_in_dir()
         endif()
+        z_vcpkg_trace_end("${z_fixup_trace}" NAME "fixup rpath" CATEGORY fixup)
+        z_vcpkg_compiler_cache_report()
         include("${SCRIPTS}/build_info.cmake")
+        z_vcpkg_trace_end("${z_port_trace}" NAME "${PORT}" CATEGORY port)
+        z_vcpkg_trace_write()
     endif()
 elseif(CMD STREQUAL "CREATE")
     if(NOT DEFINED PORT_PATH)
@@ -0,0 +1,148 @@
+# Stand-in for an FTP server: serves <directory> read-only over FTP, with MLSD, LIST, MDTM and REST, while <command> runs.
+# "{port}" in the command is replaced by the port of the server. Every RETR is appended to <log> as "<path> <offset>".
+# If <abort-after> is not 0, the first RETR of every larger file stops after that many bytes with 426 and the server
+# then closes the control connection, as a broken connection would. Exits with the exit code of the command.
+# Usage: ftp-server.py <directory> <abort-after> <log> <command>...
+
+import os
+import socket
+import socketserver
+import subprocess
+import sys
+import threading
+import time
+
+
+def ftp_time(path):
+    return time.strftime('%Y%m%d%H%M%S', time.gmtime(os.path.getmtime(path)))
+
+
+class FtpHandler(socketserver.StreamRequestHandler):
+    def setup(self):
+        super().setup()
+        self.passive = None
+        self.rest = 0
+
+    def reply(self, line):
+        self.wfile.write(line.encode() + b'\r\n')
+        self.wfile.flush()
+
+    def local_path(self, argument):
+        return os.path.join(self.server.directory, argument.lstrip('/'))
+
+    def accept_data(self):
+        passive, self.passive = self.passive, None
+        connection, _ = passive.accept()
+        passive.close()
+        return connection
+
+    def handle(self):
+        self.reply('220 Stand-in FTP server ready')
+        for line in self.rfile:
+            command, _, argument = line.decode().rstrip('\r\n').partition(' ')
+            handler = getattr(self, 'ftp_' + command.upper(), None)
+            if handler is None:
+                self.reply('502 Command not implemented')
+            elif handler(argument) is False:
+                return
+
+    def ftp_USER(self, argument):
+        self.reply('331 Password required')
+
+    def ftp_PASS(self, argument):
+        self.reply('230 Logged in')
+
+    def ftp_TYPE(self, argument):
+        self.reply('200 Type set')
+
+    def ftp_QUIT(self, argument):
+        self.reply('221 Goodbye')
+        return False
+
+    def ftp_PASV(self, argument):
+        self.passive = socket.create_server(('127.0.0.1', 0))
+        port = self.passive.getsockname()[1]
+        self.reply(f'227 Entering Passive Mode (127,0,0,1,{port >> 8},{port & 0xff})')
+
+    def ftp_EPSV(self, argument):
+        self.passive = socket.create_server(('127.0.0.1', 0))
+        self.reply(f'229 Entering Extended Passive Mode (|||{self.passive.getsockname()[1]}|)')
+
+    def ftp_REST(self, argument):
+        self.rest = int(argument)
+        self.reply(f'350 Restarting at {self.rest}')
+
+    def ftp_MDTM(self, argument):
+        path = self.local_path(argument)
+        if not os.path.isfile(path):
+            self.reply('550 No such file')
+            return
+        self.reply(f'213 {ftp_time(path)}')
+
+    def ftp_MLSD(self, argument):
+        self.send_listing(argument, lambda name, path: (
+            f'type={"dir" if os.path.isdir(path) else "file"};size={os.path.getsize(path)};modify={ftp_time(path)}; {name}'))
+
+    def ftp_LIST(self, argument):
+        self.send_listing(argument, lambda name, path: (
+            f'{"d" if os.path.isdir(path) else "-"}rw-r--r-- 1 owner group {os.path.getsize(path)} Jan 01 12:00 {name}'))
+
+    def send_listing(self, argument, format_entry):
+        directory = self.local_path(argument)
+        if not os.path.isdir(directory):
+            self.reply('550 No such directory')
+            return
+        self.reply('150 Listing')
+        with self.accept_data() as connection:
+            for name in sorted(os.listdir(directory)):
+                connection.sendall(format_entry(name, os.path.join(directory, name)).encode() + b'\r\n')
+        self.reply('226 Listing sent')
+
+    def ftp_RETR(self, argument):
+        path = self.local_path(argument)
+        offset, self.rest = self.rest, 0
+        with self.server.lock:
+            with open(self.server.log, 'a') as log:
+                log.write(f'{argument} {offset}\n')
+            abort = self.server.abort_after and argument not in self.server.aborted
+            self.server.aborted.add(argument)
+        if not os.path.isfile(path):
+            self.reply('550 No such file')
+            return
+        with open(path, 'rb') as f:
+            f.seek(offset)
+            data = f.read()
+        abort = abort and len(data) > self.server.abort_after
+        self.reply('150 Opening BINARY mode data connection')
+        with self.accept_data() as connection:
+            connection.sendall(data[:self.server.abort_after] if abort else data)
+        if abort:
+            self.reply('426 Connection closed; transfer aborted')
+            return False
+        self.reply('226 Transfer complete')
+
+
+def main():
+    if len(sys.argv) < 5:
+        print(f'Usage: {sys.argv[0]} <directory> <abort-after> <log> <command>...', file=sys.stderr)
+        return 2
+    server = socketserver.ThreadingTCPServer(('127.0.0.1', 0), FtpHandler)
+    server.daemon_threads = True
+    server.directory = sys.argv[1]
+    server.abort_after = int(sys.argv[2])
+    server.log = sys.argv[3]
+    server.lock = threading.Lock()
+    server.aborted = set()
+    thread = threading.Thread(target=server.serve_forever, daemon=True)
+    thread.start()
+    try:
+        port = str(server.server_address[1])
+        command = [arg.replace('{port}', port) for arg in sys.argv[4:]]
+        return subprocess.run(command).returncode
+    finally:
+        server.shutdown()
+        server.server_close()
+
+
+if __name__ == '__main__':
+    sys.exit(main())
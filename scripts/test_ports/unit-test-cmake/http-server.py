@@ -0,0 +1,71 @@
+# Stand-in for a download server: serves <directory> over HTTP, with byte ranges, while <command> runs.
+# "{port}" in the command is replaced by the port of the server. Every GET request is appended to <log>
+# as "<path> <range>", followed by its Authorization header if there is one. Exits with the exit code of the command.
+# Usage: http-server.py <directory> <log> <command>...
+
+import http.server
+import os
+import re
+import subprocess
+import sys
+import threading
+
+
+class RangeRequestHandler(http.server.BaseHTTPRequestHandler):
+    def do_GET(self):
+        range_header = self.headers.get('Range')
+        authorization = self.headers.get('Authorization')
+        with open(self.server.log, 'a') as log:
+            log.write(f'{self.path} {range_header}' + (f' {authorization}' if authorization else '') + '\n')
+
+        path = os.path.join(self.server.directory, self.path.lstrip('/'))
+        if not os.path.isfile(path):
+            self.send_error(404)
+            return
+        with open(path, 'rb') as f:
+            data = f.read()
+        size = len(data)
+
+        match = re.fullmatch(r'bytes=(\d+)-(\d*)', range_header or '')
+        if match:
+            first = int(match[1])
+            last = min(int(match[2]) if match[2] else size - 1, size - 1)
+            if first > last:
+                self.send_response(416)
+                self.send_header('Content-Range', f'bytes */{size}')
+                self.send_header('Content-Length', '0')
+                self.end_headers()
+                return
+            self.send_response(206)
+            self.send_header('Content-Range', f'bytes {first}-{last}/{size}')
+            data = data[first:last + 1]
+        else:
+            self.send_response(200)
+        self.send_header('Content-Length', str(len(data)))
+        self.end_headers()
+        self.wfile.write(data)
+
+    def log_message(self, format, *args):
+        pass
+
+
+def main():
+    if len(sys.argv) < 4:
+        print(f'Usage: {sys.argv[0]} <directory> <log> <command>...', file=sys.stderr)
+        return 2
+    server = http.server.ThreadingHTTPServer(('127.0.0.1', 0), RangeRequestHandler)
+    server.directory = sys.argv[1]
+    server.log = sys.argv[2]
+    thread = threading.Thread(target=server.serve_forever, daemon=True)
+    thread.start()
+    try:
+        port = str(server.server_address[1])
+        command = [arg.replace('{port}', port) for arg in sys.argv[3:]]
+        return subprocess.run(command).returncode
+    finally:
+        server.shutdown()
+        server.server_close()
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -185,16 +185,52 @@ endif()
 if("setup-pkgconfig-path" IN_LIST FEATURES)
     include("${CMAKE_CURRENT_LIST_DIR}/test-z_vcpkg_setup_pkgconfig_path.cmake")
 endif()
+if("find-acquire-program" IN_LIST FEATURES)
+    include("${CMAKE_CURRENT_LIST_DIR}/test-z_vcpkg_find_acquire_program_registry.cmake")
+endif()
 if("fixup-pkgconfig" IN_LIST FEATURES)
     include("${CMAKE_CURRENT_LIST_DIR}/test-vcpkg_fixup_pkgconfig.cmake")
 endif()
 if("fixup-rpath" IN_LIST FEATURES)
     include("${CMAKE_CURRENT_LIST_DIR}/test-z_vcpkg_calculate_corrected_rpath.cmake")
     include("${CMAKE_CURRENT_LIST_DIR}/test-z_vcpkg_calculate_corrected_rpath_macho.cmake")
+    include("${CMAKE_CURRENT_LIST_DIR}/test-z_vcpkg_fixup_rpath_report_entry.cmake")
+    include("${CMAKE_CURRENT_LIST_DIR}/test-z_vcpkg_get_elf_file_type.cmake")
+endif()
+if("compiler-cache" IN_LIST FEATURES)
+    include("${CMAKE_CURRENT_LIST_DIR}/test-z_vcpkg_compiler_cache.cmake")
+endif()
+if("configure-make" IN_LIST FEATURES)
+    include("${CMAKE_CURRENT_LIST_DIR}/test-z_vcpkg_configure_make_update_config_site.cmake")
+endif()
+if("download-distfile" IN_LIST FEATURES)
+    include("${CMAKE_CURRENT_LIST_DIR}/test-z_vcpkg_download_distfile_plan_segments.cmake")
+    include("${CMAKE_CURRENT_LIST_DIR}/test-vcpkg_download_distfile.cmake")
+endif()
+if("download-store" IN_LIST FEATURES)
+    include("${CMAKE_CURRENT_LIST_DIR}/test-z_vcpkg_download_store.cmake")
+endif()
+if("execute-build-process" IN_LIST FEATURES)
+    include("${CMAKE_CURRENT_LIST_DIR}/test-z_vcpkg_execute_build_process_set_jobs.cmake")
 endif()
 if("execute-required-process" IN_LIST FEATURES)
     include("${CMAKE_CURRENT_LIST_DIR}/test-vcpkg_execute_required_process.cmake")
 endif()
+if("extract-source-archive" IN_LIST FEATURES)
+    include("${CMAKE_CURRENT_LIST_DIR}/test-vcpkg_extract_source_archive.cmake")
+endif()
+if("file-sha512" IN_LIST FEATURES)
+    include("${CMAKE_CURRENT_LIST_DIR}/test-z_vcpkg_file_sha512_memo_path.cmake")
+endif()
+if("get-cmake-vars" IN_LIST FEATURES)
+    include("${CMAKE_CURRENT_LIST_DIR}/test-z_vcpkg_get_cmake_vars_cache_key.cmake")
+endif()
+if("versions-db" IN_LIST FEATURES)
+    include("${CMAKE_CURRENT_LIST_DIR}/test-generatePortVersionsDb.cmake")
+endif()
+if("get-external" IN_LIST FEATURES)
+    include("${CMAKE_CURRENT_LIST_DIR}/test-get_external.cmake")
+endif()
 
 if(Z_VCPKG_UNIT_TEST_HAS_ERROR)
     _message(FATAL_ERROR "At least one test failed")
@@ -0,0 +1,60 @@
+# scripts/generatePortVersionsDb.py [--full]
+
+block(SCOPE_FOR VARIABLES)
+
+vcpkg_find_acquire_program(GIT)
+vcpkg_find_acquire_program(PYTHON3)
+
+set(test_dir "${CURRENT_BUILDTREES_DIR}/unit-test-versions-db")
+file(REMOVE_RECURSE "${test_dir}")
+file(COPY "${SCRIPTS}/generatePortVersionsDb.py" DESTINATION "${test_dir}/scripts")
+file(WRITE "${test_dir}/ports/zlib/vcpkg.json" [[{ "name": "zlib", "version": "1.3.1" }]])
+foreach(command IN ITEMS "init;-q" "add;ports" "-c;user.name=unit-test;-c;user.email=unit-test@localhost;commit;-q;-m;zlib")
+    execute_process(COMMAND "${GIT}" ${command} WORKING_DIRECTORY "${test_dir}" COMMAND_ERROR_IS_FATAL ANY)
+endforeach()
+
+# Versions which are not reachable from HEAD, as in a shallow clone, and no revision marker
+set(old_tree "1111111111111111111111111111111111111111")
+file(WRITE "${test_dir}/versions/z-/zlib.json"
+    "{\"versions\": [{\"git-tree\": \"${old_tree}\", \"version\": \"1.2.13\", \"port-version\": 0}]}\n")
+
+function(unit_test_generate_versions_db)
+    execute_process(
+        COMMAND "${PYTHON3}" "${test_dir}/scripts/generatePortVersionsDb.py" ${ARGN}
+        RESULT_VARIABLE result
+        OUTPUT_QUIET
+        ERROR_QUIET
+    )
+    set(versions "")
+    file(READ "${test_dir}/versions/z-/zlib.json" contents)
+    string(JSON count LENGTH "${contents}" versions)
+    math(EXPR last "${count} - 1")
+    foreach(i RANGE "${last}")
+        string(JSON version GET "${contents}" versions ${i} version)
+        list(APPEND versions "${version}")
+    endforeach()
+    set(result "${result}" PARENT_SCOPE)
+    set(versions "${versions}" PARENT_SCOPE)
+endfunction()
+
+# Without a marker, the history of the checkout is merged into the existing files.
+unit_test_generate_versions_db()
+unit_test_check_variable_equal([[]] result 0)
+unit_test_check_variable_equal([[]] versions "1.3.1;1.2.13")
+unit_test_check_variable_equal(
+    [[execute_process(COMMAND "${GIT}" rev-parse HEAD WORKING_DIRECTORY "${test_dir}" OUTPUT_VARIABLE head OUTPUT_STRIP_TRAILING_WHITESPACE)
+      set(marker_exists OFF)
+      if(EXISTS "${test_dir}/versions/${head}")
+          set(marker_exists ON)
+      endif()]]
+    marker_exists ON
+)
+
+# --full regenerates the files from the reachable history only.
+unit_test_generate_versions_db(--full)
+unit_test_check_variable_equal([[]] result 0)
+unit_test_check_variable_equal([[]] versions "1.3.1")
+
+file(REMOVE_RECURSE "${test_dir}")
+
+endblock()
@@ -0,0 +1,77 @@
+# get_external.py --host <host> --port <port> --remote-path <path> --local-path <path>
+
+block(SCOPE_FOR VARIABLES)
+
+vcpkg_find_acquire_program(PYTHON3)
+
+set(test_dir "${CURRENT_BUILDTREES_DIR}/unit-test-get-external")
+file(REMOVE_RECURSE "${test_dir}")
+# The script changes to its own directory.
+file(COPY "${SCRIPTS}/../get_external.py" DESTINATION "${test_dir}")
+
+# Larger than the 1 MiB blocks of a transfer
+string(REPEAT "0123456789abcdef" 196608 contents)
+file(WRITE "${test_dir}/served/crashpad/crashpad.bin" "${contents}")
+unset(contents)
+file(WRITE "${test_dir}/served/mini_chromium/build/build_config.h" "#pragma once\n")
+
+# Synchronizes served/ into local/ through the server stand-in; sets `requests` to the RETR requests it received.
+function(unit_test_get_external abort_after)
+    file(REMOVE "${test_dir}/requests.log")
+    file(TOUCH "${test_dir}/requests.log")
+    execute_process(
+        COMMAND "${PYTHON3}" "${CMAKE_CURRENT_LIST_DIR}/ftp-server.py" "${test_dir}/served" "${abort_after}" "${test_dir}/requests.log"
+            "${PYTHON3}" "${test_dir}/get_external.py" --host 127.0.0.1 --port {port} --remote-path /
+            --local-path "${test_dir}/local" --connections 1
+        RESULT_VARIABLE result
+        OUTPUT_VARIABLE output
+        ERROR_VARIABLE output
+    )
+    file(STRINGS "${test_dir}/requests.log" requests)
+    list(SORT requests)
+    set(result "${result}" PARENT_SCOPE)
+    set(output "${output}" PARENT_SCOPE)
+    set(requests "${requests}" PARENT_SCOPE)
+endfunction()
+
+# A broken connection is replaced, and the transfer is resumed from the partial file.
+unit_test_get_external(1000000)
+unit_test_check_variable_equal([[]] result 0)
+unit_test_check_variable_equal([[]] requests
+    "/crashpad/crashpad.bin 0;/crashpad/crashpad.bin 1000000;/mini_chromium/build/build_config.h 0")
+foreach(file IN ITEMS "crashpad/crashpad.bin" "mini_chromium/build/build_config.h")
+    file(SHA512 "${test_dir}/served/${file}" expected)
+    unit_test_check_variable_equal([[file(SHA512 "${test_dir}/local/${file}" actual)]] actual "${expected}")
+endforeach()
+
+# Unchanged files are not downloaded again.
+unit_test_get_external(0)
+unit_test_check_variable_equal([[]] result 0)
+unit_test_check_variable_equal([[]] requests "")
+
+# Remote names must not leave the local path.
+file(WRITE "${test_dir}/unsafe-names.py" [[
+import sys
+sys.path.insert(0, sys.argv[1])
+import get_external
+
+class Client:
+    def list_directory(self, remote_path):
+        return {'..': (True, 0, None), '/escape.txt': (False, 1, 0)} if remote_path == '/' else {'escape.txt': (False, 1, 0)}
+    def download_file(self, remote_path, local_path, offset, callback):
+        raise AssertionError(f'downloaded {remote_path}')
+    def quit(self):
+        pass
+
+sys.exit(0 if get_external.FtpSync(Client, sys.argv[2], 1).sync('/') else 1)
+]])
+execute_process(COMMAND "${PYTHON3}" "${test_dir}/unsafe-names.py" "${test_dir}" "${test_dir}/unsafe/local"
+    RESULT_VARIABLE result OUTPUT_VARIABLE output)
+string(REGEX MATCHALL "[^\n]*: the remote name leaves the local path" errors "${output}")
+unit_test_check_variable_equal([[]] result 1)
+unit_test_check_variable_equal([[]] errors
+    "Error: ../escape.txt: the remote name leaves the local path;Error: /escape.txt: the remote name leaves the local path")
+
+file(REMOVE_RECURSE "${test_dir}")
+
+endblock()
@@ -0,0 +1,118 @@
+# vcpkg_download_distfile(<out-var> URLS <url> FILENAME <filename> SHA512 <sha512>) with X_VCPKG_SEGMENTED_DOWNLOADS
+
+block(SCOPE_FOR VARIABLES)
+
+vcpkg_find_acquire_program(PYTHON3)
+
+set(test_dir "${CURRENT_BUILDTREES_DIR}/unit-test-download-distfile")
+file(REMOVE_RECURSE "${test_dir}")
+set(filename "segmented.bin")
+
+# Two segments of 16 MiB at least, with contents which differ at every offset of a segment
+string(REPEAT "0123456789abcdef" 2162688 contents)
+file(WRITE "${test_dir}/served/${filename}" "${contents}")
+unset(contents)
+file(SHA512 "${test_dir}/served/${filename}" sha512)
+set(first_segment "0-17301503")
+string(SHA512 partial_key "${filename};${sha512}")
+string(SUBSTRING "${partial_key}" 0 16 partial_key)
+set(partial_dir "${test_dir}/downloads/partial/${filename}-${partial_key}")
+
+# vcpkg without asset caches: `cmake x-download ...` always fails.
+file(CONFIGURE OUTPUT "${test_dir}/download.cmake" CONTENT [[
+set(VCPKG_BASE_VERSION "@VCPKG_BASE_VERSION@")
+include("@SCRIPTS@/ports.cmake")
+set(DOWNLOADS "@test_dir@/downloads")
+set(X_VCPKG_NO_DOWNLOAD_STORE ON)
+set(X_VCPKG_SEGMENTED_DOWNLOADS ON)
+set(X_VCPKG_DOWNLOAD_SEGMENTS 2)
+set(ENV{VCPKG_COMMAND} "${CMAKE_COMMAND}")
+unset(ENV{X_VCPKG_ASSET_SOURCES})
+vcpkg_download_distfile(archive URLS "${URL}" FILENAME "@filename@" SHA512 "@sha512@" HEADERS ${HEADERS})
+]] @ONLY)
+
+# Downloads the file from the server stand-in; sets `requests` to the requests it received.
+function(unit_test_download_distfile out_result)
+    file(REMOVE "${test_dir}/requests.log")
+    file(TOUCH "${test_dir}/requests.log")
+    execute_process(
+        COMMAND "${PYTHON3}" "${CMAKE_CURRENT_LIST_DIR}/http-server.py" "${test_dir}/served" "${test_dir}/requests.log"
+            "${CMAKE_COMMAND}" "-DURL=http://127.0.0.1:{port}/${filename}" ${ARGN} -P "${test_dir}/download.cmake"
+        RESULT_VARIABLE result
+        OUTPUT_VARIABLE output
+        ERROR_VARIABLE output
+    )
+    file(STRINGS "${test_dir}/requests.log" requests)
+    list(SORT requests)
+    set("${out_result}" "${result}" PARENT_SCOPE)
+    set(output "${output}" PARENT_SCOPE)
+    set(requests "${requests}" PARENT_SCOPE)
+endfunction()
+
+# An interrupted download is continued where it stopped.
+file(READ "${test_dir}/served/${filename}" head LIMIT 1048576)
+file(WRITE "${partial_dir}/${first_segment}" "${head}")
+unit_test_download_distfile(result)
+unit_test_check_variable_equal([[]] result 0)
+unit_test_check_variable_equal([[]] requests
+    "/${filename} bytes=0-0;/${filename} bytes=1048576-17301503;/${filename} bytes=17301504-34603007")
+unit_test_check_variable_equal(
+    [[file(SHA512 "${test_dir}/downloads/${filename}" downloaded_sha512)]]
+    downloaded_sha512 "${sha512}"
+)
+unit_test_check_variable_equal(
+    [[set(partial_exists OFF)
+      if(EXISTS "${partial_dir}")
+          set(partial_exists ON)
+      endif()]]
+    partial_exists OFF
+)
+
+# Data which produces a file with a different hash fails the download and is never continued again.
+file(REMOVE "${test_dir}/downloads/${filename}")
+string(REPEAT "x" 1048576 corrupt)
+file(WRITE "${partial_dir}/${first_segment}" "${corrupt}")
+unit_test_download_distfile(result)
+unit_test_check_variable_equal(
+    [[set(failed OFF)
+      if(NOT result EQUAL "0" AND output MATCHES "File does not have expected hash")
+          set(failed ON)
+      endif()]]
+    failed ON
+)
+unit_test_check_variable_equal(
+    [[set(leftovers "")
+      foreach(path IN ITEMS "${partial_dir}" "${test_dir}/downloads/${filename}" "${test_dir}/downloads/temp/${filename}")
+          if(EXISTS "${path}")
+              list(APPEND leftovers "${path}")
+          endif()
+      endforeach()]]
+    leftovers ""
+)
+unit_test_download_distfile(result)
+unit_test_check_variable_equal([[]] result 0)
+unit_test_check_variable_equal([[]] requests
+    "/${filename} bytes=0-0;/${filename} bytes=0-17301503;/${filename} bytes=17301504-34603007")
+
+# Headers reach every segment.
+file(REMOVE "${test_dir}/downloads/${filename}")
+unit_test_download_distfile(result "-DHEADERS=Authorization: Bearer unit-test")
+unit_test_check_variable_equal([[]] result 0)
+unit_test_check_variable_equal([[]] requests
+    "/${filename} bytes=0-0 Bearer unit-test;/${filename} bytes=0-17301503 Bearer unit-test;/${filename} bytes=17301504-34603007 Bearer unit-test")
+
+# With asset sources, only vcpkg's download tool may be used; the server is never asked.
+file(REMOVE "${test_dir}/downloads/${filename}")
+unit_test_download_distfile(result "-DX_VCPKG_ASSET_SOURCES=x-block-origin")
+unit_test_check_variable_equal(
+    [[set(failed OFF)
+      if(NOT result EQUAL "0")
+          set(failed ON)
+      endif()]]
+    failed ON
+)
+unit_test_check_variable_equal([[]] requests "")
+
+file(REMOVE_RECURSE "${test_dir}")
+
+endblock()
@@ -0,0 +1,82 @@
+# vcpkg_extract_source_archive(<out-var> ARCHIVE <archive>) with X_VCPKG_SOURCE_CACHE_DIR
+# z_vcpkg_extract_source_archive_evict(<cache-dir>)
+
+block(SCOPE_FOR VARIABLES)
+
+set(test_dir "${CURRENT_BUILDTREES_DIR}/unit-test-extract-source-archive")
+file(REMOVE_RECURSE "${test_dir}")
+set(CURRENT_BUILDTREES_DIR "${test_dir}/buildtrees")
+set(X_VCPKG_SOURCE_CACHE_DIR "${test_dir}/source-cache")
+unset(X_VCPKG_SOURCE_CACHE_MAX_SIZE)
+unset(_VCPKG_EDITABLE)
+
+file(WRITE "${test_dir}/archive/project-1.0/CMakeLists.txt" "project(original)\n")
+execute_process(
+    COMMAND "${CMAKE_COMMAND}" -E tar czf "${test_dir}/project-1.0.tar.gz" project-1.0
+    WORKING_DIRECTORY "${test_dir}/archive"
+)
+
+function(unit_test_extract_source_archive out_var)
+    vcpkg_extract_source_archive(source_path ARCHIVE "${test_dir}/project-1.0.tar.gz")
+    set("${out_var}" "${source_path}" PARENT_SCOPE)
+endfunction()
+
+foreach(mode IN ITEMS reflink copy)
+    set(X_VCPKG_SOURCE_CACHE_LINK_MODE "${mode}")
+    file(REMOVE_RECURSE "${CURRENT_BUILDTREES_DIR}" "${X_VCPKG_SOURCE_CACHE_DIR}")
+
+    # The first extraction populates the store with a copy which in-place edits of the buildtree do not reach.
+    unit_test_extract_source_archive(source_path)
+    file(GLOB entries "${X_VCPKG_SOURCE_CACHE_DIR}/*")
+    unit_test_check_variable_equal(
+        [[list(LENGTH entries entry_count)]]
+        entry_count 1
+    )
+    unit_test_check_variable_equal(
+        [[file(READ "${entries}/size.txt" entry_size)]]
+        entry_size "0\n"
+    )
+    file(WRITE "${source_path}/CMakeLists.txt" "project(edited)\n")
+    unit_test_check_variable_equal(
+        [[file(READ "${entries}/src/CMakeLists.txt" contents)]]
+        contents "project(original)\n"
+    )
+
+    # A later extraction is checked out of the store; reflinks fall back to a copy where unsupported.
+    # In-place edits of the checkout do not reach the store either.
+    unit_test_extract_source_archive(source_path)
+    unit_test_check_variable_equal(
+        [[file(READ "${source_path}/CMakeLists.txt" contents)]]
+        contents "project(original)\n"
+    )
+    file(APPEND "${source_path}/CMakeLists.txt" "project(edited)\n")
+    unit_test_check_variable_equal(
+        [[file(READ "${entries}/src/CMakeLists.txt" contents)]]
+        contents "project(original)\n"
+    )
+endforeach()
+
+foreach(mode IN ITEMS symlink hardlink)
+    set(X_VCPKG_SOURCE_CACHE_LINK_MODE "${mode}")
+    unit_test_ensure_fatal_error([[z_vcpkg_extract_source_archive_copy_tree("${test_dir}/archive" "${test_dir}/copy")]])
+endforeach()
+unset(X_VCPKG_SOURCE_CACHE_LINK_MODE)
+
+# The least recently used entries are evicted; entries which are being populated are never touched.
+set(cache_dir "${test_dir}/evict")
+foreach(entry IN ITEMS oldest old.0a1b2c3d.tmp newest)
+    file(WRITE "${cache_dir}/${entry}/size.txt" "10\n")
+    file(TOUCH "${cache_dir}/${entry}/last-used")
+    execute_process(COMMAND "${CMAKE_COMMAND}" -E sleep 1.1)
+endforeach()
+set(X_VCPKG_SOURCE_CACHE_MAX_SIZE 15)
+z_vcpkg_extract_source_archive_evict("${cache_dir}")
+unit_test_check_variable_equal(
+    [[file(GLOB remaining RELATIVE "${cache_dir}" "${cache_dir}/*")
+      list(SORT remaining)]]
+    remaining "newest;old.0a1b2c3d.tmp"
+)
+
+file(REMOVE_RECURSE "${test_dir}")
+
+endblock()
@@ -0,0 +1,73 @@
+# z_vcpkg_compiler_cache_common_directory(<out-var> <dir>...)
+# z_vcpkg_compiler_cache_ccache_stats(<out-hits> <out-misses> <out-uncacheable> <stats-log>)
+# z_vcpkg_compiler_cache_setup() with X_VCPKG_COMPILER_CACHE
+
+block(SCOPE_FOR VARIABLES)
+
+unit_test_check_variable_equal([[z_vcpkg_compiler_cache_common_directory(dir "/vcpkg/buildtrees" "/vcpkg/installed/x64-linux" "/vcpkg/packages/zlib_x64-linux")]] dir "/vcpkg")
+unit_test_check_variable_equal([[z_vcpkg_compiler_cache_common_directory(dir "/vcpkg/buildtrees/" "/vcpkg/buildtrees/zlib")]] dir "/vcpkg/buildtrees")
+unit_test_check_variable_equal([[z_vcpkg_compiler_cache_common_directory(dir "/vcpkg/buildtrees" "/vcpkg-installed/x64-linux")]] dir "")
+unit_test_check_variable_equal([[z_vcpkg_compiler_cache_common_directory(dir "C:/vcpkg/buildtrees" "D:/installed")]] dir "")
+
+set(stats_log "${CURRENT_BUILDTREES_DIR}/unit-test-ccache-stats.log")
+file(WRITE "${stats_log}" [[
+# src/a.c
+direct_cache_miss
+preprocessed_cache_miss
+cache_miss
+# src/b.c
+direct_cache_hit
+# src/c.c
+direct_cache_miss
+preprocessed_cache_hit
+# conftest
+called_for_link
+# src/d.c
+cache_miss
+]])
+unit_test_check_variable_equal([[z_vcpkg_compiler_cache_ccache_stats(hits misses uncacheable "${stats_log}")]] hits 2)
+unit_test_check_variable_equal([[z_vcpkg_compiler_cache_ccache_stats(hits misses uncacheable "${stats_log}")]] misses 2)
+unit_test_check_variable_equal([[z_vcpkg_compiler_cache_ccache_stats(hits misses uncacheable "${stats_log}")]] uncacheable 1)
+file(REMOVE "${stats_log}")
+unit_test_check_variable_equal([[z_vcpkg_compiler_cache_ccache_stats(hits misses uncacheable "${stats_log}")]] hits 0)
+
+vcpkg_backup_env_variables(VARS CCACHE_DIR CCACHE_BASEDIR CCACHE_NOHASHDIR CCACHE_STATSLOG CMAKE_C_COMPILER_LAUNCHER CMAKE_CXX_COMPILER_LAUNCHER)
+set(VCPKG_TARGET_IS_WINDOWS OFF)
+set(VCPKG_C_FLAGS "-O2")
+set(VCPKG_CXX_FLAGS "-O2")
+set(X_VCPKG_COMPILER_CACHE_DIR "${CURRENT_BUILDTREES_DIR}/unit-test-compiler-cache")
+
+# A missing cache program only disables the cache.
+set(X_VCPKG_COMPILER_CACHE "${CURRENT_BUILDTREES_DIR}/unit-test-compiler-cache/missing/ccache")
+unset(Z_VCPKG_COMPILER_CACHE_PROGRAM CACHE)
+unit_test_check_variable_equal([[z_vcpkg_compiler_cache_setup()]] Z_VCPKG_COMPILER_LAUNCHER "")
+
+# The debug prefix map is only added on request.
+set(X_VCPKG_COMPILER_CACHE "${CURRENT_BUILDTREES_DIR}/unit-test-compiler-cache/bin/ccache")
+set(program "${X_VCPKG_COMPILER_CACHE}")
+if(CMAKE_HOST_WIN32)
+    string(APPEND program ".exe")
+endif()
+file(WRITE "${program}" "#!/bin/sh\n")
+file(CHMOD "${program}" PERMISSIONS OWNER_READ OWNER_WRITE OWNER_EXECUTE)
+unset(ENV{CCACHE_NOHASHDIR})
+unset(Z_VCPKG_COMPILER_CACHE_PROGRAM CACHE)
+unit_test_check_variable_equal([[z_vcpkg_compiler_cache_setup()]] Z_VCPKG_COMPILER_LAUNCHER "${program}")
+unit_test_check_variable_equal([[z_vcpkg_compiler_cache_setup()]] VCPKG_C_FLAGS "-O2")
+unit_test_check_variable_equal([[z_vcpkg_compiler_cache_setup()]] ENV{CCACHE_NOHASHDIR} "")
+set(X_VCPKG_COMPILER_CACHE_PREFIX_MAP ON)
+unit_test_check_variable_equal(
+    [[z_vcpkg_compiler_cache_setup()
+      set(has_prefix_map OFF)
+      if(VCPKG_CXX_FLAGS MATCHES "^-O2 -fdebug-prefix-map=.*=[.]\$")
+          set(has_prefix_map ON)
+      endif()]]
+    has_prefix_map ON
+)
+unit_test_check_variable_equal([[z_vcpkg_compiler_cache_setup()]] ENV{CCACHE_NOHASHDIR} "1")
+
+unset(Z_VCPKG_COMPILER_CACHE_PROGRAM CACHE)
+file(REMOVE_RECURSE "${X_VCPKG_COMPILER_CACHE_DIR}")
+vcpkg_restore_env_variables(VARS CCACHE_DIR CCACHE_BASEDIR CCACHE_NOHASHDIR CCACHE_STATSLOG CMAKE_C_COMPILER_LAUNCHER CMAKE_CXX_COMPILER_LAUNCHER)
+
+endblock()
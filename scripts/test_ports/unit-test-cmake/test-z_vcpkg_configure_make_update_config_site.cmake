@@ -0,0 +1,42 @@
+# z_vcpkg_configure_make_update_config_site(<config-site> <cache-file> <excluded-names>)
+
+block(SCOPE_FOR VARIABLES)
+
+# Toolchain probes are shared, results which depend on the port or on installed libraries are not.
+unit_test_check_variable_equal([[z_vcpkg_configure_make_is_cacheable(cacheable ac_cv_header_stdio_h)]] cacheable ON)
+unit_test_check_variable_equal([[z_vcpkg_configure_make_is_cacheable(cacheable lt_cv_sys_max_cmd_len)]] cacheable ON)
+unit_test_check_variable_equal([[z_vcpkg_configure_make_is_cacheable(cacheable ac_cv_header_zlib_h)]] cacheable OFF)
+unit_test_check_variable_equal([[z_vcpkg_configure_make_is_cacheable(cacheable ac_cv_func_memmove)]] cacheable OFF)
+unit_test_check_variable_equal([[z_vcpkg_configure_make_is_cacheable(cacheable ac_cv_env_CC_set)]] cacheable OFF)
+unit_test_check_variable_equal([[z_vcpkg_configure_make_is_cacheable(cacheable ac_cv_sizeof_off_t)]] cacheable OFF)
+
+set(config_site "${CURRENT_BUILDTREES_DIR}/unit-test-config.site")
+set(cache_file "${CURRENT_BUILDTREES_DIR}/unit-test-config.cache")
+file(REMOVE "${config_site}")
+file(WRITE "${cache_file}" [[
+# This file is a shell script that caches the results of configure
+ac_cv_env_CC_set=
+ac_cv_header_stdio_h=${ac_cv_header_stdio_h=yes}
+ac_cv_header_zlib_h=${ac_cv_header_zlib_h=yes}
+ac_cv_objext=${ac_cv_objext=o}
+ac_cv_path_SED=${ac_cv_path_SED=/usr/bin/sed}
+]])
+
+unit_test_check_variable_equal([[
+    z_vcpkg_configure_make_update_config_site("${config_site}" "${cache_file}" "ac_cv_path_SED")
+    file(STRINGS "${config_site}" entries REGEX "^[a-z]")
+]] entries [[ac_cv_header_stdio_h=${ac_cv_header_stdio_h=yes};ac_cv_objext=${ac_cv_objext=o}]])
+
+# Known results are kept, new results are appended.
+file(WRITE "${cache_file}" [[
+ac_cv_header_stdio_h=${ac_cv_header_stdio_h=no}
+ac_cv_c_bigendian=${ac_cv_c_bigendian=no}
+]])
+unit_test_check_variable_equal([[
+    z_vcpkg_configure_make_update_config_site("${config_site}" "${cache_file}" "")
+    file(STRINGS "${config_site}" entries REGEX "^[a-z]")
+]] entries [[ac_cv_header_stdio_h=${ac_cv_header_stdio_h=yes};ac_cv_objext=${ac_cv_objext=o};ac_cv_c_bigendian=${ac_cv_c_bigendian=no}]])
+
+file(REMOVE "${config_site}" "${cache_file}")
+
+endblock()
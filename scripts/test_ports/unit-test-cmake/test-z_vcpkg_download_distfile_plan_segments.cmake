@@ -0,0 +1,24 @@
+# z_vcpkg_download_distfile_plan_segments(<out-var> <size> <count> <min-size>)
+
+unit_test_check_variable_equal(
+    [[z_vcpkg_download_distfile_plan_segments(segments 100 4 10)]]
+    segments [[0-24;25-49;50-74;75-99]]
+)
+unit_test_check_variable_equal(
+    [[z_vcpkg_download_distfile_plan_segments(segments 10 3 1)]]
+    segments [[0-3;4-7;8-9]]
+)
+
+# Segments are never smaller than min-size, except for the last one.
+unit_test_check_variable_equal(
+    [[z_vcpkg_download_distfile_plan_segments(segments 100 4 40)]]
+    segments [[0-49;50-99]]
+)
+unit_test_check_variable_equal(
+    [[z_vcpkg_download_distfile_plan_segments(segments 5 4 40)]]
+    segments [[0-4]]
+)
+unit_test_check_variable_equal(
+    [[z_vcpkg_download_distfile_plan_segments(segments 1 1 1)]]
+    segments [[0-0]]
+)
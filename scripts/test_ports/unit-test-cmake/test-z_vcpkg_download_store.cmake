@@ -0,0 +1,85 @@
+# z_vcpkg_download_store_blob_path(<out-var> <kind> <key>)
+# z_vcpkg_download_store_lookup(<out-found> <file> <kind> <key>)
+# z_vcpkg_download_store_add(<file> <kind> <key>)
+
+block(SCOPE_FOR VARIABLES)
+
+set(DOWNLOADS "/vcpkg/downloads")
+unset(X_VCPKG_NO_DOWNLOAD_STORE)
+string(REPEAT "0123456789ABCDEF" 8 sha512)
+string(TOLOWER "${sha512}" sha512_lower)
+
+unit_test_check_variable_equal(
+    [[z_vcpkg_download_store_blob_path(blob sha512 "${sha512}")]]
+    blob "/vcpkg/downloads/tools/download-store/sha512/${sha512_lower}"
+)
+unit_test_check_variable_equal(
+    [[z_vcpkg_download_store_blob_path(blob git "4e0c9bd8e4e1ff1ac5ce0c06b2e2ba7dbe9ce2ea-lfs")]]
+    blob "/vcpkg/downloads/tools/download-store/git/4e0c9bd8e4e1ff1ac5ce0c06b2e2ba7dbe9ce2ea-lfs.tar.gz"
+)
+
+# The placeholder hash, truncated hashes and branch names do not address a blob.
+string(REPEAT "0" 128 zero_sha512)
+unit_test_check_variable_equal([[z_vcpkg_download_store_blob_path(blob sha512 "${zero_sha512}")]] blob "")
+unit_test_check_variable_equal([[z_vcpkg_download_store_blob_path(blob sha512 "0123456789abcdef")]] blob "")
+unit_test_check_variable_equal([[z_vcpkg_download_store_blob_path(blob git "main")]] blob "")
+unit_test_ensure_fatal_error([[z_vcpkg_download_store_blob_path(blob md5 "${sha512}")]])
+
+set(X_VCPKG_NO_DOWNLOAD_STORE ON)
+unit_test_check_variable_equal([[z_vcpkg_download_store_blob_path(blob sha512 "${sha512}")]] blob "")
+unset(X_VCPKG_NO_DOWNLOAD_STORE)
+
+# A file added by one port is linked for another port which expects the same contents.
+set(DOWNLOADS "${CURRENT_BUILDTREES_DIR}/unit-test-download-store")
+file(REMOVE_RECURSE "${DOWNLOADS}")
+file(WRITE "${DOWNLOADS}/poco-poco-1.12.5.tar.gz" "poco sources")
+file(SHA512 "${DOWNLOADS}/poco-poco-1.12.5.tar.gz" poco_sha512)
+z_vcpkg_download_store_add("${DOWNLOADS}/poco-poco-1.12.5.tar.gz" sha512 "${poco_sha512}")
+unit_test_check_variable_equal(
+    [[z_vcpkg_download_store_lookup(found "${DOWNLOADS}/fork-poco-1.12.5.tar.gz" sha512 "${poco_sha512}")]]
+    found ON
+)
+unit_test_check_variable_equal(
+    [[file(READ "${DOWNLOADS}/fork-poco-1.12.5.tar.gz" contents)]]
+    contents "poco sources"
+)
+unit_test_check_variable_equal(
+    [[file(STRINGS "${DOWNLOADS}/tools/download-store/sha512/${poco_sha512}.names" names)]]
+    names "poco-poco-1.12.5.tar.gz;fork-poco-1.12.5.tar.gz"
+)
+unit_test_check_variable_equal(
+    [[z_vcpkg_download_store_lookup(found "${DOWNLOADS}/other.tar.gz" sha512 "${sha512}")]]
+    found OFF
+)
+
+# A separate copy of a blob, as made where hard links are not supported, is not replaced again on every use.
+file(WRITE "${DOWNLOADS}/copy-poco-1.12.5.tar.gz" "poco sources")
+z_vcpkg_download_store_add("${DOWNLOADS}/copy-poco-1.12.5.tar.gz" sha512 "${poco_sha512}")
+z_vcpkg_file_sha512_fingerprint(copy_fingerprint "${DOWNLOADS}/copy-poco-1.12.5.tar.gz")
+execute_process(COMMAND "${CMAKE_COMMAND}" -E sleep 0.1)
+unit_test_check_variable_equal(
+    [[z_vcpkg_download_store_add("${DOWNLOADS}/copy-poco-1.12.5.tar.gz" sha512 "${poco_sha512}")
+      z_vcpkg_file_sha512_fingerprint(fingerprint "${DOWNLOADS}/copy-poco-1.12.5.tar.gz")]]
+    fingerprint "${copy_fingerprint}"
+)
+# A name which became a copy of the blob instead of a link to it is still removed with the blob.
+file(REMOVE "${DOWNLOADS}/fork-poco-1.12.5.tar.gz")
+file(WRITE "${DOWNLOADS}/fork-poco-1.12.5.tar.gz" "poco sources")
+
+# Blobs which were not used recently are removed together with their names.
+set(X_VCPKG_DOWNLOAD_STORE_MAX_AGE 0)
+file(TOUCH "${DOWNLOADS}/tools/download-store/sha512/${poco_sha512}.used")
+execute_process(COMMAND "${CMAKE_COMMAND}" -E sleep 1.1)
+z_vcpkg_download_store_collect()
+unit_test_check_variable_equal(
+    [[set(remaining "")
+      foreach(file IN ITEMS poco-poco-1.12.5.tar.gz fork-poco-1.12.5.tar.gz copy-poco-1.12.5.tar.gz "tools/download-store/sha512/${poco_sha512}")
+          if(EXISTS "${DOWNLOADS}/${file}")
+              list(APPEND remaining "${file}")
+          endif()
+      endforeach()]]
+    remaining ""
+)
+file(REMOVE_RECURSE "${DOWNLOADS}")
+
+endblock()
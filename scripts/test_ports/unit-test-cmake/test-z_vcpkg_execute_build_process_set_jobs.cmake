@@ -0,0 +1,63 @@
+# z_vcpkg_execute_build_process_set_jobs(<out-command> <out-found> <jobs> <command>...)
+# vcpkg_execute_build_process(COMMAND <command>... WORKING_DIRECTORY <dir> LOGNAME <name>)
+
+block(SCOPE_FOR VARIABLES)
+
+set(VCPKG_CONCURRENCY 16)
+
+unit_test_check_variable_equal(
+    [[z_vcpkg_execute_build_process_set_jobs(command found 4 cmake --build . -- -v -j16)]]
+    command [[cmake;--build;.;--;-v;-j4]]
+)
+unit_test_check_variable_equal(
+    [[z_vcpkg_execute_build_process_set_jobs(command found 4 cmake --build . -- -v -j16)]]
+    found ON
+)
+unit_test_check_variable_equal(
+    [[z_vcpkg_execute_build_process_set_jobs(command found 2 make -j 16 -f Makefile all)]]
+    command [[make;-j;2;-f;Makefile;all]]
+)
+unit_test_check_variable_equal(
+    [[z_vcpkg_execute_build_process_set_jobs(command found 2 xcodebuild -jobs 16)]]
+    command [[xcodebuild;-jobs;2]]
+)
+unit_test_check_variable_equal(
+    [[z_vcpkg_execute_build_process_set_jobs(command found 2 msbuild /m:16 /p:MultiProcMaxCount=16)]]
+    command [[msbuild;/m:2;/p:MultiProcMaxCount=2]]
+)
+
+# Unrelated numbers are left alone.
+unit_test_check_variable_equal(
+    [[z_vcpkg_execute_build_process_set_jobs(command found 2 tool --level 16 -j160)]]
+    command [[tool;--level;16;-j160]]
+)
+unit_test_check_variable_equal(
+    [[z_vcpkg_execute_build_process_set_jobs(command found 2 tool --level 16 -j160)]]
+    found OFF
+)
+
+# A remembered job count is doubled after every successful build until the limit is dropped.
+set(DOWNLOADS "${CURRENT_BUILDTREES_DIR}/unit-test-build-concurrency")
+set(concurrency_file "${DOWNLOADS}/tools/build-concurrency/${TARGET_TRIPLET}/${PORT}/unit-test-build.txt")
+file(REMOVE_RECURSE "${DOWNLOADS}")
+file(WRITE "${concurrency_file}" "4\n")
+unit_test_check_variable_equal(
+    [[vcpkg_execute_build_process(COMMAND "${CMAKE_COMMAND}" -E echo -j16 WORKING_DIRECTORY "${CURRENT_BUILDTREES_DIR}" LOGNAME unit-test-build)
+      file(READ "${concurrency_file}" jobs)]]
+    jobs "8\n"
+)
+unit_test_check_variable_equal(
+    [[vcpkg_execute_build_process(COMMAND "${CMAKE_COMMAND}" -E echo -j16 WORKING_DIRECTORY "${CURRENT_BUILDTREES_DIR}" LOGNAME unit-test-build)
+      set(remembered EXISTS)
+      if(NOT EXISTS "${concurrency_file}")
+          set(remembered REMOVED)
+      endif()]]
+    remembered REMOVED
+)
+unit_test_check_variable_equal(
+    [[file(READ "${CURRENT_BUILDTREES_DIR}/unit-test-build-out.log" output)]]
+    output "-j8\n"
+)
+file(REMOVE_RECURSE "${DOWNLOADS}")
+
+endblock()
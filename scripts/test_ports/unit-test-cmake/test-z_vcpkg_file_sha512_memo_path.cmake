@@ -0,0 +1,38 @@
+# z_vcpkg_file_sha512_memo_path(<out-var> <file>)
+
+block(SCOPE_FOR VARIABLES)
+
+set(DOWNLOADS "/vcpkg/downloads")
+unset(X_VCPKG_NO_SHA512_MEMO)
+
+unit_test_check_variable_not_equal(
+    [[z_vcpkg_file_sha512_memo_path(memo_path "/vcpkg/downloads/boost-1.85.tar.gz")]]
+    memo_path ""
+)
+unit_test_check_variable_equal(
+    [[z_vcpkg_file_sha512_memo_path(memo_path "/vcpkg/downloads/boost-1.85.tar.gz")
+      string(REGEX REPLACE "[0-9a-f]+\\.txt$" "" memo_path "${memo_path}")]]
+    memo_path [[/vcpkg/downloads/tools/sha512-memo/]]
+)
+
+# Only complete files in downloads/ are memoized.
+unit_test_check_variable_equal(
+    [[z_vcpkg_file_sha512_memo_path(memo_path "/vcpkg/ports/zlib/fix.patch")]]
+    memo_path ""
+)
+unit_test_check_variable_equal(
+    [[z_vcpkg_file_sha512_memo_path(memo_path "/vcpkg/downloads/temp/boost-1.85.tar.gz")]]
+    memo_path ""
+)
+unit_test_check_variable_equal(
+    [[z_vcpkg_file_sha512_memo_path(memo_path "/vcpkg/downloads/partial/boost-1.85.tar.gz-0123456789abcdef/0-99")]]
+    memo_path ""
+)
+
+set(X_VCPKG_NO_SHA512_MEMO ON)
+unit_test_check_variable_equal(
+    [[z_vcpkg_file_sha512_memo_path(memo_path "/vcpkg/downloads/boost-1.85.tar.gz")]]
+    memo_path ""
+)
+
+endblock()
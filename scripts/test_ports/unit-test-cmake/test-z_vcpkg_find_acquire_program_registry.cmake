@@ -0,0 +1,65 @@
+# z_vcpkg_find_acquire_program_registry_path(<out-var> <program> <key-data>)
+# z_vcpkg_find_acquire_program_registry_store(<entry> <value> <version>)
+# z_vcpkg_find_acquire_program_registry_lookup(<out-var> <entry> [OUT_VERSION <out-var>])
+
+block(SCOPE_FOR VARIABLES)
+
+set(DOWNLOADS "/vcpkg/downloads")
+unset(X_VCPKG_NO_TOOL_REGISTRY)
+
+unit_test_check_variable_equal(
+    [[z_vcpkg_find_acquire_program_registry_path(entry NINJA "1.10.2;;0123")
+      string(REGEX REPLACE "[0-9a-f]+\\.txt$" "" entry "${entry}")]]
+    entry [[/vcpkg/downloads/tools/tool-registry/NINJA-]]
+)
+# Each required version has its own entry.
+unit_test_check_variable_not_equal(
+    [[z_vcpkg_find_acquire_program_registry_path(entry MESON "1.3.2;EXACT_VERSION_MATCH;0123")
+      z_vcpkg_find_acquire_program_registry_path(other_entry MESON "1.4.0;EXACT_VERSION_MATCH;0123")]]
+    entry "${other_entry}"
+)
+
+set(X_VCPKG_NO_TOOL_REGISTRY ON)
+unit_test_check_variable_equal([[z_vcpkg_find_acquire_program_registry_path(entry NINJA "1.10.2;;0123")]] entry "")
+unset(X_VCPKG_NO_TOOL_REGISTRY)
+
+set(DOWNLOADS "${CURRENT_BUILDTREES_DIR}/unit-test-tool-registry")
+file(REMOVE_RECURSE "${DOWNLOADS}")
+set(python "${DOWNLOADS}/tools/python/python3")
+set(meson "${DOWNLOADS}/tools/meson/meson.py")
+file(WRITE "${python}" "python")
+file(WRITE "${meson}" "meson")
+z_vcpkg_find_acquire_program_registry_path(entry MESON "1.3.2;EXACT_VERSION_MATCH;0123")
+
+z_vcpkg_find_acquire_program_registry_store("${entry}" "${python};-I;${meson}" "")
+unit_test_check_variable_equal(
+    [[z_vcpkg_find_acquire_program_registry_lookup(value "${entry}")]]
+    value "${python};-I;${meson}"
+)
+
+# A changed tool invalidates the entry.
+file(WRITE "${meson}" "meson 1.4.0")
+unit_test_check_variable_equal([[z_vcpkg_find_acquire_program_registry_lookup(value "${entry}")]] value "")
+file(REMOVE "${meson}")
+unit_test_check_variable_equal([[z_vcpkg_find_acquire_program_registry_lookup(value "${entry}")]] value "")
+
+# Tools found via PATH are tied to the resolved tool and its version, not to PATH.
+z_vcpkg_find_acquire_program_registry_store("${entry}" "${python}" "Python 3.12.1")
+set(original_path "$ENV{PATH}")
+set(ENV{PATH} "${DOWNLOADS}/bin")
+unit_test_check_variable_equal(
+    [[z_vcpkg_find_acquire_program_registry_lookup(value "${entry}" OUT_VERSION version)]]
+    value "${python}"
+)
+unit_test_check_variable_equal(
+    [[z_vcpkg_find_acquire_program_registry_lookup(value "${entry}" OUT_VERSION version)]]
+    version "Python 3.12.1"
+)
+set(ENV{PATH} "${original_path}")
+# Another tool at the same path, e.g. after an upgrade, invalidates the entry.
+file(WRITE "${python}" "python 3.13")
+unit_test_check_variable_equal([[z_vcpkg_find_acquire_program_registry_lookup(value "${entry}")]] value "")
+
+file(REMOVE_RECURSE "${DOWNLOADS}")
+
+endblock()
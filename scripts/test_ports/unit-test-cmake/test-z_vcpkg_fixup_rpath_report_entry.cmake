@@ -0,0 +1,21 @@
+# z_vcpkg_fixup_rpath_report_entry(<out-var> <file> <action> [<key> <value>]...)
+
+block(SCOPE_FOR VARIABLES)
+
+unit_test_check_variable_equal(
+    [[z_vcpkg_fixup_rpath_report_entry(entry "lib/libz.so.1" "adjusted" old_rpath "/tmp/build" new_rpath "$ORIGIN")]]
+    entry [[{"file": "lib/libz.so.1", "action": "adjusted", "old_rpath": "/tmp/build", "new_rpath": "$ORIGIN"}]]
+)
+
+# Every string is escaped, including the file name and the action.
+set(file "tools/a \"quoted\" name\\with\tcontrol\rcharacters")
+unit_test_check_variable_equal(
+    [[z_vcpkg_fixup_rpath_report_entry(entry "${file}" "skipped \"x\"" reason "line 1\nline 2")
+      string(JSON parsed_file GET "${entry}" file)
+      string(JSON parsed_action GET "${entry}" action)
+      string(JSON parsed_reason GET "${entry}" reason)
+      set(parsed "${parsed_file}|${parsed_action}|${parsed_reason}")]]
+    parsed "${file}|skipped \"x\"|line 1\nline 2"
+)
+
+endblock()
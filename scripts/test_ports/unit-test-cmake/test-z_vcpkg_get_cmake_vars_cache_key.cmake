@@ -0,0 +1,32 @@
+# z_vcpkg_get_cmake_vars_cache_key(<out-var>)
+
+block(SCOPE_FOR VARIABLES)
+
+set(VCPKG_CHAINLOAD_TOOLCHAIN_FILE "${SCRIPTS}/toolchains/linux.cmake")
+set(VCPKG_CXX_FLAGS "")
+z_vcpkg_get_cmake_vars_cache_key(base_key)
+
+# The key is stable for unchanged inputs.
+unit_test_check_variable_equal([[z_vcpkg_get_cmake_vars_cache_key(key)]] key "${base_key}")
+
+# Flags forwarded to the configure change the key.
+unit_test_check_variable_not_equal([[
+    set(VCPKG_CXX_FLAGS "-O3")
+    z_vcpkg_get_cmake_vars_cache_key(key)
+]] key "${base_key}")
+
+# A different toolchain changes the key.
+unit_test_check_variable_not_equal([[
+    set(VCPKG_CHAINLOAD_TOOLCHAIN_FILE "${SCRIPTS}/toolchains/mingw.cmake")
+    z_vcpkg_get_cmake_vars_cache_key(key)
+]] key "${base_key}")
+
+# The environment observed by compiler detection changes the key.
+set(cc_backup "$ENV{CC}")
+unit_test_check_variable_not_equal([[
+    set(ENV{CC} "/opt/unit-test/bin/cc")
+    z_vcpkg_get_cmake_vars_cache_key(key)
+]] key "${base_key}")
+set(ENV{CC} "${cc_backup}")
+
+endblock()
@@ -0,0 +1,24 @@
+# z_vcpkg_get_elf_file_type(<out-var> <file>)
+
+block(SCOPE_FOR VARIABLES)
+
+set(text_file "${CURRENT_BUILDTREES_DIR}/elf-file-type.txt")
+file(WRITE "${text_file}" "This is not an ELF file.\n")
+unit_test_check_variable_equal([[z_vcpkg_get_elf_file_type(type "${text_file}")]] type "")
+
+set(short_file "${CURRENT_BUILDTREES_DIR}/elf-file-type-short.txt")
+string(ASCII 127 del)
+file(WRITE "${short_file}" "${del}ELF")
+unit_test_check_variable_equal([[z_vcpkg_get_elf_file_type(type "${short_file}")]] type "")
+
+if(VCPKG_HOST_IS_LINUX)
+    z_vcpkg_get_elf_file_type(type "${CMAKE_COMMAND}")
+    if(NOT type MATCHES "^(EXEC|DYN)$")
+        message(SEND_ERROR "z_vcpkg_get_elf_file_type(type \"${CMAKE_COMMAND}\") resulted in the wrong value for type;
+    expected: EXEC or DYN
+    actual  : \"${type}\"")
+        set_has_error()
+    endif()
+endif()
+
+endblock()
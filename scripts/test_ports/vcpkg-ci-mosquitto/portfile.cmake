@@ -0,0 +1,37 @@
+set(VCPKG_POLICY_EMPTY_PACKAGE enabled)
+set(VCPKG_BUILD_TYPE release)
+
+# The load test runs as part of the build unless cross-compiling.
+# MOSQUITTO_LOAD_TEST_CLIENTS (publisher/subscriber pairs), MOSQUITTO_LOAD_TEST_MESSAGES
+# (messages per publisher) and MOSQUITTO_LOAD_TEST_PORT can be set in the triplet file.
+set(clients 50)
+if(DEFINED MOSQUITTO_LOAD_TEST_CLIENTS)
+    set(clients "${MOSQUITTO_LOAD_TEST_CLIENTS}")
+endif()
+set(messages 2000)
+if(DEFINED MOSQUITTO_LOAD_TEST_MESSAGES)
+    set(messages "${MOSQUITTO_LOAD_TEST_MESSAGES}")
+endif()
+set(port 18830)
+if(DEFINED MOSQUITTO_LOAD_TEST_PORT)
+    set(port "${MOSQUITTO_LOAD_TEST_PORT}")
+endif()
+
+string(COMPARE EQUAL "${VCPKG_LIBRARY_LINKAGE}" "static" static_linkage)
+
+vcpkg_cmake_configure(
+    SOURCE_PATH "${CURRENT_PORT_DIR}/project"
+    OPTIONS
+        "-DMOSQUITTO_BROKER=${CURRENT_INSTALLED_DIR}/tools/mosquitto/mosquitto${VCPKG_TARGET_EXECUTABLE_SUFFIX}"
+        "-DMOSQUITTO_STATIC=${static_linkage}"
+        "-DLOAD_TEST_CLIENTS=${clients}"
+        "-DLOAD_TEST_MESSAGES=${messages}"
+        "-DLOAD_TEST_PORT=${port}"
+)
+vcpkg_cmake_build()
+
+set(results "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-rel/mosquitto-load-test.txt")
+if(EXISTS "${results}")
+    file(READ "${results}" results)
+    message(STATUS "mosquitto load test:\n${results}")
+endif()
@@ -0,0 +1,388 @@
+// Starts a local mosquitto broker and measures message throughput and latency with libmosquitto clients.
+// Every publisher sends its messages to its own topic, which exactly one subscriber subscribes to.
+// Usage: main <broker> <port> <clients> <messages per client> [<results file>]
+
+#include <mosquitto.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+extern char** environ;
+#endif
+
+namespace
+{
+    const int qos = 1;
+    const int payload_size = 64;
+    // Messages a publisher may have sent which the broker did not acknowledge yet
+    const int publish_window = 100;
+
+    std::int64_t now_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    class broker_process
+    {
+    public:
+        broker_process(const std::string& executable, const std::string& config)
+        {
+#ifdef _WIN32
+            std::string command_line = "\"" + executable + "\" -c \"" + config + "\"";
+            STARTUPINFOA startup_info = {};
+            startup_info.cb = sizeof(startup_info);
+            started = CreateProcessA(executable.c_str(), &command_line[0], nullptr, nullptr, FALSE, 0,
+                                     nullptr, nullptr, &startup_info, &process) != 0;
+            if (started)
+            {
+                CloseHandle(process.hThread);
+            }
+#else
+            std::vector<char*> argv = {const_cast<char*>(executable.c_str()), const_cast<char*>("-c"),
+                                       const_cast<char*>(config.c_str()), nullptr};
+            started = posix_spawn(&pid, executable.c_str(), nullptr, nullptr, argv.data(), environ) == 0;
+#endif
+        }
+
+        ~broker_process()
+        {
+            if (!started)
+            {
+                return;
+            }
+#ifdef _WIN32
+            if (!exited)
+            {
+                TerminateProcess(process.hProcess, 0);
+                WaitForSingleObject(process.hProcess, INFINITE);
+            }
+            CloseHandle(process.hProcess);
+#else
+            if (!exited)
+            {
+                kill(pid, SIGTERM);
+                waitpid(pid, nullptr, 0);
+            }
+#endif
+        }
+
+        broker_process(const broker_process&) = delete;
+        broker_process& operator=(const broker_process&) = delete;
+
+        // False once the broker exited, e.g. because another process listens on its port
+        bool running()
+        {
+            if (!started || exited)
+            {
+                return false;
+            }
+#ifdef _WIN32
+            DWORD exit_code = 0;
+            exited = !GetExitCodeProcess(process.hProcess, &exit_code) || exit_code != STILL_ACTIVE;
+#else
+            exited = waitpid(pid, nullptr, WNOHANG) != 0;
+#endif
+            return !exited;
+        }
+
+        bool started = false;
+
+    private:
+        bool exited = false;
+#ifdef _WIN32
+        PROCESS_INFORMATION process = {};
+#else
+        pid_t pid = 0;
+#endif
+    };
+
+    struct client
+    {
+        struct mosquitto* mosq = nullptr;
+        std::string topic;
+        std::atomic<int> subscribed{0};
+        std::atomic<int> acknowledged{0};
+        // Only written by the network thread of the client
+        std::vector<std::int64_t> latencies;
+
+        ~client() { stop(); }
+
+        void stop()
+        {
+            if (mosq)
+            {
+                mosquitto_disconnect(mosq);
+                mosquitto_loop_stop(mosq, false);
+                mosquitto_destroy(mosq);
+                mosq = nullptr;
+            }
+        }
+    };
+
+    std::atomic<long long> received{0};
+    std::atomic<std::int64_t> last_received_ns{0};
+
+    void on_subscribe(struct mosquitto*, void* obj, int, int, const int*)
+    {
+        static_cast<client*>(obj)->subscribed = 1;
+    }
+
+    void on_publish(struct mosquitto*, void* obj, int)
+    {
+        ++static_cast<client*>(obj)->acknowledged;
+    }
+
+    void on_message(struct mosquitto*, void* obj, const struct mosquitto_message* message)
+    {
+        const std::int64_t now = now_ns();
+        if (message->payloadlen >= static_cast<int>(sizeof(std::int64_t)))
+        {
+            std::int64_t sent;
+            std::memcpy(&sent, message->payload, sizeof(sent));
+            static_cast<client*>(obj)->latencies.push_back(now - sent);
+        }
+        last_received_ns = now;
+        ++received;
+    }
+
+    bool connect(client& c, const std::string& id, int port)
+    {
+        c.mosq = mosquitto_new(id.c_str(), true, &c);
+        if (!c.mosq)
+        {
+            std::cerr << "mosquitto_new failed\n";
+            return false;
+        }
+        mosquitto_subscribe_callback_set(c.mosq, on_subscribe);
+        mosquitto_publish_callback_set(c.mosq, on_publish);
+        mosquitto_message_callback_set(c.mosq, on_message);
+        int rc = mosquitto_connect(c.mosq, "127.0.0.1", port, 60);
+        if (rc == MOSQ_ERR_SUCCESS)
+        {
+            rc = mosquitto_loop_start(c.mosq);
+        }
+        if (rc != MOSQ_ERR_SUCCESS)
+        {
+            std::cerr << id << ": " << mosquitto_strerror(rc) << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    bool wait_for_broker(broker_process& process, int port)
+    {
+        for (int attempt = 0; attempt < 100; ++attempt)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            if (!process.running())
+            {
+                std::cerr << "the broker exited, is port " << port << " in use?\n";
+                return false;
+            }
+            struct mosquitto* probe = mosquitto_new(nullptr, true, nullptr);
+            const bool connected = probe && mosquitto_connect(probe, "127.0.0.1", port, 60) == MOSQ_ERR_SUCCESS;
+            if (connected)
+            {
+                mosquitto_disconnect(probe);
+            }
+            mosquitto_destroy(probe);
+            // Another process listening on the port may have accepted the probe if the broker failed to bind it
+            if (connected && process.running())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    double percentile_ms(const std::vector<std::int64_t>& sorted, double p)
+    {
+        if (sorted.empty())
+        {
+            return 0.0;
+        }
+        const size_t index = std::min(sorted.size() - 1, static_cast<size_t>(p * static_cast<double>(sorted.size())));
+        return static_cast<double>(sorted[index]) / 1e6;
+    }
+
+    int run(const std::string& broker, int port, int clients, int messages, std::string& results)
+    {
+        const std::string config = "mosquitto-load-test.conf";
+        std::ofstream(config) << "listener " << port << " 127.0.0.1\n"
+                              << "allow_anonymous true\n"
+                              << "max_connections -1\n"
+                              << "persistence false\n"
+                              << "set_tcp_nodelay true\n"
+                              << "log_dest stderr\n"
+                              << "log_type error\n"
+                              << "log_type warning\n";
+        broker_process process(broker, config);
+        if (!process.started)
+        {
+            std::cerr << "failed to start " << broker << "\n";
+            return 1;
+        }
+        if (!wait_for_broker(process, port))
+        {
+            std::cerr << "the broker does not accept connections on port " << port << "\n";
+            return 1;
+        }
+
+        std::vector<std::unique_ptr<client>> subscribers;
+        std::vector<std::unique_ptr<client>> publishers;
+        for (int i = 0; i < clients; ++i)
+        {
+            subscribers.emplace_back(new client);
+            publishers.emplace_back(new client);
+            subscribers.back()->topic = publishers.back()->topic = "load-test/" + std::to_string(i);
+            if (!connect(*subscribers.back(), "sub-" + std::to_string(i), port) ||
+                !connect(*publishers.back(), "pub-" + std::to_string(i), port))
+            {
+                return 1;
+            }
+            const int rc = mosquitto_subscribe(subscribers.back()->mosq, nullptr, subscribers.back()->topic.c_str(), qos);
+            if (rc != MOSQ_ERR_SUCCESS)
+            {
+                std::cerr << "subscribe: " << mosquitto_strerror(rc) << "\n";
+                return 1;
+            }
+        }
+        for (const auto& subscriber : subscribers)
+        {
+            const std::int64_t deadline = now_ns() + 30000000000LL;
+            while (!subscriber->subscribed && now_ns() < deadline)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            if (!subscriber->subscribed)
+            {
+                std::cerr << subscriber->topic << ": subscription was not acknowledged\n";
+                return 1;
+            }
+        }
+
+        const long long expected = static_cast<long long>(clients) * messages;
+        std::atomic<bool> publish_failed{false};
+        const std::int64_t start = now_ns();
+        std::vector<std::thread> threads;
+        for (const auto& publisher : publishers)
+        {
+            client* c = publisher.get();
+            threads.emplace_back([c, messages, &publish_failed] {
+                char payload[payload_size] = {};
+                for (int sent = 0; sent < messages && !publish_failed; ++sent)
+                {
+                    while (sent - c->acknowledged >= publish_window && !publish_failed)
+                    {
+                        std::this_thread::yield();
+                    }
+                    const std::int64_t timestamp = now_ns();
+                    std::memcpy(payload, &timestamp, sizeof(timestamp));
+                    const int rc = mosquitto_publish(c->mosq, nullptr, c->topic.c_str(), payload_size, payload, qos, false);
+                    if (rc != MOSQ_ERR_SUCCESS)
+                    {
+                        std::cerr << c->topic << ": " << mosquitto_strerror(rc) << "\n";
+                        publish_failed = true;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        const std::int64_t deadline = now_ns() + 60000000000LL;
+        while (received < expected && !publish_failed && now_ns() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        const double seconds = static_cast<double>(last_received_ns - start) / 1e9;
+        const long long delivered = received;
+        // Stop the network threads before reading the latencies
+        for (const auto& publisher : publishers)
+        {
+            publisher->stop();
+        }
+        for (const auto& subscriber : subscribers)
+        {
+            subscriber->stop();
+        }
+
+        std::vector<std::int64_t> latencies;
+        latencies.reserve(static_cast<size_t>(delivered));
+        for (const auto& subscriber : subscribers)
+        {
+            latencies.insert(latencies.end(), subscriber->latencies.begin(), subscriber->latencies.end());
+        }
+        std::sort(latencies.begin(), latencies.end());
+
+        char line[200];
+        std::snprintf(line, sizeof(line), "clients    %8d publishers, %d subscribers, QoS %d, %d byte payloads\n",
+                      clients, clients, qos, payload_size);
+        results += line;
+        std::snprintf(line, sizeof(line), "messages   %8lld sent, %lld received in %8.3f s, %12.0f msg/s\n",
+                      expected, delivered, seconds, seconds > 0 ? delivered / seconds : 0.0);
+        results += line;
+        std::snprintf(line, sizeof(line), "latency    p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms\n",
+                      percentile_ms(latencies, 0.50), percentile_ms(latencies, 0.90),
+                      percentile_ms(latencies, 0.99), percentile_ms(latencies, 1.0));
+        results += line;
+
+        if (publish_failed || delivered != expected)
+        {
+            std::cerr << "expected " << expected << " messages, received " << delivered << "\n";
+            return 1;
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 5)
+    {
+        std::cerr << "Usage: " << argv[0] << " <broker> <port> <clients> <messages per client> [<results file>]\n";
+        return 2;
+    }
+    const std::string broker = argv[1];
+    const int port = std::atoi(argv[2]);
+    const int clients = std::atoi(argv[3]);
+    const int messages = std::atoi(argv[4]);
+    if (port <= 0 || clients <= 0 || messages <= 0)
+    {
+        std::cerr << "port, clients and messages must be positive\n";
+        return 2;
+    }
+
+    mosquitto_lib_init();
+    std::string results;
+    const int rc = run(broker, port, clients, messages, results);
+    mosquitto_lib_cleanup();
+
+    std::cout << results;
+    if (argc > 5)
+    {
+        std::ofstream(argv[5]) << results;
+    }
+    return rc;
+}
@@ -0,0 +1,23 @@
+set(VCPKG_POLICY_EMPTY_PACKAGE enabled)
+set(VCPKG_BUILD_TYPE release)
+
+# The perf tests run as part of the build unless cross-compiling.
+# OPENCV_PERF_ITERATIONS can be set in the triplet file, next to
+# VCPKG_OPENCV_CPU_BASELINE and VCPKG_OPENCV_CPU_DISPATCH.
+set(iterations 50)
+if(DEFINED OPENCV_PERF_ITERATIONS)
+    set(iterations "${OPENCV_PERF_ITERATIONS}")
+endif()
+
+vcpkg_cmake_configure(
+    SOURCE_PATH "${CURRENT_PORT_DIR}/project"
+    OPTIONS
+        "-DPERF_ITERATIONS=${iterations}"
+)
+vcpkg_cmake_build()
+
+set(results "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-rel/opencv4-perf.txt")
+if(EXISTS "${results}")
+    file(READ "${results}" results)
+    message(STATUS "opencv4 perf tests:\n${results}")
+endif()
@@ -0,0 +1,120 @@
+// Measures the imgproc and dnn paths which depend most on the CPU optimizations OpenCV was built with.
+// The cases follow OpenCV's perf tests for resize, cvtColor and blobFromImage.
+// Usage: main <iterations> [<results file>]
+
+#include <opencv2/core.hpp>
+#include <opencv2/core/utility.hpp>
+#include <opencv2/dnn.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const int warmup_iterations = 3;
+
+    cv::Mat random_image(cv::Size size, int type)
+    {
+        cv::Mat image(size, type);
+        cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+        return image;
+    }
+
+    // Runs `body` and returns a line with the median and minimum time of one iteration
+    std::string measure(const std::string& name, int iterations, const std::function<void()>& body)
+    {
+        for (int i = 0; i < warmup_iterations; ++i)
+        {
+            body();
+        }
+        std::vector<double> times;
+        times.reserve(static_cast<size_t>(iterations));
+        for (int i = 0; i < iterations; ++i)
+        {
+            const int64 start = cv::getTickCount();
+            body();
+            times.push_back(static_cast<double>(cv::getTickCount() - start) * 1000.0 / cv::getTickFrequency());
+        }
+        std::sort(times.begin(), times.end());
+        char line[200];
+        std::snprintf(line, sizeof(line), "%-48s median %9.3f ms, min %9.3f ms\n",
+                      name.c_str(), times[times.size() / 2], times.front());
+        return line;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <iterations> [<results file>]\n";
+        return 2;
+    }
+    const int iterations = std::atoi(argv[1]);
+    if (iterations <= 0)
+    {
+        std::cerr << "iterations must be positive\n";
+        return 2;
+    }
+
+    std::string results = "OpenCV " CV_VERSION ", CPU features: " + cv::getCPUFeaturesLine() +
+                          ", threads: " + std::to_string(cv::getNumThreads()) + "\n";
+    try
+    {
+        const cv::Size full_hd(1920, 1080);
+        const cv::Size vga(640, 480);
+        const cv::Mat bgr = random_image(full_hd, CV_8UC3);
+        const cv::Mat gray = random_image(full_hd, CV_8UC1);
+        const cv::Mat nv12 = random_image(cv::Size(full_hd.width, full_hd.height * 3 / 2), CV_8UC1);
+        const cv::Mat bgr_vga = random_image(vga, CV_8UC3);
+        cv::Mat dst;
+
+        results += measure("resize 8UC3 1920x1080->960x540 LINEAR", iterations,
+                           [&] { cv::resize(bgr, dst, cv::Size(960, 540), 0, 0, cv::INTER_LINEAR); });
+        results += measure("resize 8UC3 1920x1080->960x540 AREA", iterations,
+                           [&] { cv::resize(bgr, dst, cv::Size(960, 540), 0, 0, cv::INTER_AREA); });
+        results += measure("resize 8UC1 1920x1080->640x480 LINEAR", iterations,
+                           [&] { cv::resize(gray, dst, vga, 0, 0, cv::INTER_LINEAR); });
+        results += measure("resize 8UC3 640x480->1920x1080 CUBIC", iterations,
+                           [&] { cv::resize(bgr_vga, dst, full_hd, 0, 0, cv::INTER_CUBIC); });
+
+        results += measure("cvtColor 1920x1080 BGR2GRAY", iterations,
+                           [&] { cv::cvtColor(bgr, dst, cv::COLOR_BGR2GRAY); });
+        results += measure("cvtColor 1920x1080 BGR2HSV", iterations,
+                           [&] { cv::cvtColor(bgr, dst, cv::COLOR_BGR2HSV); });
+        results += measure("cvtColor 1920x1080 BGR2YUV", iterations,
+                           [&] { cv::cvtColor(bgr, dst, cv::COLOR_BGR2YUV); });
+        results += measure("cvtColor 1920x1080 YUV2BGR_NV12", iterations,
+                           [&] { cv::cvtColor(nv12, dst, cv::COLOR_YUV2BGR_NV12); });
+
+        results += measure("blobFromImage 1920x1080->640x640 swapRB", iterations, [&] {
+            dst = cv::dnn::blobFromImage(bgr, 1.0 / 255, cv::Size(640, 640), cv::Scalar(), true, false);
+        });
+        results += measure("blobFromImage 1920x1080->224x224 mean crop", iterations, [&] {
+            dst = cv::dnn::blobFromImage(bgr, 1.0, cv::Size(224, 224), cv::Scalar(104, 117, 123), false, true);
+        });
+        const std::vector<cv::Mat> batch(8, bgr_vga);
+        results += measure("blobFromImages 8x640x480->416x416", iterations, [&] {
+            dst = cv::dnn::blobFromImages(batch, 1.0 / 255, cv::Size(416, 416), cv::Scalar(), true, false);
+        });
+    }
+    catch (const cv::Exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << results;
+    if (argc > 2)
+    {
+        std::ofstream(argv[2]) << results;
+    }
+    return 0;
+}
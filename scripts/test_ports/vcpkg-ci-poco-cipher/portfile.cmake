@@ -0,0 +1,51 @@
+set(VCPKG_POLICY_EMPTY_PACKAGE enabled)
+set(VCPKG_BUILD_TYPE release)
+
+# The benchmark runs as part of the build unless cross-compiling.
+# POCO_CIPHER_BENCHMARK_ROWS and POCO_CIPHER_BENCHMARK_OPENS can be set in the triplet file.
+set(rows 20000)
+if(DEFINED POCO_CIPHER_BENCHMARK_ROWS)
+    set(rows "${POCO_CIPHER_BENCHMARK_ROWS}")
+endif()
+set(opens 20)
+if(DEFINED POCO_CIPHER_BENCHMARK_OPENS)
+    set(opens "${POCO_CIPHER_BENCHMARK_OPENS}")
+endif()
+
+# The SQLite settings of poco-cipher in this triplet, which the benchmark finds in PRAGMA compile_options
+set(compile_options "")
+if(DEFINED POCO_CIPHER_SQLITE_PAGE_SIZE)
+    list(APPEND compile_options "DEFAULT_PAGE_SIZE=${POCO_CIPHER_SQLITE_PAGE_SIZE}")
+endif()
+if(DEFINED POCO_CIPHER_SQLITE_WAL_SYNCHRONOUS)
+    set(synchronous_modes OFF NORMAL FULL EXTRA)
+    string(TOUPPER "${POCO_CIPHER_SQLITE_WAL_SYNCHRONOUS}" synchronous_mode)
+    list(FIND synchronous_modes "${synchronous_mode}" synchronous_value)
+    list(APPEND compile_options "DEFAULT_WAL_SYNCHRONOUS=${synchronous_value}")
+endif()
+if(DEFINED POCO_CIPHER_SQLITE_MEMSTATUS)
+    if(POCO_CIPHER_SQLITE_MEMSTATUS)
+        list(APPEND compile_options "DEFAULT_MEMSTATUS=1")
+    else()
+        list(APPEND compile_options "DEFAULT_MEMSTATUS=0")
+    endif()
+endif()
+if(DEFINED POCO_CIPHER_SQLITE_THREADSAFE)
+    list(APPEND compile_options "THREADSAFE=${POCO_CIPHER_SQLITE_THREADSAFE}")
+endif()
+list(JOIN compile_options "," compile_options)
+
+vcpkg_cmake_configure(
+    SOURCE_PATH "${CURRENT_PORT_DIR}/project"
+    OPTIONS
+        "-DBENCHMARK_ROWS=${rows}"
+        "-DBENCHMARK_OPENS=${opens}"
+        "-DBENCHMARK_COMPILE_OPTIONS=${compile_options}"
+)
+vcpkg_cmake_build()
+
+set(results "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-rel/poco-cipher-benchmark.txt")
+if(EXISTS "${results}")
+    file(READ "${results}" results)
+    message(STATUS "poco-cipher benchmark:\n${results}")
+endif()
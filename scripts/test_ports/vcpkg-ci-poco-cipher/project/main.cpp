@@ -0,0 +1,203 @@
+// Measures insert, select and open throughput of a SQLite database through Poco::Data::SQLite, encrypted if the
+// SQLite of poco-cipher is SQLCipher. Fails unless the SQLite settings of the triplet are in effect.
+// Usage: main <database> <rows> <opens> [<results file>]
+
+#include <Poco/Data/SQLite/Connector.h>
+#include <Poco/Data/Session.h>
+#include <Poco/Data/Statement.h>
+#include <Poco/Exception.h>
+#include <Poco/File.h>
+#include <Poco/Types.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Poco::Data::Keywords;
+using Poco::Data::Session;
+using Poco::Data::Statement;
+
+namespace
+{
+    const std::string database_key = "vcpkg-ci-poco-cipher";
+
+    double seconds_since(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // The SQLCipher version, or "" for a plain SQLite, which ignores PRAGMA key
+    std::string cipher_version(Session& session)
+    {
+        std::vector<std::string> version;
+        session << "PRAGMA cipher_version", into(version), now;
+        return version.empty() ? std::string() : version.front();
+    }
+
+    Session open_database(const std::string& path, bool keyed)
+    {
+        Session session("SQLite", path);
+        if (keyed)
+        {
+            session << "PRAGMA key = '" + database_key + "'", now;
+        }
+        return session;
+    }
+
+    // Fails unless every option of EXPECTED_COMPILE_OPTIONS, e.g. "DEFAULT_PAGE_SIZE=8192", is in effect
+    void check_compile_options(Session& session)
+    {
+        std::vector<std::string> options;
+        session << "PRAGMA compile_options", into(options), now;
+        std::string expected = EXPECTED_COMPILE_OPTIONS;
+        std::string::size_type start = 0;
+        while (start < expected.size())
+        {
+            std::string::size_type end = expected.find(',', start);
+            if (end == std::string::npos)
+            {
+                end = expected.size();
+            }
+            const std::string option = expected.substr(start, end - start);
+            if (std::find(options.begin(), options.end(), option) == options.end())
+            {
+                throw Poco::Exception("SQLite was not compiled with " + option);
+            }
+            start = end + 1;
+        }
+    }
+
+    void remove_database(const std::string& path)
+    {
+        for (const char* suffix : {"", "-wal", "-shm", "-journal"})
+        {
+            Poco::File file(path + suffix);
+            if (file.exists())
+            {
+                file.remove();
+            }
+        }
+    }
+
+    std::string format_result(const char* name, int count, const char* unit, double seconds)
+    {
+        char line[160];
+        std::snprintf(line, sizeof(line), "%-12s %8d %s in %8.3f s, %12.0f %s/s\n",
+                      name, count, unit, seconds, seconds > 0 ? count / seconds : 0.0, unit);
+        return line;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        std::cerr << "Usage: " << argv[0] << " <database> <rows> <opens> [<results file>]\n";
+        return 2;
+    }
+    const std::string path = argv[1];
+    const int rows = std::atoi(argv[2]);
+    const int opens = std::atoi(argv[3]);
+    if (rows <= 0 || opens <= 0)
+    {
+        std::cerr << "rows and opens must be positive\n";
+        return 2;
+    }
+
+    std::string results;
+    try
+    {
+        Poco::Data::SQLite::Connector::registerConnector();
+        remove_database(path);
+
+        bool keyed = false;
+        {
+            Session session("SQLite", path);
+            check_compile_options(session);
+            const std::string version = cipher_version(session);
+            keyed = !version.empty();
+            results += "cipher       " + (keyed ? "SQLCipher " + version : std::string("none, PRAGMA key has no effect")) + "\n";
+            session.close();
+        }
+
+        {
+            Session session = open_database(path, keyed);
+            session << "PRAGMA journal_mode = WAL", now;
+            session << "CREATE TABLE events (id INTEGER PRIMARY KEY, ts INTEGER NOT NULL, payload TEXT NOT NULL)", now;
+
+            int id = 0;
+            Poco::Int64 ts = 0;
+            std::string payload(200, 'x');
+            auto start = std::chrono::steady_clock::now();
+            session.begin();
+            Statement insert(session);
+            insert << "INSERT INTO events VALUES (?, ?, ?)", use(id), use(ts), use(payload);
+            for (id = 0; id < rows; ++id)
+            {
+                ts = 1700000000000 + id;
+                insert.execute();
+            }
+            session.commit();
+            results += format_result("insert", rows, "rows", seconds_since(start));
+
+            std::vector<int> ids;
+            std::vector<Poco::Int64> timestamps;
+            std::vector<std::string> payloads;
+            start = std::chrono::steady_clock::now();
+            session << "SELECT id, ts, payload FROM events", into(ids), into(timestamps), into(payloads), now;
+            if (ids.size() != static_cast<size_t>(rows))
+            {
+                std::cerr << "expected " << rows << " rows, selected " << ids.size() << "\n";
+                return 1;
+            }
+            results += format_result("select-scan", rows, "rows", seconds_since(start));
+
+            int lookup = 0;
+            std::string found;
+            start = std::chrono::steady_clock::now();
+            Statement select(session);
+            select << "SELECT payload FROM events WHERE id = ?", use(lookup), into(found);
+            for (int i = 0; i < rows; ++i)
+            {
+                lookup = static_cast<int>((static_cast<long long>(i) * 7919) % rows);
+                select.execute();
+            }
+            results += format_result("select-point", rows, "rows", seconds_since(start));
+            session.close();
+        }
+
+        // Every open derives the key again, if any, and reads the schema
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < opens; ++i)
+        {
+            Session session = open_database(path, keyed);
+            int tables = 0;
+            session << "SELECT count(*) FROM sqlite_master", into(tables), now;
+            if (tables != 1)
+            {
+                std::cerr << "expected 1 table, found " << tables << "\n";
+                return 1;
+            }
+            session.close();
+        }
+        results += format_result(keyed ? "open-keyed" : "open", opens, "opens", seconds_since(start));
+        remove_database(path);
+    }
+    catch (const Poco::Exception& e)
+    {
+        std::cerr << e.displayText() << "\n";
+        return 1;
+    }
+
+    std::cout << results;
+    if (argc > 4)
+    {
+        std::ofstream(argv[4]) << results;
+    }
+    return 0;
+}
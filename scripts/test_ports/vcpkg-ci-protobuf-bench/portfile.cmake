@@ -0,0 +1,23 @@
+set(VCPKG_POLICY_EMPTY_PACKAGE enabled)
+set(VCPKG_BUILD_TYPE release)
+
+# The benchmark runs as part of the build unless cross-compiling.
+# PROTOBUF_BENCHMARK_ITERATIONS (iterations of the batch message cases; the small message
+# cases run 100 times as many) can be set in the triplet file.
+set(iterations 2000)
+if(DEFINED PROTOBUF_BENCHMARK_ITERATIONS)
+    set(iterations "${PROTOBUF_BENCHMARK_ITERATIONS}")
+endif()
+
+vcpkg_cmake_configure(
+    SOURCE_PATH "${CURRENT_PORT_DIR}/project"
+    OPTIONS
+        "-DBENCHMARK_ITERATIONS=${iterations}"
+)
+vcpkg_cmake_build()
+
+set(results "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-rel/protobuf-benchmark.txt")
+if(EXISTS "${results}")
+    file(READ "${results}" results)
+    message(STATUS "protobuf benchmark:\n${results}")
+endif()
@@ -0,0 +1,190 @@
+// Measures encode/decode throughput and heap allocations of protobuf messages, with and without arenas.
+// Allocations are counted by replacing the global operator new; on Windows this only sees the
+// allocations of protobuf if it is linked statically.
+// Usage: main <iterations> [<results file>]
+
+#include "bench.pb.h"
+
+#include <google/protobuf/arena.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::atomic<long long> allocations{0};
+}
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace
+{
+    const int records_per_batch = 100;
+    const std::size_t initial_block_size = 1 << 20;
+
+    void fill_small(bench::Small* small, int i)
+    {
+        small->set_id(i);
+        small->set_timestamp(1700000000000 + i);
+        small->set_name("sensor-" + std::to_string(i % 100));
+        small->set_active(i % 2 == 0);
+        small->set_value(i * 0.5);
+    }
+
+    void fill_batch(bench::Batch* batch)
+    {
+        batch->set_source("vcpkg-ci-protobuf-bench");
+        for (int i = 0; i < records_per_batch; ++i)
+        {
+            bench::Record* record = batch->add_records();
+            record->set_id(i);
+            record->set_key("record/" + std::to_string(i));
+            record->set_payload(std::string(64 + i % 64, static_cast<char>('a' + i % 26)));
+            for (int tag = 0; tag < 8; ++tag)
+            {
+                record->add_tags(i * 8 + tag);
+            }
+            bench::Point* position = record->mutable_position();
+            position->set_x(i);
+            position->set_y(i * 2.0);
+            position->set_z(i * 3.0);
+            (*record->mutable_labels())["zone"] = "zone-" + std::to_string(i % 4);
+            (*record->mutable_labels())["kind"] = "measurement";
+        }
+    }
+
+    // Runs `body` `iterations` times and returns a line with its rate, throughput and allocations.
+    // `bytes` is the size of the encoded message processed by one iteration, or 0.
+    std::string measure(const char* name, int iterations, std::size_t bytes, const std::function<void()>& body)
+    {
+        body();
+        const long long allocations_before = allocations;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            body();
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const double allocations_per_op = static_cast<double>(allocations - allocations_before) / iterations;
+        char line[200];
+        std::snprintf(line, sizeof(line), "%-30s %12.0f ops/s %10.1f MB/s %10.2f allocs/op\n", name,
+                      seconds > 0 ? iterations / seconds : 0.0,
+                      seconds > 0 ? static_cast<double>(bytes) * iterations / seconds / 1e6 : 0.0,
+                      allocations_per_op);
+        return line;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <iterations> [<results file>]\n";
+        return 2;
+    }
+    const int iterations = std::atoi(argv[1]);
+    if (iterations <= 0)
+    {
+        std::cerr << "iterations must be positive\n";
+        return 2;
+    }
+    const int small_iterations = iterations * 100;
+
+    std::string results = "GOOGLE_PROTOBUF_VERSION " + std::to_string(GOOGLE_PROTOBUF_VERSION) + "\n";
+    long long checksum = 0;
+    std::vector<char> initial_block(initial_block_size);
+    google::protobuf::ArenaOptions reused_block;
+    reused_block.initial_block = initial_block.data();
+    reused_block.initial_block_size = initial_block.size();
+
+    bench::Small small;
+    fill_small(&small, 42);
+    const std::string small_data = small.SerializeAsString();
+    std::string buffer;
+
+    results += measure("small encode", small_iterations, small_data.size(), [&] {
+        small.SerializeToString(&buffer);
+        checksum += static_cast<long long>(buffer.size());
+    });
+    results += measure("small decode heap", small_iterations, small_data.size(), [&] {
+        bench::Small message;
+        message.ParseFromString(small_data);
+        checksum += message.id();
+    });
+    results += measure("small decode arena", small_iterations, small_data.size(), [&] {
+        google::protobuf::Arena arena(reused_block);
+        auto* message = google::protobuf::Arena::CreateMessage<bench::Small>(&arena);
+        message->ParseFromString(small_data);
+        checksum += message->id();
+    });
+
+    bench::Batch batch;
+    fill_batch(&batch);
+    const std::string batch_data = batch.SerializeAsString();
+
+    results += measure("batch build heap", iterations, 0, [&] {
+        bench::Batch message;
+        fill_batch(&message);
+        checksum += message.records_size();
+    });
+    results += measure("batch build arena", iterations, 0, [&] {
+        google::protobuf::Arena arena(reused_block);
+        auto* message = google::protobuf::Arena::CreateMessage<bench::Batch>(&arena);
+        fill_batch(message);
+        checksum += message->records_size();
+    });
+    results += measure("batch encode", iterations, batch_data.size(), [&] {
+        batch.SerializeToString(&buffer);
+        checksum += static_cast<long long>(buffer.size());
+    });
+    results += measure("batch decode heap", iterations, batch_data.size(), [&] {
+        bench::Batch message;
+        message.ParseFromString(batch_data);
+        checksum += message.records_size();
+    });
+    bench::Batch reused;
+    results += measure("batch decode heap reused", iterations, batch_data.size(), [&] {
+        reused.ParseFromString(batch_data);
+        checksum += reused.records_size();
+    });
+    results += measure("batch decode arena", iterations, batch_data.size(), [&] {
+        google::protobuf::Arena arena;
+        auto* message = google::protobuf::Arena::CreateMessage<bench::Batch>(&arena);
+        message->ParseFromString(batch_data);
+        checksum += message->records_size();
+    });
+    results += measure("batch decode arena reused", iterations, batch_data.size(), [&] {
+        google::protobuf::Arena arena(reused_block);
+        auto* message = google::protobuf::Arena::CreateMessage<bench::Batch>(&arena);
+        message->ParseFromString(batch_data);
+        checksum += message->records_size();
+    });
+
+    std::cout << results;
+    if (argc > 2)
+    {
+        std::ofstream(argv[2]) << results;
+    }
+    google::protobuf::ShutdownProtobufLibrary();
+    return checksum > 0 ? 0 : 1;
+}
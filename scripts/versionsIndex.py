@@ -0,0 +1,235 @@
+import os
+import sys
+import json
+import mmap
+import time
+import struct
+import argparse
+
+
+SCRIPT_DIRECTORY = os.path.dirname(os.path.abspath(__file__))
+VERSIONS_DB_DIRECTORY = os.path.join(SCRIPT_DIRECTORY, '../versions')
+INDEX_PATH = os.path.join(VERSIONS_DB_DIRECTORY, 'versions.idx')
+
+# Layout, all integers little endian:
+#   header: magic, format, port count, entry count, offsets of the port table, entry table and string pool
+#   port:   name offset, name length, first entry, entry count, mtime_ns and size of the versions file
+#   entry:  git-tree (20 bytes), version offset, version length, version scheme, port-version
+# Ports are sorted by name, the entries of a port keep the order of its versions file (newest first).
+MAGIC = b'VCPKGVIX'
+FORMAT = 1
+HEADER = struct.Struct('<8sIIIIII')
+PORT = struct.Struct('<IIIIQQ')
+ENTRY = struct.Struct('<20sIHBxI')
+VERSION_SCHEMES = ['version', 'version-semver', 'version-date', 'version-string']
+
+
+def get_versions_file_path(port_name):
+    return os.path.join(VERSIONS_DB_DIRECTORY, f'{port_name[0]}-', f'{port_name}.json')
+
+
+def get_fingerprint(path):
+    stat = os.stat(path)
+    return (stat.st_mtime_ns, stat.st_size)
+
+
+def get_version_scheme(version):
+    for scheme, key in enumerate(VERSION_SCHEMES):
+        if key in version:
+            return scheme, version[key]
+    raise ValueError(f'No version in {version}')
+
+
+class VersionsIndex:
+    """Read-only view of versions.idx, looked up without parsing the versions files."""
+
+    def __init__(self, path=INDEX_PATH):
+        with open(path, 'rb') as index_file:
+            self.data = mmap.mmap(index_file.fileno(), 0, access=mmap.ACCESS_READ)
+        (magic, index_format, self.port_count, self.entry_count,
+         self.ports_offset, self.entries_offset, self.strings_offset) = HEADER.unpack_from(self.data, 0)
+        if magic != MAGIC or index_format != FORMAT:
+            self.data.close()
+            raise ValueError(f'{path} is not a versions index of format {FORMAT}')
+
+    def close(self):
+        self.data.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def _string(self, offset, length):
+        start = self.strings_offset + offset
+        return self.data[start:start + length].decode('utf-8')
+
+    def _port(self, i):
+        return PORT.unpack_from(self.data, self.ports_offset + i * PORT.size)
+
+    def port_name(self, i):
+        name_offset, name_length, _, _, _, _ = self._port(i)
+        return self._string(name_offset, name_length)
+
+    def ports(self):
+        return [self.port_name(i) for i in range(self.port_count)]
+
+    def find_port(self, port_name):
+        """The position of `port_name` in the port table, or None."""
+        key = port_name.encode('utf-8')
+        low, high = 0, self.port_count
+        while low < high:
+            middle = (low + high) // 2
+            name_offset, name_length, _, _, _, _ = self._port(middle)
+            start = self.strings_offset + name_offset
+            name = self.data[start:start + name_length]
+            if name < key:
+                low = middle + 1
+            elif name > key:
+                high = middle
+            else:
+                return middle
+        return None
+
+    def fingerprint(self, i):
+        _, _, _, _, mtime_ns, size = self._port(i)
+        return (mtime_ns, size)
+
+    def versions(self, port_name):
+        """The versions of a port as in its versions file, or None for unknown ports."""
+        i = self.find_port(port_name)
+        if i is None:
+            return None
+        return self.versions_at(i)
+
+    def versions_at(self, i):
+        _, _, first_entry, entry_count, _, _ = self._port(i)
+        versions = []
+        for entry in range(first_entry, first_entry + entry_count):
+            git_tree, version_offset, version_length, scheme, port_version = ENTRY.unpack_from(
+                self.data, self.entries_offset + entry * ENTRY.size)
+            versions.append({
+                'git-tree': git_tree.hex(),
+                VERSION_SCHEMES[scheme]: self._string(version_offset, version_length),
+                'port-version': port_version
+            })
+        return versions
+
+    def find_git_tree(self, port_name, version, port_version=None):
+        """The git-tree of `version` of a port; the highest port-version unless one is given."""
+        i = self.find_port(port_name)
+        if i is None:
+            return None
+        _, _, first_entry, entry_count, _, _ = self._port(i)
+        key = version.encode('utf-8')
+        for entry in range(first_entry, first_entry + entry_count):
+            git_tree, version_offset, version_length, _, entry_port_version = ENTRY.unpack_from(
+                self.data, self.entries_offset + entry * ENTRY.size)
+            start = self.strings_offset + version_offset
+            if self.data[start:start + version_length] == key and (
+                    port_version is None or entry_port_version == port_version):
+                return git_tree.hex()
+        return None
+
+
+def write_index(ports, path=INDEX_PATH):
+    """Writes an index of `ports`: {port: (fingerprint, versions)}."""
+    strings = bytearray()
+    string_offsets = {}
+
+    def add_string(value):
+        encoded = value.encode('utf-8')
+        if encoded not in string_offsets:
+            string_offsets[encoded] = len(strings)
+            strings.extend(encoded)
+        return string_offsets[encoded], len(encoded)
+
+    port_table = bytearray()
+    entry_table = bytearray()
+    entry_count = 0
+    for port_name in sorted(ports, key=lambda name: name.encode('utf-8')):
+        (mtime_ns, size), versions = ports[port_name]
+        name_offset, name_length = add_string(port_name)
+        port_table.extend(PORT.pack(name_offset, name_length, entry_count, len(versions), mtime_ns, size))
+        for version in versions:
+            scheme, version_string = get_version_scheme(version)
+            version_offset, version_length = add_string(version_string)
+            entry_table.extend(ENTRY.pack(bytes.fromhex(version['git-tree']), version_offset, version_length,
+                                          scheme, version.get('port-version', 0)))
+        entry_count += len(versions)
+
+    ports_offset = HEADER.size
+    entries_offset = ports_offset + len(port_table)
+    strings_offset = entries_offset + len(entry_table)
+    temp_path = f'{path}.{os.getpid()}.tmp'
+    with open(temp_path, 'wb') as index_file:
+        index_file.write(HEADER.pack(MAGIC, FORMAT, len(ports), entry_count,
+                                     ports_offset, entries_offset, strings_offset))
+        index_file.write(port_table)
+        index_file.write(entry_table)
+        index_file.write(strings)
+    os.replace(temp_path, path)
+
+
+def benchmark(index_path, port_name, version, iterations):
+    with VersionsIndex(index_path) as index:
+        start_time = time.perf_counter()
+        for _ in range(iterations):
+            git_tree = index.find_git_tree(port_name, version)
+        index_time = (time.perf_counter() - start_time) / iterations
+
+    start_time = time.perf_counter()
+    for _ in range(iterations):
+        with open(get_versions_file_path(port_name), 'r') as versions_file:
+            versions = json.load(versions_file)['versions']
+        json_git_tree = next((entry['git-tree'] for entry in versions
+                              if get_version_scheme(entry)[1] == version), None)
+    json_time = (time.perf_counter() - start_time) / iterations
+
+    if git_tree != json_git_tree:
+        print(f'Error: the index returned {git_tree}, the versions file {json_git_tree}', file=sys.stderr)
+    print(f'Index lookup:       {index_time * 1e6:10.1f} us')
+    print(f'Versions file load: {json_time * 1e6:10.1f} us')
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Looks up port versions in versions.idx, written by generateBaseline.py.')
+    parser.add_argument('port', help='name of the port')
+    parser.add_argument('version', nargs='?', help='print the git-tree of this version')
+    parser.add_argument('--port-version', type=int, help='port-version of the version, by default the highest')
+    parser.add_argument('--index', default=INDEX_PATH, help='path of the index')
+    parser.add_argument('--benchmark', type=int, metavar='N',
+                        help='compare N index lookups with loading the versions file')
+    args = parser.parse_args()
+
+    if not os.path.exists(args.index):
+        print(f'{args.index} does not exist.\nRun: `python generateBaseline.py`', file=sys.stderr)
+        sys.exit(1)
+
+    if args.benchmark:
+        if args.version is None:
+            parser.error('--benchmark requires a version')
+        benchmark(args.index, args.port, args.version, args.benchmark)
+        return
+
+    with VersionsIndex(args.index) as index:
+        if args.version is None:
+            versions = index.versions(args.port)
+            if versions is None:
+                print(f'Error: No versions of {args.port}', file=sys.stderr)
+                sys.exit(1)
+            for entry in versions:
+                _, version = get_version_scheme(entry)
+                print(f'{entry["git-tree"]} {version}#{entry["port-version"]}')
+        else:
+            git_tree = index.find_git_tree(args.port, args.version, args.port_version)
+            if git_tree is None:
+                print(f'Error: No version {args.version} of {args.port}', file=sys.stderr)
+                sys.exit(1)
+            print(git_tree)
+
+
+if __name__ == "__main__":
+    main()